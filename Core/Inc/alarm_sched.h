@@ -0,0 +1,68 @@
+/*
+ * alarm_sched.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Alarm scheduler multiplexed onto a single hardware alarm.
+ *
+ *  Holds up to SCHED_MAX_ALARMS alarms, each with a time of day and a
+ *  weekday mask (no days set makes it a one-shot that disables itself
+ *  after ringing). Enabled alarms sit in a min-heap keyed by their next
+ *  due time, and only the root is handed to the hardware through
+ *  Sched_Rtc_t, so a fire or an edit costs O(log N) and nothing has to
+ *  poll. A pending snooze rides in the same heap under its own id.
+ *  Times are seconds since 2000-01-01 00:00, see calendar.h.
+ */
+
+#ifndef INC_ALARM_SCHED_H_
+#define INC_ALARM_SCHED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SCHED_MAX_ALARMS        4
+#define SCHED_SNOOZE            SCHED_MAX_ALARMS   // id Sched_Fire returns for a snooze
+
+// Sched_Alarm_t.days, bit n is RTC weekday n + 1
+#define SCHED_MON               0x01
+#define SCHED_TUE               0x02
+#define SCHED_WED               0x04
+#define SCHED_THU               0x08
+#define SCHED_FRI               0x10
+#define SCHED_SAT               0x20
+#define SCHED_SUN               0x40
+#define SCHED_WEEKDAYS          0x1F
+#define SCHED_WEEKEND           0x60
+#define SCHED_DAILY             0x7F
+
+// Sched_Alarm_t.flags
+#define SCHED_ENABLED           0x01
+#define SCHED_SKIP_NEXT         0x02   // swallow the next occurrence only
+
+typedef struct {
+	uint8_t hours;
+	uint8_t minutes;
+	uint8_t seconds;
+	uint8_t days;          // weekday mask, 0 for a one-shot
+	uint8_t flags;
+} Sched_Alarm_t;
+
+typedef struct {
+	int (*program)(uint32_t due);  // arm the hardware alarm, 0 on success
+	void (*cancel)(void);          // nothing is due
+} Sched_Rtc_t;
+
+void Sched_Init(const Sched_Rtc_t* rtc);
+void Sched_Load(const Sched_Alarm_t* alarms, uint8_t count, uint32_t now);
+bool Sched_Set(uint8_t id, const Sched_Alarm_t* alarm, uint32_t now);
+const Sched_Alarm_t* Sched_Get(uint8_t id);
+void Sched_Resync(uint32_t now);
+int Sched_Fire(uint32_t now);
+int Sched_Next(uint32_t* due);
+void Sched_Snooze(uint32_t due);
+void Sched_CancelSnooze(void);
+void Sched_Arm(void);
+bool Sched_Armed(void);
+
+#endif /* INC_ALARM_SCHED_H_ */
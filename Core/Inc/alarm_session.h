@@ -0,0 +1,44 @@
+/*
+ * alarm_session.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  State of a ringing alarm: blink phase, snooze and auto-stop.
+ *
+ *  The session is clocked by Session_Tick, which the app calls from a
+ *  periodic hardware event every SESSION_BLINK_MS, so the blink rate and
+ *  the timeout do not depend on how fast the main loop runs and the CPU
+ *  can sleep between phases. Snoozing only changes state here; arming
+ *  the wake-up for the end of the snooze is left to the caller.
+ */
+
+#ifndef INC_ALARM_SESSION_H_
+#define INC_ALARM_SESSION_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SESSION_BLINK_MS        500
+#define SESSION_TIMEOUT_S       300    // ringing stops by itself after this
+#define SESSION_SNOOZE_S        540
+#define SESSION_MAX_SNOOZES     6      // then a snooze request is refused
+
+typedef enum {
+	SESSION_IDLE,
+	SESSION_RINGING,
+	SESSION_SNOOZED
+} Session_State_t;
+
+void Session_Start(void);
+void Session_Resume(void);
+bool Session_Snooze(void);
+void Session_Stop(void);
+void Session_Tick(void);
+Session_State_t Session_State(void);
+bool Session_BlinkOn(void);
+bool Session_TakeRedraw(void);
+bool Session_TimedOut(void);
+uint8_t Session_Snoozes(void);
+
+#endif /* INC_ALARM_SESSION_H_ */
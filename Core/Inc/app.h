@@ -1,25 +1,36 @@
-/*
- * app.h
- *
- *  Created on: Jun 19, 2022
- *      Author: xl0021
- */
-
-#ifndef SRC_APP_H_
-#define SRC_APP_H_
-
-#include "stm32l4xx_hal.h"
-
-extern volatile int button;
-extern volatile int buttonCounter;
-extern volatile int menuSelect;
-extern volatile int elementSelect;
-extern volatile int editElement;
-extern volatile int flagA;
-
-
-void App_Init(void);
-void App_MainLoop(void);
-
-
-#endif /* SRC_APP_H_ */
+/*
+ * app.h
+ *
+ *  Created on: Jun 19, 2022
+ *      Author: xl0021
+ */
+
+#ifndef SRC_APP_H_
+#define SRC_APP_H_
+
+#include "stm32l4xx_hal.h"
+
+extern volatile int button;
+extern volatile int buttonCounter;
+extern volatile int menuSelect;
+extern volatile int elementSelect;
+extern volatile int editElement;
+extern volatile int flagA;
+extern volatile int rtcWarmBoot;
+
+// RTC backup register map
+#define BKP_RTC_MAGIC_REG   RTC_BKP_DR0
+#define BKP_RTC_MAGIC       0x32F2  // calendar has been set and is running
+#define BKP_DRIFT_ANCHOR_REG    RTC_BKP_DR1
+#define BKP_DRIFT_ELAPSED_REG   RTC_BKP_DR2
+#define BKP_DRIFT_ERROR_REG     RTC_BKP_DR3
+#define BKP_DRIFT_PPB_REG       RTC_BKP_DR4
+
+
+void App_Init(void);
+void App_MainLoop(void);
+int App_AlarmDue(void);
+void App_MinuteTick(void);
+
+
+#endif /* SRC_APP_H_ */
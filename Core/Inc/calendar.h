@@ -0,0 +1,45 @@
+/*
+ * calendar.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Calendar arithmetic for the RTC's range, 2000-01-01 to 2099-12-31.
+ *
+ *  Years are 0-99 as the RTC keeps them, months 1-12, weekdays 1-7 from
+ *  Monday like RTC_WEEKDAY_x. Inside this range every fourth year is a
+ *  leap year, which keeps all of the conversions table driven and free
+ *  of loops. Time stamps are seconds since 2000-01-01 00:00.
+ */
+
+#ifndef INC_CALENDAR_H_
+#define INC_CALENDAR_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CAL_SECONDS_PER_DAY     86400u
+#define CAL_DAYS_MAX            36525u   // days in 2000-2099
+
+typedef struct {
+	uint8_t year;
+	uint8_t month;
+	uint8_t date;
+	uint8_t weekday;
+	uint8_t hours;
+	uint8_t minutes;
+	uint8_t seconds;
+} Cal_DateTime_t;
+
+bool Cal_IsLeap(uint8_t year);
+uint8_t Cal_DaysInMonth(uint8_t year, uint8_t month);
+bool Cal_Valid(const Cal_DateTime_t* dt);
+uint8_t Cal_ClampDate(uint8_t year, uint8_t month, uint8_t date);
+uint16_t Cal_Days(uint8_t year, uint8_t month, uint8_t date);
+void Cal_FromDays(uint16_t days, Cal_DateTime_t* dt);
+uint8_t Cal_Weekday(uint8_t year, uint8_t month, uint8_t date);
+uint8_t Cal_WeekdayOf(uint32_t time);
+uint32_t Cal_ToSeconds(const Cal_DateTime_t* dt);
+void Cal_FromSeconds(uint32_t time, Cal_DateTime_t* dt);
+
+#endif /* INC_CALENDAR_H_ */
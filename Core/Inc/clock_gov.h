@@ -0,0 +1,57 @@
+/*
+ * clock_gov.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  System clock governor with two operating points.
+ *
+ *  CLOCK_FULL is the CubeMX configuration: 80 MHz from HSI16 through the
+ *  PLL, voltage range 1, four wait states. CLOCK_LOW is MSI at 4 MHz,
+ *  trimmed by the LSE, in voltage range 2 with no wait states and the
+ *  PLL and HSI16 off. The app asks for full speed around screen updates
+ *  and radio seeks and drops to low while it waits for input.
+ *
+ *  Everything clocked from PCLK1 is re-derived on each switch: the I2C1
+ *  and I2C2 TIMINGR (through the bus speed manager, once both buses are
+ *  idle), the TIM3 prescaler (keeping the inactivity count already run
+ *  down), the USART2 baud rate and, through HAL_RCC_ClockConfig,
+ *  SysTick. The UART logger is held for the switch,
+ *  so a switch can wait for up to one DMA chunk to go out, and the ITM
+ *  trace re-times its stamps and SWO prescaler around it. Time at each
+ *  point is accumulated from a caller supplied millisecond clock so that
+ *  it keeps counting through Stop 2, where the core clock and SysTick are
+ *  off.
+ */
+
+#ifndef INC_CLOCK_GOV_H_
+#define INC_CLOCK_GOV_H_
+
+#include "stm32l4xx_hal.h"
+
+#define CLOCK_FULL_HZ           80000000u
+#define CLOCK_LOW_HZ            4000000u
+#define CLOCK_TIM3_PSC_FULL     18310u      // CubeMX value at 80 MHz
+
+typedef enum {
+	CLOCK_LOW,
+	CLOCK_FULL,
+	CLOCK_POINTS
+} Clock_Point_t;
+
+typedef struct {
+	uint32_t ms[CLOCK_POINTS];       // time spent at each point
+	uint32_t switches[CLOCK_POINTS]; // switches into each point
+	uint32_t switchUs;               // duration of the last switch
+	uint32_t switchMaxUs;
+} Clock_Stats_t;
+
+void Clock_Init(uint32_t (*nowMs)(void));
+HAL_StatusTypeDef Clock_Set(Clock_Point_t point);
+Clock_Point_t Clock_Get(void);
+void Clock_PrepareStop(void);
+uint32_t Clock_Resume(void);
+const Clock_Stats_t* Clock_GetStats(void);
+void Clock_ResetStats(void);
+
+#endif /* INC_CLOCK_GOV_H_ */
@@ -0,0 +1,53 @@
+/*
+ * console.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Line console with a table of commands.
+ *
+ *  Console_Feed takes one received byte at a time and does a constant
+ *  amount of work for it: the byte is echoed, stored and split into
+ *  arguments as it arrives, so a finished line only has to be looked up
+ *  and run. Backspace edits the line, Ctrl-C drops it, and a line longer
+ *  than CONSOLE_LINE_MAX or with more than CONSOLE_ARGS_MAX words is
+ *  refused whole when it ends, unless it was edited back within them
+ *  first; the bytes past the end are dropped without an echo. Every command answers with its output and
+ *  then "ok" or "err ...", followed by the "> " prompt.
+ *
+ *  The console has no hardware dependencies; output goes through the
+ *  write callback given to Console_Init, so it can run on the host fed
+ *  from a byte stream. console_uart.h connects it to USART2.
+ */
+
+#ifndef INC_CONSOLE_H_
+#define INC_CONSOLE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define CONSOLE_LINE_MAX        64
+#define CONSOLE_ARGS_MAX        8
+
+typedef enum {
+	CONSOLE_OK = 0,
+	CONSOLE_ERR_USAGE = -1,         // prints the command's usage
+	CONSOLE_ERR_ARG = -2,           // an argument is out of range
+	CONSOLE_ERR_BUSY = -3,
+	CONSOLE_ERR = -4
+} Console_Result_t;
+
+typedef struct {
+	const char* name;
+	const char* usage;              // arguments, for help and usage errors
+	Console_Result_t (*run)(uint8_t argc, char* argv[]);   // argv[0] is the name
+} Console_Command_t;
+
+void Console_Init(const Console_Command_t* commands, uint8_t count, void (*write)(const char* text, uint16_t len));
+bool Console_Feed(char c);
+void Console_Print(const char* text);
+bool Console_ParseU(const char* text, uint32_t* value);
+bool Console_ParseFixed(const char* text, uint8_t decimals, uint32_t* value);
+uint8_t Console_ParseFields(const char* text, char sep, uint32_t* fields, uint8_t max);
+
+#endif /* INC_CONSOLE_H_ */
@@ -0,0 +1,34 @@
+/*
+ * console_uart.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  USART2 receive path for the console.
+ *
+ *  DMA1 channel 6 writes received bytes into a circular buffer with no
+ *  per-byte interrupt. Console_UartTask, called from the main loop,
+ *  hands whatever arrived since the last call to Console_Feed; replies go
+ *  out through the UART logger. Reception stops in Stop 2, so the RX pin
+ *  also wakes the clock face through EXTI3 and Console_UartActive keeps
+ *  it out of Stop 2 for CONSOLE_AWAKE_MS after the last byte. The byte
+ *  that woke it is usually lost; a terminal user presses Enter first.
+ */
+
+#ifndef INC_CONSOLE_UART_H_
+#define INC_CONSOLE_UART_H_
+
+#include <stdbool.h>
+#include "stm32l4xx_hal.h"
+#include "console.h"
+
+#define CONSOLE_RX_SIZE         64      // bytes between two Console_UartTask calls
+#define CONSOLE_AWAKE_MS        30000
+
+void Console_UartInit(const Console_Command_t* commands, uint8_t count);
+void Console_UartTask(void);
+bool Console_UartActive(void);
+void Console_UartWake(void);
+void Console_UartDmaIRQHandler(void);
+
+#endif /* INC_CONSOLE_UART_H_ */
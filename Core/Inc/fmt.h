@@ -0,0 +1,34 @@
+/*
+ * fmt.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Small integer formatting helpers used to build the UI strings without
+ *  pulling newlib's printf machinery into the image.
+ *
+ *  Every function writes into the caller's buffer, NUL-terminates it and
+ *  returns a pointer to the terminating NUL so calls can be chained:
+ *
+ *      char *p = Fmt_Str(buf, "Time: ");
+ *      Fmt_Time(p, h, m, s);
+ */
+
+#ifndef INC_FMT_H_
+#define INC_FMT_H_
+
+#include <stdint.h>
+
+char* Fmt_Str(char* dst, const char* src);
+char* Fmt_Char(char* dst, char c);
+char* Fmt_U2(char* dst, uint8_t value);
+char* Fmt_UDec(char* dst, uint32_t value);
+char* Fmt_IDec(char* dst, int32_t value);
+char* Fmt_UPad(char* dst, uint32_t value, uint8_t width);
+char* Fmt_Fixed(char* dst, int32_t value, uint8_t decimals);
+char* Fmt_Time(char* dst, uint8_t hours, uint8_t minutes, uint8_t seconds);
+char* Fmt_HourMin(char* dst, uint8_t hours, uint8_t minutes);
+char* Fmt_Date(char* dst, uint8_t month, uint8_t date, uint16_t year);
+char* Fmt_Ordinal(char* dst, uint8_t number);
+
+#endif /* INC_FMT_H_ */
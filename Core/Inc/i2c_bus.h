@@ -0,0 +1,148 @@
+/*
+ * i2c_bus.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  I2C job queues for the OLED (I2C1) and radio (I2C2), bounded latency.
+ *
+ *  Each bus runs one job at a time from its own queue, in the background:
+ *  interrupt driven on I2C2, DMA driven on I2C1 where the frame data goes.
+ *  A job that finishes starts the next one from the interrupt, so a queue
+ *  drains without gaps and the two buses run at the same time; a radio
+ *  status read overlaps an OLED flush. BUS_PRIO_UI jobs go ahead of
+ *  BUS_PRIO_BACKGROUND ones, first in first out within a priority. The
+ *  job's done callback runs later from Bus_Task in thread context. The
+ *  blocking calls, Bus_Transmit and friends, queue a UI job and wait for it.
+ *
+ *  Each attempt gets a deadline sized for its length at BUS_SLOW_KHZ, the
+ *  slowest rate a bus ever falls back to. A failed attempt is tried
+ *  again up to BUS_RETRIES times after a backoff that starts at
+ *  BUS_BACKOFF_MS and doubles. A timeout, bus error or lost arbitration
+ *  first recovers the bus: the pins are taken over as GPIO, SCL is clocked
+ *  up to nine times until the slave lets go of SDA, a STOP is sent and the
+ *  peripheral is initialised again. A NACK leaves the bus idle and is only
+ *  retried.
+ *
+ *  After BUS_FAIL_LIMIT failed jobs in a row the bus counts as down and
+ *  jobs fail at once for BUS_HOLDOFF_MS, so an absent radio costs one slow
+ *  job per holdoff rather than one per call. Once started, no job takes
+ *  longer than Bus_WorstCaseMs for its length, provided Bus_Task runs; a
+ *  UI job can also wait behind the one job already on the bus. Bus_GetStats
+ *  gives the error counters and the measured latency to hold that against.
+ *  The console "i2cbench" command times frames with and without the
+ *  overlap; Tests/test_i2c_bus.c runs this code against a model of the
+ *  two buses on the host.
+ *
+ *  Each bus has a speed ceiling. TIMINGR is computed by i2c_speed for the
+ *  fastest standard rate up to the ceiling that PCLK1 allows, and is
+ *  computed again whenever the clock governor changes PCLK1. Rates above
+ *  400 kHz also turn on the Fast-mode Plus pin drive. Bus_SetSpeed probes
+ *  the device and steps the ceiling down until it answers. A timeout or
+ *  bus error at run time lowers the ceiling one step before the retry.
+ *
+ *  Submit, wait and Bus_Task from thread context only, and do not wait on
+ *  a bus from a done callback. The job and its data must stay put until
+ *  the job is done.
+ */
+
+#ifndef INC_I2C_BUS_H_
+#define INC_I2C_BUS_H_
+
+#include <stdbool.h>
+#include "stm32l4xx_hal.h"
+
+#define BUS_SLOW_KHZ            100     // deadlines hold down to this SCL rate
+#define BUS_RETRIES             2
+#define BUS_BACKOFF_MS          1       // before the first retry, doubled for each next one
+#define BUS_FAIL_LIMIT          3       // failed jobs in a row before the bus counts as down
+#define BUS_HOLDOFF_MS          1000
+
+typedef enum {
+	BUS_OLED,
+	BUS_RADIO,
+	BUS_COUNT
+} Bus_Id_t;
+
+typedef enum {
+	BUS_PRIO_UI,
+	BUS_PRIO_BACKGROUND,
+	BUS_PRIOS
+} Bus_Prio_t;
+
+typedef enum {
+	BUS_OP_TX,
+	BUS_OP_RX,
+	BUS_OP_MEM                      // register byte, then data, in one write
+} Bus_Op_t;
+
+typedef enum {
+	BUS_JOB_IDLE,
+	BUS_JOB_QUEUED,
+	BUS_JOB_ACTIVE,
+	BUS_JOB_FINISHED,               // waiting for Bus_Task to run the callback
+	BUS_JOB_DONE
+} Bus_JobState_t;
+
+typedef struct Bus_Job Bus_Job_t;
+typedef void (*Bus_Done_t)(Bus_Job_t* job);
+
+struct Bus_Job {
+	Bus_Op_t op;
+	uint16_t addr;
+	uint8_t reg;                    // BUS_OP_MEM only
+	uint8_t* data;
+	uint16_t len;
+	Bus_Done_t done;                // may be NULL
+	void* ctx;
+	// Kept by the queue
+	volatile Bus_JobState_t state;
+	volatile HAL_StatusTypeDef status;
+	uint8_t attempts;
+	Bus_Job_t* next;
+};
+
+typedef struct {
+	uint32_t transfers;             // jobs finished, good or not
+	uint32_t failures;              // jobs that failed after all retries
+	uint32_t skipped;               // jobs failed unsent while the bus was down
+	uint32_t nacks;
+	uint32_t timeouts;
+	uint32_t busErrors;             // bus errors, lost arbitration and anything else
+	uint32_t retries;
+	uint32_t recoveries;
+	uint32_t stuck;                 // recoveries that left SDA or SCL low
+	uint32_t fallbacks;             // steps down in speed
+	uint32_t bytes;                 // data bytes moved by jobs that succeeded
+	uint32_t lastUs;                // first attempt to completion
+	uint32_t maxUs;
+	uint64_t totalUs;
+	uint8_t depthMax;               // most jobs ever queued behind the active one
+} Bus_Stats_t;
+
+void Bus_Init(void);
+bool Bus_Submit(Bus_Id_t bus, Bus_Prio_t prio, Bus_Job_t* job);
+HAL_StatusTypeDef Bus_Finish(Bus_Job_t* job);
+HAL_StatusTypeDef Bus_Run(Bus_Id_t bus, Bus_Prio_t prio, Bus_Job_t* job);
+bool Bus_JobPending(const Bus_Job_t* job);
+void Bus_Task(void);
+bool Bus_Idle(Bus_Id_t bus);
+void Bus_Wait(Bus_Id_t bus);
+void Bus_WaitAll(void);
+HAL_StatusTypeDef Bus_Transmit(Bus_Id_t bus, uint16_t addr, const uint8_t* data, uint16_t len);
+HAL_StatusTypeDef Bus_Receive(Bus_Id_t bus, uint16_t addr, uint8_t* data, uint16_t len);
+HAL_StatusTypeDef Bus_MemWrite(Bus_Id_t bus, uint16_t addr, uint8_t reg, const uint8_t* data, uint16_t len);
+bool Bus_Recover(Bus_Id_t bus);
+uint32_t Bus_SetSpeed(Bus_Id_t bus, uint32_t hz, uint16_t probeAddr);
+void Bus_ClockChanged(void);
+uint32_t Bus_GetSpeed(Bus_Id_t bus);
+bool Bus_Down(Bus_Id_t bus);
+uint32_t Bus_DeadlineMs(uint16_t len);
+uint32_t Bus_WorstCaseMs(uint16_t len);
+const Bus_Stats_t* Bus_GetStats(Bus_Id_t bus);
+void Bus_ResetStats(void);
+void Bus_EvIRQHandler(Bus_Id_t bus);
+void Bus_ErIRQHandler(Bus_Id_t bus);
+void Bus_DmaIRQHandler(void);
+
+#endif /* INC_I2C_BUS_H_ */
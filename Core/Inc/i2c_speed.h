@@ -0,0 +1,44 @@
+/*
+ * i2c_speed.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  TIMINGR values for the I2C bus speeds, computed from the kernel clock.
+ *
+ *  Speed_Timing follows the rules in the reference manual's I2C timing
+ *  section. SCLL and SCLH cover the low and high time minimums of the
+ *  mode, and the spare time in the period goes to both in proportion.
+ *  SDADEL keeps data valid time within the mode's maximum, and SCLDEL
+ *  covers rise time plus data setup. It assumes the analog filter on, no
+ *  digital filter, and the board rise and fall times below.
+ *
+ *  It walks the prescaler up from 1 and takes the first value whose
+ *  fields all fit, which gives the finest SCL resolution. When no
+ *  prescaler works, the kernel clock is too slow for the mode. At 4 MHz
+ *  that rules out fast mode, because data valid time alone takes longer
+ *  than the 0.9 us allowed.
+ *
+ *  Apart from the register layout, this is plain arithmetic with no
+ *  HAL dependency.
+ */
+
+#ifndef INC_I2C_SPEED_H_
+#define INC_I2C_SPEED_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SPEED_STANDARD_HZ       100000u
+#define SPEED_FAST_HZ           400000u
+#define SPEED_FAST_PLUS_HZ      1000000u
+
+#define SPEED_RISE_NS           100     // board SCL/SDA rise and fall, as in CubeMX
+#define SPEED_FALL_NS           10
+#define SPEED_AF_MIN_NS         50      // analog filter delay range
+#define SPEED_AF_MAX_NS         260
+
+bool Speed_Timing(uint32_t clkHz, uint32_t sclHz, uint32_t* timing, uint32_t* actualHz);
+uint32_t Speed_Below(uint32_t sclHz);
+
+#endif /* INC_I2C_SPEED_H_ */
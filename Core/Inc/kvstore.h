@@ -0,0 +1,61 @@
+/*
+ * kvstore.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Log-structured key/value store over a pair of flash pages.
+ *
+ *  One page is active at a time. Records are appended to it and never
+ *  rewritten; the newest record for a key wins and a zero length record
+ *  deletes it. When the active page fills up the live records are copied
+ *  to the spare page together with the write that did not fit, and the
+ *  spare is then stamped with a higher sequence number and becomes
+ *  active. The old page is erased in the background so a write never
+ *  has to wait for a full page erase unless the store fills up again
+ *  before that erase finishes.
+ *
+ *  A RAM index of the newest record per key is built at boot, so
+ *  KV_Get is O(1). The flash itself is reached through KV_Flash_t so
+ *  the store can run against a simulated flash on the host.
+ *
+ *  Page layout, all fields little endian and 8-byte aligned:
+ *    page header  : uint32 magic, uint32 sequence
+ *    record header: uint8 key, uint8 len, uint16 crc, uint32 magic
+ *    record data  : len bytes, padded with 0xFF to a double word
+ */
+
+#ifndef INC_KVSTORE_H_
+#define INC_KVSTORE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define KV_MAX_KEYS             32
+#define KV_MAX_VALUE            128
+
+typedef enum {
+	KV_OK = 0,
+	KV_ERR = -1,            // flash error or corrupt store
+	KV_ERR_NOT_FOUND = -2,
+	KV_ERR_BUSY = -3,       // full and the spare page is still erasing, retry later
+	KV_ERR_FULL = -4,       // live data does not fit in one page
+	KV_ERR_PARAM = -5
+} KV_Error_t;
+
+typedef struct {
+	const uint8_t* page[2];                 // memory mapped pages
+	uint32_t pageSize;
+	int (*program)(uint8_t page, uint32_t offset, uint64_t data); // one double word, 0 on success
+	int (*eraseStart)(uint8_t page);        // starts an erase, 0 on success
+	bool (*eraseBusy)(void);
+} KV_Flash_t;
+
+KV_Error_t KV_Init(const KV_Flash_t* flash);
+int KV_Get(uint8_t key, void* value, uint8_t maxLen);
+KV_Error_t KV_Set(uint8_t key, const void* value, uint8_t len);
+KV_Error_t KV_Delete(uint8_t key);
+void KV_Task(void);
+uint32_t KV_FreeBytes(void);
+
+#endif /* INC_KVSTORE_H_ */
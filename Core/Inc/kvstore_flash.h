@@ -0,0 +1,26 @@
+/*
+ * kvstore_flash.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  STM32L476 flash backend for the key/value store. Uses the last two
+ *  2 KB pages of bank 2, which the linker script keeps out of the image.
+ *  Code runs from bank 1, so erasing these pages runs in the background
+ *  without stalling instruction fetch.
+ */
+
+#ifndef INC_KVSTORE_FLASH_H_
+#define INC_KVSTORE_FLASH_H_
+
+#include "kvstore.h"
+
+#define KV_FLASH_BASE           0x080FF000u // pages 254 and 255 of bank 2
+#define KV_FLASH_FIRST_PAGE     254u
+
+extern const KV_Flash_t KV_Stm32Flash;
+
+void KV_FlashInit(void);
+void KV_FlashIRQHandler(void);
+
+#endif /* INC_KVSTORE_FLASH_H_ */
@@ -0,0 +1,88 @@
+/*
+ * prof.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Cycle counter profiler for hot paths.
+ *
+ *  PROF_BEGIN and PROF_END bracket a site in the same block; the time in
+ *  between is added to that site's count, min, max, sum and a log2
+ *  histogram in RAM. On the target the time comes from the DWT cycle
+ *  counter and is converted to nanoseconds at the current SystemCoreClock,
+ *  so sites stay comparable across clock governor switches. On the host
+ *  Prof_Now reads CLOCK_MONOTONIC in nanoseconds. A site can be nested in
+ *  another, but must not span a switch of operating point.
+ *
+ *  PROF_ENABLE defaults to on in Debug builds. With it off the markers
+ *  expand to nothing and no tables are linked.
+ */
+
+#ifndef INC_PROF_H_
+#define INC_PROF_H_
+
+#include <stdint.h>
+
+#ifndef PROF_ENABLE
+#ifdef DEBUG
+#define PROF_ENABLE             1
+#else
+#define PROF_ENABLE             0
+#endif
+#endif
+
+#define PROF_BUCKETS            32  // hist[b] counts durations of 2^b to 2^(b+1)-1 ns
+
+typedef enum {
+	PROF_OLED_UPDATE,
+	PROF_OLED_STRING,
+	PROF_OLED_FILL,
+	PROF_OLED_I2C,
+	PROF_RADIO_I2C,
+	PROF_MENU_TIME,
+	PROF_MENU_FM,
+	PROF_MENU_ALARM,
+	PROF_MENU_RING,
+	PROF_MENU_FACE,
+	PROF_SITES
+} Prof_Site_t;
+
+typedef struct {
+	uint32_t count;
+	uint32_t minNs;
+	uint32_t maxNs;
+	uint64_t sumNs;
+	uint32_t hist[PROF_BUCKETS];
+} Prof_Stats_t;
+
+#if PROF_ENABLE
+
+#if defined(__arm__)
+#include "stm32l4xx.h"
+static inline uint32_t Prof_Now(void) {
+	return DWT->CYCCNT;
+}
+#else
+uint32_t Prof_Now(void);
+#endif
+
+#define PROF_BEGIN(site)        uint32_t prof_##site = Prof_Now()
+#define PROF_END(site)          Prof_Record((site), Prof_Now() - prof_##site)
+
+void Prof_Init(void);
+void Prof_Record(Prof_Site_t site, uint32_t ticks);
+const Prof_Stats_t* Prof_Get(Prof_Site_t site);
+void Prof_Reset(void);
+void Prof_Dump(void (*write)(const char* text, uint16_t len));
+
+#else
+
+#define PROF_BEGIN(site)        ((void)0)
+#define PROF_END(site)          ((void)0)
+#define Prof_Init()             ((void)0)
+#define Prof_Reset()            ((void)0)
+#define Prof_Dump(write)        ((void)0)
+
+#endif /* PROF_ENABLE */
+
+#endif /* INC_PROF_H_ */
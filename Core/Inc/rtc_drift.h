@@ -0,0 +1,42 @@
+/*
+ * rtc_drift.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  RTC drift estimation from the user's own clock corrections.
+ *
+ *  Every time the user sets the clock, the correction they made is
+ *  recorded against the RTC time that passed since the previous set.
+ *  Once enough time and error have built up, the ratio of the two gives
+ *  the residual drift, which is folded into the calibration and handed
+ *  out as smooth calibration register values. Corrections too large to
+ *  be drift (a new date, travel, a first set) only move the anchor.
+ *  The state is plain data so the app can keep it in backup registers.
+ */
+
+#ifndef INC_RTC_DRIFT_H_
+#define INC_RTC_DRIFT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define DRIFT_MIN_SPAN_S        (3u * 86400u)  // RTC time needed before an estimate
+#define DRIFT_MIN_ERROR_MS      2000           // and at least this much correction
+#define DRIFT_MAX_STEP_MS       120000         // larger corrections are not drift
+#define DRIFT_MAX_PPM           500
+#define DRIFT_PPB_MAX           488500         // CALP adds 512 pulses in 2^20
+#define DRIFT_PPB_MIN           (-487100)      // CALM removes up to 511
+
+typedef struct {
+	uint32_t anchor;       // true time at the last set, 0 before the first
+	uint32_t elapsed;      // RTC seconds gathered since the calibration last changed
+	int32_t error;         // milliseconds the user added over that time
+	int32_t ppb;           // calibration in force, positive speeds the clock up
+} Drift_State_t;
+
+void Drift_Reset(Drift_State_t* state);
+bool Drift_Record(Drift_State_t* state, uint32_t rtcTime, int64_t correctionMs);
+void Drift_Calr(int32_t ppb, bool* plusPulses, uint16_t* minusPulses);
+
+#endif /* INC_RTC_DRIFT_H_ */
@@ -0,0 +1,35 @@
+/*
+ * rtc_time.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Millisecond time stamps from the RTC calendar and sub-second counter.
+ *
+ *  The RTC sub-second register counts down from PREDIV_S to 0 once per
+ *  second, so the fraction already elapsed is (PREDIV_S - SSR) over
+ *  PREDIV_S + 1. Right after a shift operation SSR can read above
+ *  PREDIV_S, which means the calendar has not yet rolled back to the
+ *  second the counter is in; the stamp is borrowed from the previous
+ *  second in that case. Given a stamp, the helpers say how long it is
+ *  until the next second or minute boundary so a caller can sleep until
+ *  the displayed digits actually change.
+ */
+
+#ifndef INC_RTC_TIME_H_
+#define INC_RTC_TIME_H_
+
+#include <stdint.h>
+
+typedef struct {
+	uint32_t seconds;   // since 2000-01-01, see Cal_ToSeconds
+	uint16_t ms;        // 0-999 within the second
+} RtcTime_t;
+
+void RtcTime_Make(RtcTime_t* t, uint32_t seconds, uint32_t subSeconds, uint32_t secondFraction);
+int32_t RtcTime_DiffMs(const RtcTime_t* a, const RtcTime_t* b);
+uint32_t RtcTime_UntilBoundary(const RtcTime_t* now, uint32_t periodS);
+uint32_t RtcTime_UntilSecond(const RtcTime_t* now);
+uint32_t RtcTime_UntilMinute(const RtcTime_t* now);
+
+#endif /* INC_RTC_TIME_H_ */
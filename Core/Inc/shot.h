@@ -0,0 +1,45 @@
+/*
+ * shot.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Framebuffer screenshots, run-length coded.
+ *
+ *  A frame is a header, the coded image and a CRC:
+ *    header : "SHOT", uint8 flags, uint8 width, uint8 height, uint8 seq
+ *    payload: packets until width * height / 8 bytes are rebuilt
+ *    trailer: uint16 CRC-16/CCITT-FALSE over header and payload, LE
+ *  A packet is a control byte c: below 0x80, c + 1 literal bytes follow;
+ *  from 0x80, the one byte that follows repeats (c & 0x7F) + 3 times.
+ *
+ *  With SHOT_DELTA set the coded bytes are the image XORed with the
+ *  previous frame, so an unchanged screen is a handful of zero runs. A
+ *  delta only applies to the frame numbered seq - 1; a receiver that
+ *  missed it asks for a full frame. The image is the SSD1306 buffer as
+ *  is: page-major, one byte per 8-pixel column, LSB at the top.
+ *
+ *  Output goes through a write callback in pieces of at most one packet,
+ *  so no frame buffer is needed. tools/shot_decode.py turns captured
+ *  frames into PBM or PNG files.
+ */
+
+#ifndef INC_SHOT_H_
+#define INC_SHOT_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define SHOT_DELTA              0x01    // flags: payload is XORed with the previous frame
+#define SHOT_HEADER_SIZE        8
+#define SHOT_LITERAL_MAX        128
+#define SHOT_RUN_MIN            3
+#define SHOT_RUN_MAX            130
+
+typedef void (*Shot_Write_t)(const uint8_t* data, uint16_t len);
+
+uint32_t Shot_Send(const uint8_t* image, uint8_t* previous, uint8_t width, uint8_t height,
+		uint8_t seq, bool delta, Shot_Write_t write);
+int Shot_Decode(const uint8_t* frame, uint32_t len, uint8_t* image, uint16_t size);
+
+#endif /* INC_SHOT_H_ */
@@ -61,10 +61,6 @@ _BEGIN_STD_C
 
 /* vvv I2C config vvv */
 
-#ifndef SSD1306_I2C_PORT
-#define SSD1306_I2C_PORT        hi2c1
-#endif
-
 #ifndef SSD1306_I2C_ADDR
 #define SSD1306_I2C_ADDR        (0x3C << 1)
 #endif
@@ -73,8 +69,14 @@ _BEGIN_STD_C
 
 /* vvv SPI config vvv */
 
-#ifndef SSD1306_SPI_PORT
-#define SSD1306_SPI_PORT        hspi2
+// SPI2 on PB13 (SCK) and PB15 (MOSI), fed by DMA1 channel 5 with channel 4
+// reading back. CS must be SPI2's NSS pin, PB12 or PB9, which the SPI drives.
+// The SSD1306 clock cycle is 100 ns at least.
+#ifndef SSD1306_SPI_MAX_HZ
+#define SSD1306_SPI_MAX_HZ      10000000
+#endif
+#ifndef SSD1306_SPI_TIMEOUT_MS
+#define SSD1306_SPI_TIMEOUT_MS  10
 #endif
 
 #ifndef SSD1306_CS_Port
@@ -100,11 +102,7 @@ _BEGIN_STD_C
 
 /* ^^^ SPI config ^^^ */
 
-#if defined(SSD1306_USE_I2C)
-extern I2C_HandleTypeDef SSD1306_I2C_PORT;
-#elif defined(SSD1306_USE_SPI)
-extern SPI_HandleTypeDef SSD1306_SPI_PORT;
-#else
+#if !defined(SSD1306_USE_I2C) && !defined(SSD1306_USE_SPI)
 #error "You should define SSD1306_USE_SPI or SSD1306_USE_I2C macro!"
 #endif
 
@@ -154,10 +152,28 @@ typedef struct {
     const uint8_t *const char_width;    /**< Proportional character width in pixels (NULL for monospaced) */
 } SSD1306_Font_t;
 
+/**
+ * Bus the panel is driven over. SSD1306_USE_I2C or SSD1306_USE_SPI only
+ * picks the one used until ssd1306_SetTransport is called; both are built.
+ */
+typedef struct {
+    void (*Init)(void);                                     /**< Bring up the bus and pins, or NULL */
+    void (*Reset)(void);                                    /**< Pulse the reset line, if the panel has one */
+    void (*WriteCommands)(const uint8_t* cmds, size_t len); /**< Bytes for the command register */
+    void (*WriteData)(const uint8_t* data, size_t len);     /**< Bytes for display RAM */
+    void (*Flush)(const uint8_t* buffer);                   /**< The whole screenbuffer; may return once it is started */
+    uint8_t (*Busy)(void);                                  /**< Nonzero while a Flush is going out, or NULL */
+} SSD1306_Transport_t;
+
+extern const SSD1306_Transport_t ssd1306_I2C;
+extern const SSD1306_Transport_t ssd1306_SPI;
+
 // Procedure definitions
+void ssd1306_SetTransport(const SSD1306_Transport_t* transport);
 void ssd1306_Init(void);
 void ssd1306_Fill(SSD1306_COLOR color);
 void ssd1306_UpdateScreen(void);
+void ssd1306_UpdateArea(uint8_t x, uint8_t y, uint8_t w, uint8_t h);
 void ssd1306_DrawPixel(uint8_t x, uint8_t y, SSD1306_COLOR color);
 char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color);
 char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color);
@@ -210,6 +226,8 @@ void ssd1306_Reset(void);
 void ssd1306_WriteCommand(uint8_t byte);
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size);
 SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len);
+const uint8_t* ssd1306_GetBuffer(void);
+void ssd1306_SpiDmaIRQHandler(void);
 
 _END_STD_C
 
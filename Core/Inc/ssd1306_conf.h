@@ -19,16 +19,15 @@
 //#define STM32G0
 //#define STM32C0
 
-// Choose a bus
+// Choose the default bus; ssd1306_SetTransport can switch at run time
 #define SSD1306_USE_I2C
 //#define SSD1306_USE_SPI
 
 // I2C Configuration
-#define SSD1306_I2C_PORT        hi2c1
 #define SSD1306_I2C_ADDR        (0x3C << 1)
 
 // SPI Configuration
-//#define SSD1306_SPI_PORT        hspi1
+//#define SSD1306_SPI_MAX_HZ      10000000
 //#define SSD1306_CS_Port         OLED_CS_GPIO_Port
 //#define SSD1306_CS_Pin          OLED_CS_Pin
 //#define SSD1306_DC_Port         OLED_DC_GPIO_Port
@@ -0,0 +1,65 @@
+/*
+ * tea5767.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  TEA5767 FM receiver driver, I2C transport.
+ *
+ *  The driver keeps a shadow of the five write registers and the last
+ *  status read. Writes that would not change anything are skipped, and
+ *  partial changes only send bytes up to the last one that differs (the
+ *  TEA5767 latches bytes in order and accepts a STOP after any of them),
+ *  so a mute toggle is a single byte. TEA5767_PollStatus serves status
+ *  from the cache until it is older than the configured interval;
+ *  TEA5767_PollStatusAsync refreshes it with a read queued on the radio
+ *  bus instead of waiting, so the read overlaps the next OLED flush.
+ */
+
+#ifndef INC_TEA5767_H_
+#define INC_TEA5767_H_
+
+#include "stm32l4xx_hal.h"
+#include "tea5767_regs.h"
+
+#ifndef TEA5767_I2C_PORT
+#define TEA5767_I2C_PORT        hi2c2
+#endif
+
+#define TEA5767_I2C_ADDR        (0x60 << 1) // 7-bit address shifted for STM32 HAL
+
+#ifndef TEA5767_STATUS_INTERVAL_MS
+#define TEA5767_STATUS_INTERVAL_MS  100
+#endif
+
+typedef struct {
+	uint8_t regs[TEA5767_REG_COUNT]; // last write registers sent to the chip
+	bool regsValid;
+	uint32_t writeTick;              // HAL_GetTick of the last write
+	TEA5767_Status_t status;         // last decoded status read
+	bool statusValid;
+	uint32_t statusTick;             // HAL_GetTick of the last status read
+} TEA5767_Cache_t;
+
+typedef struct {
+	uint32_t writes;                 // write transactions issued on the bus
+	uint32_t writeBytes;
+	uint32_t writesSkipped;          // writes that matched the shadow
+	uint32_t reads;                  // read transactions issued on the bus
+	uint32_t readsCached;            // status requests served from the cache
+	uint32_t errors;
+} TEA5767_Stats_t;
+
+HAL_StatusTypeDef TEA5767_Write(const uint8_t regs[TEA5767_REG_COUNT]);
+HAL_StatusTypeDef TEA5767_Read(uint8_t regs[TEA5767_REG_COUNT]);
+HAL_StatusTypeDef TEA5767_SetFrequency(uint16_t freq, bool mute, bool searchUp, bool searchMode);
+HAL_StatusTypeDef TEA5767_SetMute(bool mute);
+HAL_StatusTypeDef TEA5767_ReadStatus(TEA5767_Status_t* status);
+HAL_StatusTypeDef TEA5767_PollStatus(TEA5767_Status_t* status);
+HAL_StatusTypeDef TEA5767_PollStatusAsync(TEA5767_Status_t* status);
+void TEA5767_SetStatusInterval(uint32_t intervalMs);
+const TEA5767_Cache_t* TEA5767_GetCache(void);
+const TEA5767_Stats_t* TEA5767_GetStats(void);
+void TEA5767_ResetStats(void);
+
+#endif /* INC_TEA5767_H_ */
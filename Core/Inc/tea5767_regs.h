@@ -0,0 +1,77 @@
+/*
+ * tea5767_regs.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  TEA5767 register layout and the pure encode/decode helpers. Nothing in
+ *  here touches the HAL, so the same code runs against a simulated
+ *  register model on the host.
+ *
+ *  Frequencies are integers in 10 kHz units (8810 = 88.10 MHz) so tuning,
+ *  read-back and seek-end detection never touch the FPU.
+ */
+
+#ifndef INC_TEA5767_REGS_H_
+#define INC_TEA5767_REGS_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TEA5767_REG_COUNT       5
+
+// Write byte 1
+#define TEA5767_MUTE            0x80
+#define TEA5767_SM              0x40 // search mode
+// Write byte 3
+#define TEA5767_SUD             0x80 // search up
+#define TEA5767_SSL_MID         0x40 // search stop level: ADC >= 7
+#define TEA5767_SSL_LOW         0x20 // search stop level: ADC >= 5
+#define TEA5767_HLSI            0x10 // high side LO injection
+#define TEA5767_MS              0x08 // force mono
+// Write byte 4
+#define TEA5767_BL              0x20 // Japanese band limits
+#define TEA5767_XTAL            0x10 // 32.768 kHz crystal
+#define TEA5767_HCC             0x04 // high cut control
+// Write byte 5
+#define TEA5767_DTC             0x40 // 75 us de-emphasis
+// Read byte 1
+#define TEA5767_RF              0x80 // ready flag
+#define TEA5767_BLF             0x40 // band limit flag
+// Read byte 3
+#define TEA5767_STEREO          0x80
+
+// Frequencies in 10 kHz units
+#define TEA5767_FREQ_MIN        8750
+#define TEA5767_FREQ_MAX        10800
+#define TEA5767_FREQ_JP_MIN     7600
+#define TEA5767_FREQ_JP_MAX     9100
+#define TEA5767_FREQ_STEP       10   // 100 kHz channel raster
+
+#define TEA5767_IF_KHZ          225
+#define TEA5767_PLL_STEP_HZ     8192 // 32.768 kHz reference / 4, high side injection
+
+/*
+ * PLL word for a frequency in 10 kHz units, rounded to the nearest step:
+ * N = 4 * (f_RF + f_IF) / f_ref. Usable in constant expressions.
+ */
+#define TEA5767_PLL(freq) \
+	((uint16_t)((((uint32_t)(freq) * 10u + TEA5767_IF_KHZ) * 1000u + TEA5767_PLL_STEP_HZ / 2) / TEA5767_PLL_STEP_HZ))
+
+typedef struct {
+	uint16_t freq;      // tuned frequency rounded to the channel raster
+	uint16_t pll;
+	uint8_t level;      // ADC signal level 0-15
+	bool ready;
+	bool bandLimit;
+	bool stereo;
+} TEA5767_Status_t;
+
+void TEA5767_SetBandJapan(bool japan);
+bool TEA5767_GetBandJapan(void);
+uint16_t TEA5767_ClampFreq(uint16_t freq);
+uint16_t TEA5767_PllToFreq(uint16_t pll);
+void TEA5767_Encode(uint8_t regs[TEA5767_REG_COUNT], uint16_t freq, bool mute, bool searchUp, bool searchMode);
+void TEA5767_Decode(const uint8_t regs[TEA5767_REG_COUNT], TEA5767_Status_t* status);
+
+#endif /* INC_TEA5767_REGS_H_ */
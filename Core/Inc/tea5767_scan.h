@@ -0,0 +1,38 @@
+/*
+ * tea5767_scan.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Full-band station sweep. Chains seeks from the bottom of the band to
+ *  the top in the background and collects every stop into a preset table
+ *  sorted by frequency. Driven by the seek events from Seek_Poll. The
+ *  table only changes when a sweep completes.
+ */
+
+#ifndef INC_TEA5767_SCAN_H_
+#define INC_TEA5767_SCAN_H_
+
+#include "tea5767_seek.h"
+
+#define SCAN_MAX_STATIONS       32
+
+typedef struct {
+	uint16_t freq;         // 10 kHz units
+	uint8_t level;
+	bool stereo;
+} Scan_Station_t;
+
+void Scan_Init(const Seek_Bus_t* bus);
+bool Scan_Start(uint16_t restoreFreq, bool restoreMute, uint32_t nowMs);
+bool Scan_Busy(void);
+bool Scan_SeekDone(const Seek_Event_t* event, uint32_t nowMs);
+void Scan_Load(const Scan_Station_t* stations, uint8_t count);
+void Scan_Clear(void);
+uint8_t Scan_Count(void);
+const Scan_Station_t* Scan_Station(uint8_t index);
+int Scan_Find(uint16_t freq);
+int Scan_Next(uint16_t freq, bool up);
+uint32_t Scan_ElapsedMs(void);
+
+#endif /* INC_TEA5767_SCAN_H_ */
@@ -0,0 +1,59 @@
+/*
+ * tea5767_seek.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Non-blocking TEA5767 seek engine. Seek_Start writes a search command,
+ *  then Seek_Poll is called from the main loop; it reads the status
+ *  registers at a fixed rate until the ready (RF) flag is set and reports
+ *  the result as a Seek_Event_t. Only the register bus is abstracted, so
+ *  the engine can be driven by a simulated TEA5767 on the host.
+ *
+ *  The poll rate is paced with HAL_GetTick from the main loop rather than
+ *  driven by a timer interrupt: the reads go through the I2C bus arbiter,
+ *  which queues behind and waits for other jobs on the bus, so they belong
+ *  in thread context. The main loop comes round at least every SysTick
+ *  while a seek or scan runs, well inside SEEK_POLL_MS, so the rate is
+ *  fixed to within a millisecond.
+ */
+
+#ifndef INC_TEA5767_SEEK_H_
+#define INC_TEA5767_SEEK_H_
+
+#include <stddef.h>
+#include "tea5767_regs.h"
+
+#define SEEK_POLL_MS            10
+#define SEEK_TIMEOUT_MS         3000
+
+typedef struct {
+	int (*write)(const uint8_t regs[TEA5767_REG_COUNT]); // 0 on success
+	int (*read)(uint8_t regs[TEA5767_REG_COUNT]);        // 0 on success
+} Seek_Bus_t;
+
+typedef enum {
+	SEEK_EVT_NONE = 0,
+	SEEK_EVT_FOUND,        // station above the search stop level
+	SEEK_EVT_BAND_LIMIT,   // reached the band edge without a station
+	SEEK_EVT_TIMEOUT,      // RF never came up
+	SEEK_EVT_ERROR         // bus error
+} Seek_EventType_t;
+
+typedef struct {
+	Seek_EventType_t type;
+	uint16_t freq;         // 10 kHz units
+	uint8_t level;
+	bool stereo;
+	uint32_t latencyMs;    // Seek_Start to RF
+} Seek_Event_t;
+
+void Seek_Init(const Seek_Bus_t* bus, uint16_t pollMs, uint32_t timeoutMs);
+bool Seek_Start(uint16_t fromFreq, bool searchUp, bool mute, uint32_t nowMs);
+bool Seek_Cancel(void);
+bool Seek_Busy(void);
+uint16_t Seek_CurrentFreq(void);
+bool Seek_Poll(uint32_t nowMs, Seek_Event_t* event);
+const Seek_Event_t* Seek_LastEvent(void);
+
+#endif /* INC_TEA5767_SEEK_H_ */
@@ -0,0 +1,85 @@
+/*
+ * trace.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  ITM event trace over SWO on PB3.
+ *
+ *  Each event goes out as two 32-bit stimulus writes: a microsecond time
+ *  stamp on TRACE_PORT_TIME, then the event on TRACE_PORT_EVENT with the
+ *  id in the top byte and a 24-bit payload below it. Both writes are made
+ *  with interrupts masked, so an event from an interrupt never splits
+ *  another one, and the decoder pairs them by port.
+ *
+ *  The time stamp is folded from the DWT cycle counter at the current
+ *  SystemCoreClock. The clock governor calls Trace_Sync before and
+ *  Trace_ClockChanged after it switches, which also rescales the SWO
+ *  prescaler so the line keeps TRACE_SWO_HZ. The cycle counter stops in
+ *  Stop 2; Trace_Wake adds the time slept as measured on the RTC.
+ *
+ *  tools/itm_decode.py reads a raw SWO capture and prints the timeline
+ *  and latency figures. TRACE_ENABLE defaults to on in Debug builds; with
+ *  it off, and on the host, the calls expand to nothing.
+ */
+
+#ifndef INC_TRACE_H_
+#define INC_TRACE_H_
+
+#include <stdint.h>
+
+#ifndef TRACE_ENABLE
+#if defined(DEBUG) && defined(__arm__)
+#define TRACE_ENABLE            1
+#else
+#define TRACE_ENABLE            0
+#endif
+#endif
+
+#define TRACE_SWO_HZ            2000000u    // divides both 80 and 4 MHz exactly
+#define TRACE_PORT_TIME         1
+#define TRACE_PORT_EVENT        2
+
+// Keep in step with EVENTS in tools/itm_decode.py
+typedef enum {
+	TRACE_ENCODER = 1,      // signed detent delta
+	TRACE_BUTTON,           // TRACE_PRESS_*
+	TRACE_MENU,             // old menu << 8 | new menu
+	TRACE_I2C_START,        // TRACE_DEV_* << 16 | bytes
+	TRACE_I2C_END,          // TRACE_DEV_* << 16 | HAL status
+	TRACE_FLUSH,            // display update sent, bytes of pixel data
+	TRACE_ALARM,            // scheduler id that rang, 0xFFFFFF if none
+	TRACE_SLEEP,            // TRACE_SLEEP_*
+	TRACE_WAKE,             // milliseconds spent in Stop 2, 0 after Sleep
+	TRACE_CLOCK             // new SystemCoreClock in kHz
+} Trace_Id_t;
+
+#define TRACE_PRESS_MENU        1   // short press stepped the menu
+#define TRACE_PRESS_EDIT        2   // short press stepped the edit field
+#define TRACE_PRESS_WAKE        3   // press woke the clock face
+
+#define TRACE_DEV_OLED          0
+#define TRACE_DEV_RADIO         1
+
+#define TRACE_SLEEP_WFI         0
+#define TRACE_SLEEP_STOP2       1
+
+#if TRACE_ENABLE
+
+void Trace_Init(void);
+void Trace_Event(Trace_Id_t id, uint32_t payload);
+void Trace_Sync(void);
+void Trace_ClockChanged(void);
+void Trace_Wake(uint32_t stopMs);
+
+#else
+
+#define Trace_Init()            ((void)0)
+#define Trace_Event(id, payload) ((void)0)
+#define Trace_Sync()            ((void)0)
+#define Trace_ClockChanged()    ((void)0)
+#define Trace_Wake(stopMs)      ((void)0)
+
+#endif /* TRACE_ENABLE */
+
+#endif /* INC_TRACE_H_ */
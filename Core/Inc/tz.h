@@ -0,0 +1,53 @@
+/*
+ * tz.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Daylight saving rules for an RTC that keeps local wall time.
+ *
+ *  Zones are given as POSIX TZ strings with M-form rules, for example
+ *  "CET-1CEST,M3.5.0,M10.5.0/3". Only a one hour DST shift is accepted
+ *  since that is what the RTC can apply in hardware. Transition dates
+ *  come straight out of the calendar in O(1), and TZ_Sync caches the
+ *  next one so the per-minute TZ_Check is a single compare. Times are
+ *  wall clock seconds since 2000-01-01, as the RTC shows them before
+ *  the change.
+ */
+
+#ifndef INC_TZ_H_
+#define INC_TZ_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TZ_SPEC_MAX             48
+
+typedef struct {
+	uint8_t month;         // 1-12
+	uint8_t week;          // 1-4, 5 for the last one in the month
+	uint8_t weekday;       // 1-7 from Monday
+	uint32_t time;         // seconds after local midnight
+} TZ_Rule_t;
+
+typedef struct {
+	int16_t offsetMin;     // standard time, minutes east of UTC
+	bool hasDst;
+	TZ_Rule_t start;       // wall time in standard time
+	TZ_Rule_t end;         // wall time in daylight time
+} TZ_Zone_t;
+
+typedef enum {
+	TZ_NONE,
+	TZ_ADD_HOUR,
+	TZ_SUB_HOUR
+} TZ_Change_t;
+
+bool TZ_Parse(const char* spec, TZ_Zone_t* zone);
+uint32_t TZ_Transition(const TZ_Zone_t* zone, uint8_t year, bool start);
+bool TZ_IsDst(const TZ_Zone_t* zone, uint32_t wall, bool dstNow);
+void TZ_Sync(const TZ_Zone_t* zone, uint32_t wall, bool dstNow);
+TZ_Change_t TZ_Check(uint32_t wall);
+uint32_t TZ_Next(void);
+
+#endif /* INC_TZ_H_ */
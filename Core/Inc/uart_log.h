@@ -0,0 +1,56 @@
+/*
+ * uart_log.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Non-blocking USART2 logger drained by TX DMA.
+ *
+ *  Text goes into a ring buffer and DMA1 channel 7 sends it out in
+ *  chunks in the background; a write only copies bytes and, when the
+ *  line is idle, starts a transfer. A write that does not fit is dropped
+ *  whole and counted rather than split or waited for; reports and dumps
+ *  that must not lose lines use Log_WriteWait instead. Log_Drain waits
+ *  for the ring to empty, which has to happen before Stop 2.
+ *
+ *  For tracing hot paths there is also a deferred mode: Log_Event queues
+ *  a format ID, the tick and three arguments, about twenty cycles of
+ *  work, and Log_Task formats queued events into text later from the
+ *  main loop. Formats come from a table the app passes to Log_Init and
+ *  understand %u, %d, %x, %c and %%.
+ *
+ *  Both rings have a single producer: call the writers from thread
+ *  context only. DMA and UART completion run in the USART2 interrupt.
+ */
+
+#ifndef INC_UART_LOG_H_
+#define INC_UART_LOG_H_
+
+#include <stdbool.h>
+#include "stm32l4xx_hal.h"
+
+#define LOG_RING_SIZE           1024    // text bytes, power of two
+#define LOG_DMA_CHUNK           64      // bytes per transfer, bounds Log_Hold
+#define LOG_EVENTS              32      // queued events, power of two
+#define LOG_LINE_MAX            96
+
+typedef struct {
+	uint32_t bytes;                 // bytes accepted into the ring
+	uint32_t dropped;               // writes dropped for lack of space
+	uint32_t eventsDropped;         // events dropped with the event queue full
+	uint16_t peak;                  // most bytes ever waiting in the ring
+} Log_Stats_t;
+
+void Log_Init(const char* const* formats, uint8_t count);
+bool Log_Write(const char* text, uint16_t len);
+bool Log_Str(const char* text);
+void Log_WriteWait(const char* text, uint16_t len);
+void Log_Drain(void);
+void Log_Event(uint8_t id, uint32_t a, uint32_t b, uint32_t c);
+void Log_Task(void);
+void Log_Hold(bool hold);
+const Log_Stats_t* Log_GetStats(void);
+void Log_DmaIRQHandler(void);
+void Log_UartIRQHandler(void);
+
+#endif /* INC_UART_LOG_H_ */
@@ -0,0 +1,242 @@
+/*
+ * alarm_sched.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "alarm_sched.h"
+#include "calendar.h"
+
+#define SCHED_NOT_QUEUED        0xFF
+
+static const Sched_Rtc_t* schedRtc;
+static Sched_Alarm_t alarms[SCHED_MAX_ALARMS];
+static uint32_t due[SCHED_MAX_ALARMS + 1];
+static uint8_t heap[SCHED_MAX_ALARMS + 1];     // alarm ids, earliest due at the root
+static uint8_t heapPos[SCHED_MAX_ALARMS + 1];  // index of each id in heap
+static uint8_t heapSize;
+static bool armed;
+
+static void SchedSwap(uint8_t a, uint8_t b) {
+	uint8_t id = heap[a];
+	heap[a] = heap[b];
+	heap[b] = id;
+	heapPos[heap[a]] = a;
+	heapPos[heap[b]] = b;
+}
+
+static void SchedSiftUp(uint8_t pos) {
+	while (pos > 0) {
+		uint8_t parent = (pos - 1) / 2;
+		if (due[heap[parent]] <= due[heap[pos]]) {
+			break;
+		}
+		SchedSwap(pos, parent);
+		pos = parent;
+	}
+}
+
+static void SchedSiftDown(uint8_t pos) {
+	for (;;) {
+		uint8_t child = 2 * pos + 1;
+		if (child >= heapSize) {
+			break;
+		}
+		if (child + 1 < heapSize && due[heap[child + 1]] < due[heap[child]]) {
+			child++;
+		}
+		if (due[heap[pos]] <= due[heap[child]]) {
+			break;
+		}
+		SchedSwap(pos, child);
+		pos = child;
+	}
+}
+
+static void SchedRemove(uint8_t id) {
+	uint8_t pos = heapPos[id];
+
+	if (pos == SCHED_NOT_QUEUED) {
+		return;
+	}
+	heapSize--;
+	if (pos != heapSize) {
+		SchedSwap(pos, heapSize);
+		SchedSiftDown(pos);
+		SchedSiftUp(pos);
+	}
+	heapPos[id] = SCHED_NOT_QUEUED;
+}
+
+// First occurrence strictly after now, false if the alarm never rings
+static bool SchedNextDue(const Sched_Alarm_t* alarm, uint32_t now, uint32_t* next) {
+	uint32_t day = now / CAL_SECONDS_PER_DAY;
+	uint32_t tod = alarm->hours * 3600u + alarm->minutes * 60u + alarm->seconds;
+	uint8_t d;
+
+	if (!(alarm->flags & SCHED_ENABLED)) {
+		return false;
+	}
+	for (d = 0; d <= 7; d++) {
+		uint32_t t = (day + d) * CAL_SECONDS_PER_DAY + tod;
+		if (t > now && (alarm->days == 0 || (alarm->days & (1u << (Cal_WeekdayOf(t) - 1))))) {
+			*next = t;
+			return true;
+		}
+	}
+	return false;
+}
+
+static void SchedQueue(uint8_t id) {
+	if (heapPos[id] == SCHED_NOT_QUEUED) {
+		heap[heapSize] = id;
+		heapPos[id] = heapSize++;
+	}
+	SchedSiftUp(heapPos[id]);
+	SchedSiftDown(heapPos[id]);
+}
+
+// Requeues id after its alarm or the clock changed
+static void SchedUpdate(uint8_t id, uint32_t now) {
+	if (!SchedNextDue(&alarms[id], now, &due[id])) {
+		SchedRemove(id);
+		return;
+	}
+	SchedQueue(id);
+}
+
+void Sched_Init(const Sched_Rtc_t* rtc) {
+	schedRtc = rtc;
+	memset(alarms, 0, sizeof(alarms));
+	memset(heapPos, SCHED_NOT_QUEUED, sizeof(heapPos));
+	heapSize = 0;
+	armed = false;
+}
+
+void Sched_Load(const Sched_Alarm_t* stored, uint8_t count, uint32_t now) {
+	if (count > SCHED_MAX_ALARMS) {
+		count = SCHED_MAX_ALARMS;
+	}
+	memset(alarms, 0, sizeof(alarms));
+	memcpy(alarms, stored, count * sizeof(Sched_Alarm_t));
+	Sched_Resync(now);
+}
+
+bool Sched_Set(uint8_t id, const Sched_Alarm_t* alarm, uint32_t now) {
+	if (id >= SCHED_MAX_ALARMS || alarm->hours > 23 || alarm->minutes > 59 || alarm->seconds > 59) {
+		return false;
+	}
+	alarms[id] = *alarm;
+	alarms[id].days &= SCHED_DAILY;
+	SchedUpdate(id, now);
+	Sched_Arm();
+	return true;
+}
+
+const Sched_Alarm_t* Sched_Get(uint8_t id) {
+	return (id < SCHED_MAX_ALARMS) ? &alarms[id] : NULL;
+}
+
+// Recomputes every due time, call after the clock has been set. A
+// pending snooze keeps its absolute due time.
+void Sched_Resync(uint32_t now) {
+	uint8_t id;
+	int pos;
+	bool snoozed = heapPos[SCHED_SNOOZE] != SCHED_NOT_QUEUED;
+
+	heapSize = 0;
+	heapPos[SCHED_SNOOZE] = SCHED_NOT_QUEUED;
+	if (snoozed) {
+		heap[heapSize] = SCHED_SNOOZE;
+		heapPos[SCHED_SNOOZE] = heapSize++;
+	}
+	for (id = 0; id < SCHED_MAX_ALARMS; id++) {
+		heapPos[id] = SCHED_NOT_QUEUED;
+		if (SchedNextDue(&alarms[id], now, &due[id])) {
+			heap[heapSize] = id;
+			heapPos[id] = heapSize++;
+		}
+	}
+	for (pos = heapSize / 2 - 1; pos >= 0; pos--) {
+		SchedSiftDown(pos);
+	}
+	armed = false;
+	Sched_Arm();
+}
+
+// Call when the hardware alarm goes off. Consumes every alarm due by now
+// and arms the next one; returns the alarm to ring, SCHED_SNOOZE, or -1
+// if all of them were skipped.
+int Sched_Fire(uint32_t now) {
+	int ring = -1;
+
+	while (heapSize > 0 && due[heap[0]] <= now) {
+		uint8_t id = heap[0];
+		Sched_Alarm_t* alarm;
+
+		if (id == SCHED_SNOOZE) {
+			ring = id;
+			SchedRemove(id);
+			continue;
+		}
+		alarm = &alarms[id];
+		if (alarm->flags & SCHED_SKIP_NEXT) {
+			alarm->flags &= ~SCHED_SKIP_NEXT;
+		}
+		else {
+			ring = id;
+			if (alarm->days == 0) {
+				alarm->flags &= ~SCHED_ENABLED;
+			}
+		}
+		SchedUpdate(id, now);
+	}
+	armed = false;
+	Sched_Arm();
+	return ring;
+}
+
+// Earliest queued alarm and its due time, -1 when nothing is queued
+int Sched_Next(uint32_t* next) {
+	if (heapSize == 0) {
+		return -1;
+	}
+	if (next != NULL) {
+		*next = due[heap[0]];
+	}
+	return heap[0];
+}
+
+// Queues a one-off wake-up at due, replacing any earlier snooze
+void Sched_Snooze(uint32_t snoozeDue) {
+	due[SCHED_SNOOZE] = snoozeDue;
+	SchedQueue(SCHED_SNOOZE);
+	Sched_Arm();
+}
+
+void Sched_CancelSnooze(void) {
+	if (heapPos[SCHED_SNOOZE] != SCHED_NOT_QUEUED) {
+		SchedRemove(SCHED_SNOOZE);
+		Sched_Arm();
+	}
+}
+
+// Hands the root to the hardware; retried by the caller while !Sched_Armed
+void Sched_Arm(void) {
+	if (schedRtc == NULL) {
+		return;
+	}
+	if (heapSize == 0) {
+		schedRtc->cancel();
+		armed = true;
+		return;
+	}
+	armed = schedRtc->program(due[heap[0]]) == 0;
+}
+
+bool Sched_Armed(void) {
+	return armed;
+}
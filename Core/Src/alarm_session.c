@@ -0,0 +1,82 @@
+/*
+ * alarm_session.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "alarm_session.h"
+
+#define SESSION_TIMEOUT_TICKS   (SESSION_TIMEOUT_S * 1000u / SESSION_BLINK_MS)
+
+// Session_Tick runs in interrupt context
+static volatile Session_State_t state = SESSION_IDLE;
+static volatile uint32_t ticks;
+static volatile bool blinkOn;
+static volatile bool redraw;
+static uint8_t snoozes;
+
+static void SessionRing(void) {
+	ticks = 0;
+	blinkOn = true;
+	redraw = true;
+	state = SESSION_RINGING;
+}
+
+// A fresh alarm, forgets earlier snoozes
+void Session_Start(void) {
+	snoozes = 0;
+	SessionRing();
+}
+
+// The snooze ran out
+void Session_Resume(void) {
+	SessionRing();
+}
+
+bool Session_Snooze(void) {
+	if (state != SESSION_RINGING || snoozes >= SESSION_MAX_SNOOZES) {
+		return false;
+	}
+	snoozes++;
+	state = SESSION_SNOOZED;
+	return true;
+}
+
+void Session_Stop(void) {
+	state = SESSION_IDLE;
+}
+
+void Session_Tick(void) {
+	if (state != SESSION_RINGING) {
+		return;
+	}
+	blinkOn = !blinkOn;
+	redraw = true;
+	if (ticks < SESSION_TIMEOUT_TICKS) {
+		ticks++;
+	}
+}
+
+Session_State_t Session_State(void) {
+	return state;
+}
+
+bool Session_BlinkOn(void) {
+	return blinkOn;
+}
+
+// True once per blink phase change
+bool Session_TakeRedraw(void) {
+	bool pending = redraw;
+	redraw = false;
+	return pending;
+}
+
+bool Session_TimedOut(void) {
+	return state == SESSION_RINGING && ticks >= SESSION_TIMEOUT_TICKS;
+}
+
+uint8_t Session_Snoozes(void) {
+	return snoozes;
+}
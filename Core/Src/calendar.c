@@ -0,0 +1,91 @@
+/*
+ * calendar.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "calendar.h"
+
+#define CAL_DAYS_PER_CYCLE      1461u    // four years starting with a leap year
+
+// Day of the year each month starts on, common years
+static const uint16_t monthStart[13] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365};
+
+bool Cal_IsLeap(uint8_t year) {
+	return (year & 3) == 0;
+}
+
+uint8_t Cal_DaysInMonth(uint8_t year, uint8_t month) {
+	if (month < 1 || month > 12) {
+		return 0;
+	}
+	return (uint8_t)(monthStart[month] - monthStart[month - 1] + (month == 2 && Cal_IsLeap(year)));
+}
+
+bool Cal_Valid(const Cal_DateTime_t* dt) {
+	return dt->year <= 99 && dt->date >= 1 && dt->date <= Cal_DaysInMonth(dt->year, dt->month) &&
+			dt->hours <= 23 && dt->minutes <= 59 && dt->seconds <= 59;
+}
+
+// Pulls a day of month that no longer exists, e.g. 31 after a move to April, back to the last day
+uint8_t Cal_ClampDate(uint8_t year, uint8_t month, uint8_t date) {
+	uint8_t last = Cal_DaysInMonth(year, month);
+
+	if (date < 1) {
+		return 1;
+	}
+	return (date > last) ? last : date;
+}
+
+// Days since 2000-01-01
+uint16_t Cal_Days(uint8_t year, uint8_t month, uint8_t date) {
+	return (uint16_t)(year * 365u + (year + 3u) / 4u + monthStart[month - 1] +
+			(month > 2 && Cal_IsLeap(year)) + date - 1u);
+}
+
+void Cal_FromDays(uint16_t days, Cal_DateTime_t* dt) {
+	uint32_t cycle = days / CAL_DAYS_PER_CYCLE;
+	uint32_t rem = days % CAL_DAYS_PER_CYCLE;
+	uint32_t y;
+	uint32_t yday;
+	uint8_t leap;
+	uint8_t month;
+
+	// The leap year leads the cycle, so only its extra day needs folding out
+	y = (rem >= 366u) ? (rem - 1u) / 365u : 0u;
+	yday = rem - y * 365u - (y > 0);
+	dt->year = (uint8_t)(cycle * 4u + y);
+	leap = (y == 0) && yday >= 59u;
+	// Months are 28-31 days, so yday / 32 undershoots by at most one
+	month = (uint8_t)((yday - leap) / 32u);
+	if (yday - leap >= monthStart[month + 1]) {
+		month++;
+	}
+	dt->month = month + 1;
+	dt->date = (uint8_t)(yday - monthStart[month] - (leap && month > 1) + 1u);
+	dt->weekday = (uint8_t)((days + 5u) % 7u + 1u);
+}
+
+// 1 = Monday ... 7 = Sunday; 2000-01-01 was a Saturday
+uint8_t Cal_Weekday(uint8_t year, uint8_t month, uint8_t date) {
+	return (uint8_t)((Cal_Days(year, month, date) + 5u) % 7u + 1u);
+}
+
+uint8_t Cal_WeekdayOf(uint32_t time) {
+	return (uint8_t)((time / CAL_SECONDS_PER_DAY + 5u) % 7u + 1u);
+}
+
+uint32_t Cal_ToSeconds(const Cal_DateTime_t* dt) {
+	return Cal_Days(dt->year, dt->month, dt->date) * CAL_SECONDS_PER_DAY +
+			dt->hours * 3600u + dt->minutes * 60u + dt->seconds;
+}
+
+void Cal_FromSeconds(uint32_t time, Cal_DateTime_t* dt) {
+	uint32_t tod = time % CAL_SECONDS_PER_DAY;
+
+	Cal_FromDays((uint16_t)(time / CAL_SECONDS_PER_DAY), dt);
+	dt->hours = (uint8_t)(tod / 3600u);
+	dt->minutes = (uint8_t)((tod / 60u) % 60u);
+	dt->seconds = (uint8_t)(tod % 60u);
+}
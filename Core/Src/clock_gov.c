@@ -0,0 +1,191 @@
+/*
+ * clock_gov.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "main.h"
+#include "clock_gov.h"
+#include "uart_log.h"
+#include "trace.h"
+#include "i2c_bus.h"
+
+extern TIM_HandleTypeDef htim3;
+extern UART_HandleTypeDef huart2;
+
+static uint32_t (*clockNowMs)(void);
+static Clock_Point_t clockPoint = CLOCK_FULL;
+static uint32_t clockSince;
+static Clock_Stats_t stats;
+
+// Charges the time since the last call to the current point
+static void ClockAccount(void) {
+	uint32_t now = clockNowMs();
+	int32_t elapsed = (int32_t)(now - clockSince);
+
+	// The clock source is the RTC; a backwards set is not time spent
+	if (elapsed > 0) {
+		stats.ms[clockPoint] += elapsed;
+	}
+	clockSince = now;
+}
+
+static uint32_t ClockCyclesToUs(uint32_t cycles, uint32_t hz) {
+	return (uint32_t)((uint64_t)cycles * 1000000u / hz);
+}
+
+// Scales the prescaler so a tick lasts as long as before. The update event
+// that loads it is kept from setting UIF, which would end the inactivity
+// timeout, and the count already run down is put back afterwards.
+static void ClockTim3(uint32_t hz) {
+	uint32_t psc = (uint32_t)(((uint64_t)(CLOCK_TIM3_PSC_FULL + 1) * hz + CLOCK_FULL_HZ / 2) / CLOCK_FULL_HZ) - 1;
+	uint32_t cnt = __HAL_TIM_GET_COUNTER(&htim3);
+	uint32_t urs = READ_BIT(htim3.Instance->CR1, TIM_CR1_URS);
+
+	__HAL_TIM_SET_PRESCALER(&htim3, psc);
+	htim3.Init.Prescaler = psc;
+	SET_BIT(htim3.Instance->CR1, TIM_CR1_URS);
+	htim3.Instance->EGR = TIM_EGR_UG;
+	MODIFY_REG(htim3.Instance->CR1, TIM_CR1_URS, urs);
+	__HAL_TIM_SET_COUNTER(&htim3, cnt);
+}
+
+// The logger is held across the switch, so the line is already quiet here
+static void ClockUart(uint32_t pclk) {
+	__HAL_UART_DISABLE(&huart2);
+	huart2.Instance->BRR = (pclk + huart2.Init.BaudRate / 2) / huart2.Init.BaudRate;
+	__HAL_UART_ENABLE(&huart2);
+}
+
+static HAL_StatusTypeDef ClockToLow(void) {
+	RCC_OscInitTypeDef osc = {0};
+	RCC_ClkInitTypeDef clk = {0};
+
+	osc.OscillatorType = RCC_OSCILLATORTYPE_MSI;
+	osc.MSIState = RCC_MSI_ON;
+	osc.MSICalibrationValue = RCC_MSICALIBRATION_DEFAULT;
+	osc.MSIClockRange = RCC_MSIRANGE_6;
+	osc.PLL.PLLState = RCC_PLL_NONE;
+	if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_MSI;
+	clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	clk.APB1CLKDivider = RCC_HCLK_DIV1;
+	clk.APB2CLKDivider = RCC_HCLK_DIV1;
+	if (HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_0) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	__HAL_RCC_PLL_DISABLE();
+	__HAL_RCC_HSI_DISABLE();
+	return HAL_PWREx_ControlVoltageScaling(PWR_REGULATOR_VOLTAGE_SCALE2);
+}
+
+// The PLL keeps its CubeMX configuration while it is off, so it only has to be started
+static HAL_StatusTypeDef ClockToFull(void) {
+	RCC_ClkInitTypeDef clk = {0};
+
+	if (HAL_PWREx_ControlVoltageScaling(PWR_REGULATOR_VOLTAGE_SCALE1) != HAL_OK) {
+		return HAL_ERROR;
+	}
+	__HAL_RCC_HSI_ENABLE();
+	while (__HAL_RCC_GET_FLAG(RCC_FLAG_HSIRDY) == 0U) {
+	}
+	__HAL_RCC_PLL_ENABLE();
+	while (__HAL_RCC_GET_FLAG(RCC_FLAG_PLLRDY) == 0U) {
+	}
+	clk.ClockType = RCC_CLOCKTYPE_HCLK | RCC_CLOCKTYPE_SYSCLK | RCC_CLOCKTYPE_PCLK1 | RCC_CLOCKTYPE_PCLK2;
+	clk.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+	clk.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	clk.APB1CLKDivider = RCC_HCLK_DIV1;
+	clk.APB2CLKDivider = RCC_HCLK_DIV1;
+	return HAL_RCC_ClockConfig(&clk, FLASH_LATENCY_4);
+}
+
+// Call once the LSE and the peripherals are up, with the clock at CLOCK_FULL
+void Clock_Init(uint32_t (*nowMs)(void)) {
+	clockNowMs = nowMs;
+	clockPoint = CLOCK_FULL;
+	clockSince = nowMs();
+	memset(&stats, 0, sizeof(stats));
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	// MSI follows the LSE from here on, which keeps the UART in spec at 4 MHz
+	HAL_RCCEx_EnableMSIPLLMode();
+}
+
+HAL_StatusTypeDef Clock_Set(Clock_Point_t point) {
+	uint32_t start = DWT->CYCCNT;
+	uint32_t oldHz = SystemCoreClock;
+	uint32_t us;
+	HAL_StatusTypeDef result;
+
+	if (point == clockPoint || clockNowMs == NULL) {
+		return HAL_OK;
+	}
+	ClockAccount();
+	// TIMINGR is rewritten below, so no I2C job may be running
+	Bus_WaitAll();
+	// Let the transfer in flight finish at the old baud rate
+	Log_Hold(true);
+	while (!__HAL_UART_GET_FLAG(&huart2, UART_FLAG_TC)) {
+	}
+	Trace_Sync();
+	result = (point == CLOCK_LOW) ? ClockToLow() : ClockToFull();
+	if (result != HAL_OK) {
+		// HAL_RCC_ClockConfig leaves the old clock running when it fails
+		Log_Hold(false);
+		return result;
+	}
+	clockPoint = point;
+	Bus_ClockChanged();
+	ClockTim3(HAL_RCC_GetPCLK1Freq());
+	ClockUart(HAL_RCC_GetPCLK1Freq());
+	Log_Hold(false);
+	Trace_ClockChanged();
+	// Most of the switch runs at the slower of the two clocks
+	us = ClockCyclesToUs(DWT->CYCCNT - start, (oldHz < SystemCoreClock) ? oldHz : SystemCoreClock);
+	stats.switches[point]++;
+	stats.switchUs = us;
+	if (us > stats.switchMaxUs) {
+		stats.switchMaxUs = us;
+	}
+	return HAL_OK;
+}
+
+Clock_Point_t Clock_Get(void) {
+	return clockPoint;
+}
+
+// Stop 2 wakes on MSI or HSI16; pick the one the current point runs from
+void Clock_PrepareStop(void) {
+	__HAL_RCC_WAKEUPSTOP_CLK_CONFIG((clockPoint == CLOCK_LOW) ? RCC_STOP_WAKEUPCLOCK_MSI : RCC_STOP_WAKEUPCLOCK_HSI);
+}
+
+// Restores the current point after Stop 2, returns how long it took in microseconds
+uint32_t Clock_Resume(void) {
+	uint32_t start = DWT->CYCCNT;
+	uint32_t us;
+
+	if (clockPoint == CLOCK_LOW) {
+		// Already back on MSI in range 2
+		return 0;
+	}
+	SystemClock_Resume();
+	us = ClockCyclesToUs(DWT->CYCCNT - start, HSI_VALUE);
+	Trace_ClockChanged();
+	return us;
+}
+
+const Clock_Stats_t* Clock_GetStats(void) {
+	ClockAccount();
+	return &stats;
+}
+
+void Clock_ResetStats(void) {
+	ClockAccount();
+	memset(&stats, 0, sizeof(stats));
+}
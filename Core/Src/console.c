@@ -0,0 +1,241 @@
+/*
+ * console.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "console.h"
+
+#define CONSOLE_PROMPT          "> "
+
+static const Console_Command_t* consoleCommands;
+static uint8_t consoleCount;
+static void (*consoleWrite)(const char* text, uint16_t len);
+static char line[CONSOLE_LINE_MAX];
+static uint8_t len;
+static uint8_t argStart[CONSOLE_ARGS_MAX];  // offset of each word in line
+static uint8_t argc;
+static uint8_t words;                       // words typed; argc stops at CONSOLE_ARGS_MAX
+static bool overflow;                       // bytes were dropped off the end of the line
+static char lastEnd;                        // swallows the LF of a CRLF
+
+void Console_Init(const Console_Command_t* commands, uint8_t count, void (*write)(const char* text, uint16_t len)) {
+	consoleCommands = commands;
+	consoleCount = count;
+	consoleWrite = write;
+	len = 0;
+	argc = 0;
+	words = 0;
+	overflow = false;
+	Console_Print(CONSOLE_PROMPT);
+}
+
+void Console_Print(const char* text) {
+	consoleWrite(text, strlen(text));
+}
+
+static void ConsoleHelp(void) {
+	uint8_t i;
+
+	Console_Print("help\r\n");
+	for (i = 0; i < consoleCount; i++) {
+		Console_Print(consoleCommands[i].name);
+		if (consoleCommands[i].usage[0] != '\0') {
+			Console_Print(" ");
+			Console_Print(consoleCommands[i].usage);
+		}
+		Console_Print("\r\n");
+	}
+}
+
+static void ConsoleRun(void) {
+	char* argv[CONSOLE_ARGS_MAX];
+	const Console_Command_t* cmd = NULL;
+	Console_Result_t result;
+	uint8_t i;
+
+	if (overflow) {
+		Console_Print("err line too long\r\n");
+		return;
+	}
+	if (words > CONSOLE_ARGS_MAX) {
+		Console_Print("err too many words\r\n");
+		return;
+	}
+	if (argc == 0) {
+		return;
+	}
+	line[len] = '\0';
+	for (i = 0; i < argc; i++) {
+		argv[i] = &line[argStart[i]];
+	}
+	if (strcmp(argv[0], "help") == 0) {
+		ConsoleHelp();
+		Console_Print("ok\r\n");
+		return;
+	}
+	for (i = 0; i < consoleCount; i++) {
+		if (strcmp(argv[0], consoleCommands[i].name) == 0) {
+			cmd = &consoleCommands[i];
+			break;
+		}
+	}
+	if (cmd == NULL) {
+		Console_Print("err unknown command, try help\r\n");
+		return;
+	}
+	result = cmd->run(argc, argv);
+	switch (result) {
+		case CONSOLE_OK:
+			Console_Print("ok\r\n");
+			break;
+		case CONSOLE_ERR_USAGE:
+			Console_Print("err usage: ");
+			Console_Print(cmd->name);
+			Console_Print(" ");
+			Console_Print(cmd->usage);
+			Console_Print("\r\n");
+			break;
+		case CONSOLE_ERR_ARG:
+			Console_Print("err bad argument\r\n");
+			break;
+		case CONSOLE_ERR_BUSY:
+			Console_Print("err busy\r\n");
+			break;
+		default:
+			Console_Print("err failed\r\n");
+			break;
+	}
+}
+
+static void ConsoleReset(void) {
+	len = 0;
+	argc = 0;
+	words = 0;
+	overflow = false;
+}
+
+// Feeds one received byte; returns true when it ended a line that was run
+bool Console_Feed(char c) {
+	char end = lastEnd;
+
+	lastEnd = '\0';
+	if (c == '\r' || c == '\n') {
+		if (c == '\n' && end == '\r') {
+			return false;
+		}
+		lastEnd = c;
+		Console_Print("\r\n");
+		ConsoleRun();
+		ConsoleReset();
+		Console_Print(CONSOLE_PROMPT);
+		return true;
+	}
+	if (c == 0x03) {
+		// Ctrl-C
+		Console_Print("^C\r\n" CONSOLE_PROMPT);
+		ConsoleReset();
+		return false;
+	}
+	if (c == '\b' || c == 0x7F) {
+		if (len == 0) {
+			return false;
+		}
+		len--;
+		// Dropped bytes were never echoed, so the line on screen is the
+		// one stored and is back within the limit
+		overflow = false;
+		if (line[len] != '\0' && (len == 0 || line[len - 1] == '\0')) {
+			// Erased the first character of the last word
+			if (words-- <= CONSOLE_ARGS_MAX) {
+				argc--;
+			}
+		}
+		consoleWrite("\b \b", 3);
+		return false;
+	}
+	if (c < ' ' || c > '~') {
+		return false;
+	}
+	if (len >= CONSOLE_LINE_MAX - 1) {
+		overflow = true;
+		return false;
+	}
+	if (c == ' ') {
+		line[len++] = '\0';
+	}
+	else {
+		if (len == 0 || line[len - 1] == '\0') {
+			// First character of a word
+			if (words++ < CONSOLE_ARGS_MAX) {
+				argStart[argc++] = len;
+			}
+		}
+		line[len++] = c;
+	}
+	consoleWrite(&c, 1);
+	return false;
+}
+
+// Decimal digits only
+bool Console_ParseU(const char* text, uint32_t* value) {
+	uint32_t v = 0;
+
+	if (*text == '\0') {
+		return false;
+	}
+	for (; *text != '\0'; text++) {
+		uint32_t d = *text - '0';
+		if (*text < '0' || *text > '9' || v > (UINT32_MAX - d) / 10) {
+			return false;
+		}
+		v = v * 10 + d;
+	}
+	*value = v;
+	return true;
+}
+
+// "98.1" with two decimals gives 9810; missing decimals count as zeros
+bool Console_ParseFixed(const char* text, uint8_t decimals, uint32_t* value) {
+	char digits[12];
+	const char* dot = strchr(text, '.');
+	size_t whole = (dot != NULL) ? (size_t)(dot - text) : strlen(text);
+	size_t frac = (dot != NULL) ? strlen(dot + 1) : 0;
+	uint8_t i;
+
+	if (whole == 0 || frac > decimals || whole + decimals >= sizeof(digits)) {
+		return false;
+	}
+	memcpy(digits, text, whole);
+	for (i = 0; i < decimals; i++) {
+		digits[whole + i] = (i < frac) ? dot[1 + i] : '0';
+	}
+	digits[whole + decimals] = '\0';
+	return Console_ParseU(digits, value);
+}
+
+// Splits "21:24:05" or "2025-04-05" into numbers; returns how many, 0 if malformed
+uint8_t Console_ParseFields(const char* text, char sep, uint32_t* fields, uint8_t max) {
+	char field[11];
+	uint8_t count = 0;
+
+	while (count < max) {
+		const char* end = strchr(text, sep);
+		size_t n = (end != NULL) ? (size_t)(end - text) : strlen(text);
+		if (n == 0 || n >= sizeof(field)) {
+			return 0;
+		}
+		memcpy(field, text, n);
+		field[n] = '\0';
+		if (!Console_ParseU(field, &fields[count++])) {
+			return 0;
+		}
+		if (end == NULL) {
+			return count;
+		}
+		text = end + 1;
+	}
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ * console_uart.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "console_uart.h"
+#include "uart_log.h"
+
+extern UART_HandleTypeDef huart2;
+
+static DMA_HandleTypeDef hdmaRx;
+static uint8_t rx[CONSOLE_RX_SIZE];
+static uint16_t rxRead;                 // next byte of rx to hand to the console
+static volatile uint32_t activeTick;
+static volatile bool active;
+
+// Replies are few and short; waiting for room keeps them whole
+static void ConsoleUartWrite(const char* text, uint16_t len) {
+	Log_WriteWait(text, len);
+}
+
+// (Re)starts circular reception; after an overrun HAL aborts it and leaves RxState ready
+static void ConsoleUartStart(void) {
+	rxRead = 0;
+	if (HAL_UART_Receive_DMA(&huart2, rx, CONSOLE_RX_SIZE) == HAL_OK) {
+		// Only errors matter here, not the half and full buffer marks
+		__HAL_DMA_DISABLE_IT(&hdmaRx, DMA_IT_HT | DMA_IT_TC);
+	}
+}
+
+void Console_UartInit(const Console_Command_t* commands, uint8_t count) {
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	hdmaRx.Instance = DMA1_Channel6;
+	hdmaRx.Init.Request = DMA_REQUEST_2;
+	hdmaRx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+	hdmaRx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdmaRx.Init.MemInc = DMA_MINC_ENABLE;
+	hdmaRx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaRx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdmaRx.Init.Mode = DMA_CIRCULAR;
+	hdmaRx.Init.Priority = DMA_PRIORITY_LOW;
+	if (HAL_DMA_Init(&hdmaRx) != HAL_OK) {
+		return;
+	}
+	__HAL_LINKDMA(&huart2, hdmarx, hdmaRx);
+	HAL_NVIC_SetPriority(DMA1_Channel6_IRQn, 3, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+	Console_Init(commands, count, ConsoleUartWrite);
+	ConsoleUartStart();
+}
+
+// Call from the main loop; runs at most the lines that arrived since the last call
+void Console_UartTask(void) {
+	uint16_t write;
+
+	if (huart2.RxState == HAL_UART_STATE_READY) {
+		ConsoleUartStart();
+		return;
+	}
+	write = CONSOLE_RX_SIZE - __HAL_DMA_GET_COUNTER(&hdmaRx);
+	if (write == CONSOLE_RX_SIZE) {
+		write = 0;
+	}
+	if (write != rxRead) {
+		activeTick = HAL_GetTick();
+		active = true;
+	}
+	while (rxRead != write) {
+		Console_Feed((char)rx[rxRead]);
+		rxRead = (rxRead + 1) % CONSOLE_RX_SIZE;
+	}
+}
+
+// True while someone has typed recently; the clock face stays out of Stop 2
+bool Console_UartActive(void) {
+	if (active && HAL_GetTick() - activeTick >= CONSOLE_AWAKE_MS) {
+		active = false;
+	}
+	return active;
+}
+
+// EXTI3 saw the RX line move, from Stop 2
+void Console_UartWake(void) {
+	activeTick = HAL_GetTick();
+	active = true;
+}
+
+void Console_UartDmaIRQHandler(void) {
+	HAL_DMA_IRQHandler(&hdmaRx);
+}
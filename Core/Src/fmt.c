@@ -0,0 +1,155 @@
+/*
+ * fmt.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "fmt.h"
+
+// "00" "01" ... "99", indexed by 2 * value
+static const char digitPairs[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+char* Fmt_Str(char* dst, const char* src) {
+	while (*src) {
+		*dst++ = *src++;
+	}
+	*dst = '\0';
+	return dst;
+}
+
+char* Fmt_Char(char* dst, char c) {
+	*dst++ = c;
+	*dst = '\0';
+	return dst;
+}
+
+// Always two characters, values above 99 wrap to their last two digits
+char* Fmt_U2(char* dst, uint8_t value) {
+	const char* pair = &digitPairs[(value % 100) * 2];
+	dst[0] = pair[0];
+	dst[1] = pair[1];
+	dst[2] = '\0';
+	return dst + 2;
+}
+
+char* Fmt_UPad(char* dst, uint32_t value, uint8_t width) {
+	char tmp[10];
+	int len = 0;
+
+	// Emit two digits per step from the least significant end
+	while (value >= 100) {
+		uint32_t q = value / 100;
+		const char* pair = &digitPairs[(value - q * 100) * 2];
+		tmp[len++] = pair[1];
+		tmp[len++] = pair[0];
+		value = q;
+	}
+	if (value >= 10) {
+		tmp[len++] = digitPairs[value * 2 + 1];
+		tmp[len++] = digitPairs[value * 2];
+	}
+	else {
+		tmp[len++] = (char)('0' + value);
+	}
+	while (len < width) {
+		*dst++ = '0';
+		width--;
+	}
+	while (len > 0) {
+		*dst++ = tmp[--len];
+	}
+	*dst = '\0';
+	return dst;
+}
+
+char* Fmt_UDec(char* dst, uint32_t value) {
+	return Fmt_UPad(dst, value, 0);
+}
+
+char* Fmt_IDec(char* dst, int32_t value) {
+	if (value < 0) {
+		*dst++ = '-';
+		return Fmt_UPad(dst, 0u - (uint32_t)value, 0);
+	}
+	return Fmt_UPad(dst, (uint32_t)value, 0);
+}
+
+// value is scaled by 10^decimals, e.g. Fmt_Fixed(buf, 8810, 2) gives "88.10"
+char* Fmt_Fixed(char* dst, int32_t value, uint8_t decimals) {
+	uint32_t mag = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+	uint32_t scale;
+
+	if (decimals > 9) {
+		decimals = 9;
+	}
+	scale = pow10[decimals];
+	if (value < 0) {
+		*dst++ = '-';
+	}
+	dst = Fmt_UPad(dst, mag / scale, 0);
+	if (decimals == 0) {
+		return dst;
+	}
+	*dst++ = '.';
+	return Fmt_UPad(dst, mag % scale, decimals);
+}
+
+// "HH:MM:SS"
+char* Fmt_Time(char* dst, uint8_t hours, uint8_t minutes, uint8_t seconds) {
+	dst = Fmt_HourMin(dst, hours, minutes);
+	*dst++ = ':';
+	return Fmt_U2(dst, seconds);
+}
+
+// "HH:MM"
+char* Fmt_HourMin(char* dst, uint8_t hours, uint8_t minutes) {
+	dst = Fmt_U2(dst, hours);
+	*dst++ = ':';
+	return Fmt_U2(dst, minutes);
+}
+
+// "MM/DD/YYYY"
+char* Fmt_Date(char* dst, uint8_t month, uint8_t date, uint16_t year) {
+	dst = Fmt_U2(dst, month);
+	*dst++ = '/';
+	dst = Fmt_U2(dst, date);
+	*dst++ = '/';
+	return Fmt_UDec(dst, year);
+}
+
+// "1st", "2nd", "3rd", "4th" ... "11th", "12th", "13th" ... "21st"
+char* Fmt_Ordinal(char* dst, uint8_t number) {
+	const char* suffix = "th";
+	uint8_t tens = number % 100;
+
+	if (tens < 11 || tens > 13) {
+		switch (number % 10) {
+			case 1:
+				suffix = "st";
+				break;
+			case 2:
+				suffix = "nd";
+				break;
+			case 3:
+				suffix = "rd";
+				break;
+			default:
+				break;
+		}
+	}
+	dst = Fmt_UDec(dst, number);
+	return Fmt_Str(dst, suffix);
+}
@@ -0,0 +1,601 @@
+/*
+ * i2c_bus.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "i2c_bus.h"
+#include "i2c_speed.h"
+
+extern I2C_HandleTypeDef hi2c1;
+extern I2C_HandleTypeDef hi2c2;
+
+typedef struct {
+	I2C_HandleTypeDef* hi2c;
+	GPIO_TypeDef* port;
+	uint16_t scl;
+	uint16_t sda;
+	IRQn_Type evIrq;
+	IRQn_Type erIrq;
+	bool dma;                       // writes go by DMA, DMA2 channel 7
+	uint32_t fmp;                   // Fast-mode Plus drive for the pins
+} Bus_t;
+
+typedef struct {
+	uint32_t ceilingHz;             // asked for, less any fallbacks
+	uint32_t hz;                    // in use: the fastest up to the ceiling PCLK1 allows
+	uint32_t actualHz;
+} BusSpeed_t;
+
+typedef enum {
+	BUS_ATTEMPT_RUNNING,
+	BUS_ATTEMPT_FAILED,             // for Bus_Task to recover and retry
+	BUS_ATTEMPT_BACKOFF
+} BusAttempt_t;
+
+typedef struct {
+	Bus_Job_t* head[BUS_PRIOS];
+	Bus_Job_t* tail[BUS_PRIOS];
+	uint8_t depth;
+	Bus_Job_t* active;
+	volatile BusAttempt_t attempt;
+	uint32_t error;                 // HAL error code of the failed attempt
+	uint32_t startTick;             // of the running attempt, or end of the backoff
+	uint32_t startCycles;           // of the active job's first attempt
+	Bus_Job_t* doneHead;            // finished, callbacks not run yet
+	Bus_Job_t* doneTail;
+	uint8_t failRun;                // failed jobs in a row
+	bool down;
+	uint32_t downTick;
+} BusQueue_t;
+
+static const Bus_t buses[BUS_COUNT] = {
+	[BUS_OLED] = {&hi2c1, GPIOB, GPIO_PIN_6, GPIO_PIN_7, I2C1_EV_IRQn, I2C1_ER_IRQn, true, I2C_FASTMODEPLUS_I2C1},
+	[BUS_RADIO] = {&hi2c2, GPIOB, GPIO_PIN_10, GPIO_PIN_11, I2C2_EV_IRQn, I2C2_ER_IRQn, false, I2C_FASTMODEPLUS_I2C2}
+};
+
+static DMA_HandleTypeDef hdmaOledTx;
+static BusQueue_t queues[BUS_COUNT];
+static Bus_Stats_t stats[BUS_COUNT];
+static BusSpeed_t speeds[BUS_COUNT];
+
+static uint32_t BusCyclesToUs(uint32_t cycles) {
+	return (uint32_t)((uint64_t)cycles * 1000000u / SystemCoreClock);
+}
+
+static void BusDelayUs(uint32_t us) {
+	uint32_t start = DWT->CYCCNT;
+	uint32_t cycles = (uint32_t)((uint64_t)SystemCoreClock * us / 1000000u);
+
+	while (DWT->CYCCNT - start < cycles) {
+	}
+}
+
+// Masks one bus's interrupts only; SysTick keeps running for the HAL's own timeouts
+static void BusLock(Bus_Id_t bus) {
+	HAL_NVIC_DisableIRQ(buses[bus].evIrq);
+	HAL_NVIC_DisableIRQ(buses[bus].erIrq);
+	if (buses[bus].dma) {
+		HAL_NVIC_DisableIRQ(DMA2_Channel7_IRQn);
+	}
+}
+
+static void BusUnlock(Bus_Id_t bus) {
+	if (buses[bus].dma) {
+		HAL_NVIC_EnableIRQ(DMA2_Channel7_IRQn);
+	}
+	HAL_NVIC_EnableIRQ(buses[bus].erIrq);
+	HAL_NVIC_EnableIRQ(buses[bus].evIrq);
+}
+
+// Sets TIMINGR for the fastest rate up to the ceiling that the current
+// PCLK1, the I2C kernel clock, can time. With no job running only.
+static void BusApplySpeed(Bus_Id_t bus) {
+	const Bus_t* b = &buses[bus];
+	BusSpeed_t* sp = &speeds[bus];
+	uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+	uint32_t timing;
+
+	for (sp->hz = sp->ceilingHz; sp->hz != 0; sp->hz = Speed_Below(sp->hz)) {
+		if (Speed_Timing(pclk, sp->hz, &timing, &sp->actualHz)) {
+			break;
+		}
+	}
+	if (sp->hz == 0) {
+		return;
+	}
+	if (sp->hz > SPEED_FAST_HZ) {
+		HAL_I2CEx_EnableFastModePlus(b->fmp);
+	}
+	else {
+		HAL_I2CEx_DisableFastModePlus(b->fmp);
+	}
+	// TIMINGR can only be written with the peripheral disabled; Init.Timing
+	// is what a recovery's HAL_I2C_Init puts back
+	__HAL_I2C_DISABLE(b->hi2c);
+	b->hi2c->Instance->TIMINGR = timing;
+	b->hi2c->Init.Timing = timing;
+	__HAL_I2C_ENABLE(b->hi2c);
+}
+
+void Bus_Init(void) {
+	// The recovery clock and the latency figures run off the cycle counter
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	memset(queues, 0, sizeof(queues));
+	Bus_ResetStats();
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++) {
+		speeds[bus].ceilingHz = SPEED_FAST_HZ;
+		BusApplySpeed(bus);
+	}
+
+	__HAL_RCC_DMA2_CLK_ENABLE();
+	hdmaOledTx.Instance = DMA2_Channel7;
+	hdmaOledTx.Init.Request = DMA_REQUEST_5;
+	hdmaOledTx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdmaOledTx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdmaOledTx.Init.MemInc = DMA_MINC_ENABLE;
+	hdmaOledTx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaOledTx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdmaOledTx.Init.Mode = DMA_NORMAL;
+	hdmaOledTx.Init.Priority = DMA_PRIORITY_LOW;
+	if (HAL_DMA_Init(&hdmaOledTx) == HAL_OK) {
+		__HAL_LINKDMA(&hi2c1, hdmatx, hdmaOledTx);
+		HAL_NVIC_SetPriority(DMA2_Channel7_IRQn, 3, 0);
+		HAL_NVIC_EnableIRQ(DMA2_Channel7_IRQn);
+	}
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++) {
+		HAL_NVIC_SetPriority(buses[bus].evIrq, 3, 0);
+		HAL_NVIC_SetPriority(buses[bus].erIrq, 3, 0);
+		HAL_NVIC_EnableIRQ(buses[bus].evIrq);
+		HAL_NVIC_EnableIRQ(buses[bus].erIrq);
+	}
+}
+
+// Start, address and the register byte come on top of the data; the spare
+// milliseconds cover the tick the deadline starts in and clock stretching
+uint32_t Bus_DeadlineMs(uint16_t len) {
+	uint32_t bits = ((uint32_t)len + 3) * 9;
+
+	return 2 + (bits + BUS_SLOW_KHZ - 1) / BUS_SLOW_KHZ;
+}
+
+// Every attempt can run a tick past its deadline before Bus_Task sees it,
+// plus about a millisecond of recovery, and the backoffs add up to
+// BUS_BACKOFF_MS * (2^BUS_RETRIES - 1) with a tick of slack each.
+uint32_t Bus_WorstCaseMs(uint16_t len) {
+	return (BUS_RETRIES + 1) * (Bus_DeadlineMs(len) + 2) + BUS_BACKOFF_MS * ((1u << BUS_RETRIES) - 1) + BUS_RETRIES;
+}
+
+// Frees a bus a slave is holding: with the pins as open-drain GPIO, SCL is
+// clocked until the slave finishes the byte it thinks it is sending and
+// lets go of SDA, then a STOP resets every slave's state machine. Returns
+// false if SDA or SCL is still low afterwards. Not while a job is running.
+bool Bus_Recover(Bus_Id_t bus) {
+	const Bus_t* b = &buses[bus];
+	GPIO_InitTypeDef gpio = {0};
+	bool released;
+
+	if (b->hi2c->hdmatx != NULL && b->hi2c->hdmatx->State == HAL_DMA_STATE_BUSY) {
+		HAL_DMA_Abort(b->hi2c->hdmatx);
+	}
+	HAL_I2C_DeInit(b->hi2c);
+	HAL_GPIO_WritePin(b->port, b->scl | b->sda, GPIO_PIN_SET);
+	gpio.Pin = b->scl | b->sda;
+	gpio.Mode = GPIO_MODE_OUTPUT_OD;
+	gpio.Pull = GPIO_NOPULL;
+	gpio.Speed = GPIO_SPEED_FREQ_LOW;
+	HAL_GPIO_Init(b->port, &gpio);
+	BusDelayUs(5);
+	for (uint8_t i = 0; i < 9 && HAL_GPIO_ReadPin(b->port, b->sda) == GPIO_PIN_RESET; i++) {
+		HAL_GPIO_WritePin(b->port, b->scl, GPIO_PIN_RESET);
+		BusDelayUs(5);
+		HAL_GPIO_WritePin(b->port, b->scl, GPIO_PIN_SET);
+		BusDelayUs(5);
+	}
+	// STOP: SDA rises while SCL is high
+	HAL_GPIO_WritePin(b->port, b->sda, GPIO_PIN_RESET);
+	BusDelayUs(5);
+	HAL_GPIO_WritePin(b->port, b->sda, GPIO_PIN_SET);
+	BusDelayUs(5);
+	released = HAL_GPIO_ReadPin(b->port, b->sda) == GPIO_PIN_SET &&
+			HAL_GPIO_ReadPin(b->port, b->scl) == GPIO_PIN_SET;
+	// MspInit hands the pins back to the peripheral; Init.Timing still
+	// holds what the clock governor last set
+	HAL_I2C_Init(b->hi2c);
+	stats[bus].recoveries++;
+	if (!released) {
+		stats[bus].stuck++;
+	}
+	return released;
+}
+
+// Bus locked or in its interrupt from here down to BusNext
+
+static void BusAttemptStart(Bus_Id_t bus) {
+	const Bus_t* b = &buses[bus];
+	BusQueue_t* q = &queues[bus];
+	Bus_Job_t* job = q->active;
+	HAL_StatusTypeDef status;
+
+	q->attempt = BUS_ATTEMPT_RUNNING;
+	q->startTick = HAL_GetTick();
+	switch (job->op) {
+		case BUS_OP_TX:
+			status = b->dma ? HAL_I2C_Master_Transmit_DMA(b->hi2c, job->addr, job->data, job->len) :
+					HAL_I2C_Master_Transmit_IT(b->hi2c, job->addr, job->data, job->len);
+			break;
+		case BUS_OP_RX:
+			status = HAL_I2C_Master_Receive_IT(b->hi2c, job->addr, job->data, job->len);
+			break;
+		default:
+			status = b->dma ? HAL_I2C_Mem_Write_DMA(b->hi2c, job->addr, job->reg, I2C_MEMADD_SIZE_8BIT, job->data, job->len) :
+					HAL_I2C_Mem_Write_IT(b->hi2c, job->addr, job->reg, I2C_MEMADD_SIZE_8BIT, job->data, job->len);
+			break;
+	}
+	if (status != HAL_OK) {
+		// HAL_BUSY is the bus busy flag, a stuck bus; it leaves the error code alone
+		q->error = (status == HAL_BUSY) ? HAL_I2C_ERROR_NONE : HAL_I2C_GetError(b->hi2c);
+		q->attempt = BUS_ATTEMPT_FAILED;
+	}
+}
+
+static void BusDone(Bus_Id_t bus, Bus_Job_t* job, HAL_StatusTypeDef status) {
+	BusQueue_t* q = &queues[bus];
+
+	job->status = status;
+	job->next = NULL;
+	job->state = BUS_JOB_FINISHED;
+	if (q->doneTail != NULL) {
+		q->doneTail->next = job;
+	}
+	else {
+		q->doneHead = job;
+	}
+	q->doneTail = job;
+}
+
+static void BusNext(Bus_Id_t bus) {
+	BusQueue_t* q = &queues[bus];
+
+	while (q->active == NULL) {
+		Bus_Job_t* job = NULL;
+		for (uint8_t prio = 0; prio < BUS_PRIOS && job == NULL; prio++) {
+			job = q->head[prio];
+			if (job != NULL) {
+				q->head[prio] = job->next;
+				if (q->head[prio] == NULL) {
+					q->tail[prio] = NULL;
+				}
+			}
+		}
+		if (job == NULL) {
+			return;
+		}
+		q->depth--;
+		if (Bus_Down(bus)) {
+			stats[bus].skipped++;
+			BusDone(bus, job, HAL_ERROR);
+			continue;
+		}
+		q->active = job;
+		job->state = BUS_JOB_ACTIVE;
+		job->attempts = 0;
+		q->startCycles = DWT->CYCCNT;
+		BusAttemptStart(bus);
+	}
+}
+
+static void BusComplete(Bus_Id_t bus, HAL_StatusTypeDef status) {
+	BusQueue_t* q = &queues[bus];
+	Bus_Stats_t* s = &stats[bus];
+	Bus_Job_t* job = q->active;
+
+	q->active = NULL;
+	s->transfers++;
+	if (status == HAL_OK) {
+		s->bytes += job->len;
+	}
+	s->lastUs = BusCyclesToUs(DWT->CYCCNT - q->startCycles);
+	s->totalUs += s->lastUs;
+	if (s->lastUs > s->maxUs) {
+		s->maxUs = s->lastUs;
+	}
+	if (status == HAL_OK) {
+		q->failRun = 0;
+		q->down = false;
+	}
+	else {
+		s->failures++;
+		if (q->failRun < BUS_FAIL_LIMIT) {
+			q->failRun++;
+		}
+		if (q->failRun >= BUS_FAIL_LIMIT) {
+			q->down = true;
+			q->downTick = HAL_GetTick();
+		}
+	}
+	BusDone(bus, job, status);
+	BusNext(bus);
+}
+
+// A finished transfer chains the next job straight away; a failed one is
+// left to Bus_Task, since the recovery bit-bangs the pins with delays
+static void BusCallback(I2C_HandleTypeDef* hi2c, bool ok) {
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++) {
+		BusQueue_t* q = &queues[bus];
+
+		if (buses[bus].hi2c != hi2c) {
+			continue;
+		}
+		// Bus_Task may already have given up on it
+		if (q->active == NULL || q->attempt != BUS_ATTEMPT_RUNNING) {
+			return;
+		}
+		if (ok) {
+			BusComplete(bus, HAL_OK);
+		}
+		else {
+			q->error = HAL_I2C_GetError(hi2c);
+			q->attempt = BUS_ATTEMPT_FAILED;
+		}
+		return;
+	}
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef* hi2c) {
+	BusCallback(hi2c, true);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c) {
+	BusCallback(hi2c, true);
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c) {
+	BusCallback(hi2c, true);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c) {
+	BusCallback(hi2c, false);
+}
+
+// Thread context from here on
+
+static void BusFailed(Bus_Id_t bus) {
+	BusQueue_t* q = &queues[bus];
+	Bus_Stats_t* s = &stats[bus];
+	Bus_Job_t* job = q->active;
+	uint32_t error = q->error;
+
+	if (error & HAL_I2C_ERROR_TIMEOUT) {
+		s->timeouts++;
+	}
+	else if (error == HAL_I2C_ERROR_AF) {
+		s->nacks++;
+	}
+	else {
+		s->busErrors++;
+	}
+	// Masked so the HAL's interrupt handler cannot run on into the recovery.
+	// After a NACK the HAL has sent the STOP itself.
+	BusLock(bus);
+	if (error != HAL_I2C_ERROR_AF) {
+		// A bus that times out or garbles at this rate gets a slower one to retry at
+		if (Speed_Below(speeds[bus].hz) != 0) {
+			speeds[bus].ceilingHz = Speed_Below(speeds[bus].hz);
+			s->fallbacks++;
+			BusApplySpeed(bus);
+		}
+		Bus_Recover(bus);
+	}
+	if (job->attempts < BUS_RETRIES) {
+		q->startTick = HAL_GetTick() + (BUS_BACKOFF_MS << job->attempts);
+		q->attempt = BUS_ATTEMPT_BACKOFF;
+		job->attempts++;
+		s->retries++;
+	}
+	else {
+		BusComplete(bus, (error & HAL_I2C_ERROR_TIMEOUT) ? HAL_TIMEOUT : HAL_ERROR);
+	}
+	BusUnlock(bus);
+}
+
+// Call from the main loop and while waiting: enforces deadlines, recovers
+// and retries failed attempts and runs the done callbacks
+void Bus_Task(void) {
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++) {
+		BusQueue_t* q = &queues[bus];
+		Bus_Job_t* job;
+
+		BusLock(bus);
+		if (q->active != NULL && q->attempt == BUS_ATTEMPT_RUNNING &&
+				HAL_GetTick() - q->startTick > Bus_DeadlineMs(q->active->len)) {
+			q->error = HAL_I2C_ERROR_TIMEOUT;
+			q->attempt = BUS_ATTEMPT_FAILED;
+		}
+		BusUnlock(bus);
+		if (q->active != NULL && q->attempt == BUS_ATTEMPT_FAILED) {
+			BusFailed(bus);
+		}
+		BusLock(bus);
+		if (q->active != NULL && q->attempt == BUS_ATTEMPT_BACKOFF && (int32_t)(HAL_GetTick() - q->startTick) >= 0) {
+			BusAttemptStart(bus);
+		}
+		BusNext(bus);
+		BusUnlock(bus);
+		for (;;) {
+			BusLock(bus);
+			job = q->doneHead;
+			if (job != NULL) {
+				q->doneHead = job->next;
+				if (q->doneHead == NULL) {
+					q->doneTail = NULL;
+				}
+			}
+			BusUnlock(bus);
+			if (job == NULL) {
+				break;
+			}
+			// Done before the callback, which may submit the job again
+			job->state = BUS_JOB_DONE;
+			if (job->done != NULL) {
+				job->done(job);
+			}
+		}
+	}
+}
+
+// Queues a job; false if it is still pending from an earlier submit
+bool Bus_Submit(Bus_Id_t bus, Bus_Prio_t prio, Bus_Job_t* job) {
+	BusQueue_t* q = &queues[bus];
+
+	if (Bus_JobPending(job)) {
+		return false;
+	}
+	job->state = BUS_JOB_QUEUED;
+	job->status = HAL_BUSY;
+	job->next = NULL;
+	BusLock(bus);
+	if (q->tail[prio] != NULL) {
+		q->tail[prio]->next = job;
+	}
+	else {
+		q->head[prio] = job;
+	}
+	q->tail[prio] = job;
+	q->depth++;
+	BusNext(bus);
+	if (q->depth > stats[bus].depthMax) {
+		stats[bus].depthMax = q->depth;
+	}
+	BusUnlock(bus);
+	return true;
+}
+
+bool Bus_JobPending(const Bus_Job_t* job) {
+	return job->state == BUS_JOB_QUEUED || job->state == BUS_JOB_ACTIVE || job->state == BUS_JOB_FINISHED;
+}
+
+// Waits until the job's callback has run and returns how it went
+HAL_StatusTypeDef Bus_Finish(Bus_Job_t* job) {
+	while (Bus_JobPending(job)) {
+		Bus_Task();
+	}
+	return job->status;
+}
+
+HAL_StatusTypeDef Bus_Run(Bus_Id_t bus, Bus_Prio_t prio, Bus_Job_t* job) {
+	if (!Bus_Submit(bus, prio, job)) {
+		return HAL_BUSY;
+	}
+	return Bus_Finish(job);
+}
+
+bool Bus_Idle(Bus_Id_t bus) {
+	const BusQueue_t* q = &queues[bus];
+
+	return q->active == NULL && q->depth == 0 && q->doneHead == NULL;
+}
+
+void Bus_Wait(Bus_Id_t bus) {
+	while (!Bus_Idle(bus)) {
+		Bus_Task();
+	}
+}
+
+// Before anything that stops the buses: a clock change or Stop 2
+void Bus_WaitAll(void) {
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++) {
+		Bus_Wait(bus);
+	}
+}
+
+HAL_StatusTypeDef Bus_Transmit(Bus_Id_t bus, uint16_t addr, const uint8_t* data, uint16_t len) {
+	Bus_Job_t job = {.op = BUS_OP_TX, .addr = addr, .data = (uint8_t*)data, .len = len};
+
+	return Bus_Run(bus, BUS_PRIO_UI, &job);
+}
+
+HAL_StatusTypeDef Bus_Receive(Bus_Id_t bus, uint16_t addr, uint8_t* data, uint16_t len) {
+	Bus_Job_t job = {.op = BUS_OP_RX, .addr = addr, .data = data, .len = len};
+
+	return Bus_Run(bus, BUS_PRIO_UI, &job);
+}
+
+// Register write: the register byte, then data, in one transfer
+HAL_StatusTypeDef Bus_MemWrite(Bus_Id_t bus, uint16_t addr, uint8_t reg, const uint8_t* data, uint16_t len) {
+	Bus_Job_t job = {.op = BUS_OP_MEM, .addr = addr, .reg = reg, .data = (uint8_t*)data, .len = len};
+
+	return Bus_Run(bus, BUS_PRIO_UI, &job);
+}
+
+// Asks for hz, one of the SPEED_x_HZ rates, and checks that the device at
+// probeAddr answers, stepping down a rate at a time until it does. If it
+// answers at none the device is missing rather than too slow, and the bus
+// stays at hz. Returns the SCL rate in use.
+uint32_t Bus_SetSpeed(Bus_Id_t bus, uint32_t hz, uint16_t probeAddr) {
+	I2C_HandleTypeDef* hi2c = buses[bus].hi2c;
+	uint32_t rate = hz;
+	uint8_t steps = 0;
+
+	Bus_Wait(bus);
+	BusLock(bus);
+	for (;;) {
+		speeds[bus].ceilingHz = rate;
+		BusApplySpeed(bus);
+		if (HAL_I2C_IsDeviceReady(hi2c, probeAddr, 2, 2) == HAL_OK) {
+			stats[bus].fallbacks += steps;
+			break;
+		}
+		// The HAL reports a NACK and a hung bus alike here
+		Bus_Recover(bus);
+		rate = Speed_Below(speeds[bus].hz);
+		if (rate == 0) {
+			speeds[bus].ceilingHz = hz;
+			BusApplySpeed(bus);
+			break;
+		}
+		steps++;
+	}
+	BusUnlock(bus);
+	return Bus_GetSpeed(bus);
+}
+
+// PCLK1 changed: re-times both buses, which must be idle
+void Bus_ClockChanged(void) {
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++) {
+		BusApplySpeed(bus);
+	}
+}
+
+// The SCL rate a bus runs at, as timed; 0 if it has none
+uint32_t Bus_GetSpeed(Bus_Id_t bus) {
+	return (speeds[bus].hz != 0) ? speeds[bus].actualHz : 0;
+}
+
+// True while jobs are being failed unsent after repeated failures
+bool Bus_Down(Bus_Id_t bus) {
+	return queues[bus].down && HAL_GetTick() - queues[bus].downTick < BUS_HOLDOFF_MS;
+}
+
+const Bus_Stats_t* Bus_GetStats(Bus_Id_t bus) {
+	return &stats[bus];
+}
+
+void Bus_ResetStats(void) {
+	memset(stats, 0, sizeof(stats));
+}
+
+void Bus_EvIRQHandler(Bus_Id_t bus) {
+	HAL_I2C_EV_IRQHandler(buses[bus].hi2c);
+}
+
+void Bus_ErIRQHandler(Bus_Id_t bus) {
+	HAL_I2C_ER_IRQHandler(buses[bus].hi2c);
+}
+
+void Bus_DmaIRQHandler(void) {
+	HAL_DMA_IRQHandler(&hdmaOledTx);
+}
@@ -0,0 +1,103 @@
+/*
+ * i2c_speed.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <stddef.h>
+#include "i2c_speed.h"
+
+// TIMINGR fields
+#define SPEED_PRESC_POS         28
+#define SPEED_SCLDEL_POS        20
+#define SPEED_SDADEL_POS        16
+#define SPEED_SCLH_POS          8
+#define SPEED_DEL_MAX           15
+#define SPEED_SCL_MAX           256     // SCLL and SCLH + 1
+
+typedef struct {
+	uint32_t hz;
+	uint32_t lowNs;                 // tLOW min
+	uint32_t highNs;                // tHIGH min
+	uint32_t suDatNs;               // tSU;DAT min
+	uint32_t vdDatNs;               // tVD;DAT max
+} SpeedMode_t;
+
+// I2C-bus specification UM10204, table 10
+static const SpeedMode_t modes[] = {
+	{SPEED_STANDARD_HZ, 4700, 4000, 250, 3450},
+	{SPEED_FAST_HZ, 1300, 600, 100, 900},
+	{SPEED_FAST_PLUS_HZ, 500, 260, 50, 450}
+};
+
+static uint32_t SpeedCeil(uint32_t a, uint32_t b) {
+	return (a + b - 1) / b;
+}
+
+// Computes TIMINGR for sclHz, one of the SPEED_x_HZ rates, from a kernel
+// clock of clkHz; actualHz gets the rate it works out to, at most sclHz.
+// Times are in picoseconds. Returns false if no prescaler fits.
+bool Speed_Timing(uint32_t clkHz, uint32_t sclHz, uint32_t* timing, uint32_t* actualHz) {
+	const SpeedMode_t* m = NULL;
+	uint32_t clkPs;
+	uint32_t periodPs;
+	uint32_t syncPs;
+	int32_t sdadelMinPs;
+	int32_t sdadelMaxPs;
+
+	for (uint8_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+		if (modes[i].hz == sclHz) {
+			m = &modes[i];
+		}
+	}
+	if (m == NULL || clkHz == 0) {
+		return false;
+	}
+	clkPs = (uint32_t)(1000000000000ull / clkHz);
+	periodPs = (uint32_t)(1000000000000ull / sclHz);
+	// Each SCL edge is seen after the rise or fall, the filter and two kernel clocks
+	syncPs = (SPEED_RISE_NS + SPEED_FALL_NS) * 1000u + 2 * (SPEED_AF_MIN_NS * 1000u + 2 * clkPs);
+	// SDADEL window: hold time (0 min) after the fall, data valid before tVD;DAT
+	sdadelMinPs = (int32_t)(SPEED_FALL_NS * 1000u) - (int32_t)(SPEED_AF_MIN_NS * 1000u) - 3 * (int32_t)clkPs;
+	sdadelMaxPs = (int32_t)(m->vdDatNs * 1000u) - (int32_t)(SPEED_RISE_NS * 1000u) -
+			(int32_t)(SPEED_AF_MAX_NS * 1000u) - 4 * (int32_t)clkPs;
+	if (sdadelMaxPs < 0) {
+		return false;
+	}
+	for (uint32_t presc = 0; presc < 16; presc++) {
+		uint32_t prescPs = (presc + 1) * clkPs;
+		uint32_t low = SpeedCeil(m->lowNs * 1000u, prescPs);
+		uint32_t high = SpeedCeil(m->highNs * 1000u, prescPs);
+		uint32_t sdadel = (sdadelMinPs > 0) ? SpeedCeil((uint32_t)sdadelMinPs, prescPs) : 0;
+		uint32_t scldel = SpeedCeil((SPEED_RISE_NS + m->suDatNs) * 1000u, prescPs);
+		uint32_t total;
+
+		scldel = (scldel > 0) ? scldel - 1 : 0;
+		if (sdadel > SPEED_DEL_MAX || sdadel * prescPs > (uint32_t)sdadelMaxPs || scldel > SPEED_DEL_MAX ||
+				low + high > 2 * SPEED_SCL_MAX) {
+			continue;
+		}
+		total = (periodPs > syncPs) ? SpeedCeil(periodPs - syncPs, prescPs) : 0;
+		if (total > low + high) {
+			uint32_t extra = total - low - high;
+			uint32_t extraLow = extra * m->lowNs / (m->lowNs + m->highNs);
+
+			low += extraLow;
+			high += extra - extraLow;
+		}
+		if (low > SPEED_SCL_MAX || high > SPEED_SCL_MAX) {
+			continue;
+		}
+		*timing = (presc << SPEED_PRESC_POS) | (scldel << SPEED_SCLDEL_POS) | (sdadel << SPEED_SDADEL_POS) |
+				((high - 1) << SPEED_SCLH_POS) | (low - 1);
+		*actualHz = (uint32_t)(1000000000000ull / (syncPs + (low + high) * prescPs));
+		return true;
+	}
+	return false;
+}
+
+// The next slower rate to fall back to, 0 below standard mode
+uint32_t Speed_Below(uint32_t sclHz) {
+	return (sclHz > SPEED_FAST_HZ) ? SPEED_FAST_HZ : (sclHz > SPEED_STANDARD_HZ) ? SPEED_STANDARD_HZ : 0;
+}
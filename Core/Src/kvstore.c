@@ -0,0 +1,289 @@
+/*
+ * kvstore.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "kvstore.h"
+
+#define KV_PAGE_MAGIC           0x4750564Bu // "KVPG"
+#define KV_RECORD_MAGIC         0x3152564Bu // "KVR1"
+#define KV_HEADER_SIZE          8u
+#define KV_NO_RECORD            0u          // offset 0 is the page header
+
+typedef enum {
+	SPARE_CLEAN,
+	SPARE_DIRTY,
+	SPARE_ERASING
+} KV_SpareState_t;
+
+static const KV_Flash_t* kvFlash;
+static uint8_t kvActive;
+static uint32_t kvSeq;
+static uint32_t kvWrite;                    // offset of the next free double word
+static uint16_t kvIndex[KV_MAX_KEYS];       // offset of the newest record per key
+static KV_SpareState_t kvSpare;
+
+static uint32_t KvRead32(uint8_t page, uint32_t offset) {
+	uint32_t v;
+	memcpy(&v, kvFlash->page[page] + offset, sizeof(v));
+	return v;
+}
+
+static bool KvErased(uint8_t page, uint32_t offset, uint32_t len) {
+	const uint8_t* p = kvFlash->page[page] + offset;
+	while (len--) {
+		if (*p++ != 0xFF) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static uint32_t KvRecordSize(uint8_t len) {
+	return KV_HEADER_SIZE + (((uint32_t)len + 7u) & ~7u);
+}
+
+// CRC-16/CCITT-FALSE over key, len and data
+static uint16_t KvCrc(uint8_t key, uint8_t len, const uint8_t* data) {
+	uint16_t crc = 0xFFFF;
+	uint8_t head[2] = {key, len};
+	int i;
+
+	for (i = 0; i < 2 + len; i++) {
+		crc ^= (uint16_t)((i < 2) ? head[i] : data[i - 2]) << 8;
+		for (int b = 0; b < 8; b++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+static uint64_t KvPack(uint32_t lo, uint32_t hi) {
+	return ((uint64_t)hi << 32) | lo;
+}
+
+// Programs a record at offset on page; header first so a torn write fails its CRC
+static KV_Error_t KvProgramRecord(uint8_t page, uint32_t offset, uint8_t key, const uint8_t* data, uint8_t len) {
+	uint32_t head = key | ((uint32_t)len << 8) | ((uint32_t)KvCrc(key, len, data) << 16);
+	uint32_t done;
+
+	if (kvFlash->program(page, offset, KvPack(head, KV_RECORD_MAGIC)) != 0) {
+		return KV_ERR;
+	}
+	for (done = 0; done < len; done += 8) {
+		uint8_t dw[8];
+		uint32_t n = (len - done < 8) ? len - done : 8;
+		uint64_t v;
+		memset(dw, 0xFF, sizeof(dw));
+		memcpy(dw, data + done, n);
+		memcpy(&v, dw, sizeof(v));
+		if (kvFlash->program(page, offset + KV_HEADER_SIZE + done, v) != 0) {
+			return KV_ERR;
+		}
+	}
+	return KV_OK;
+}
+
+// Walks the active page, rebuilding the index and the write pointer
+static void KvScan(void) {
+	uint32_t off = KV_HEADER_SIZE;
+
+	memset(kvIndex, 0, sizeof(kvIndex));
+	while (off + KV_HEADER_SIZE <= kvFlash->pageSize) {
+		uint32_t head = KvRead32(kvActive, off);
+		uint8_t key = head & 0xFF;
+		uint8_t len = (head >> 8) & 0xFF;
+		uint32_t size = KvRecordSize(len);
+
+		if (head == 0xFFFFFFFFu && KvRead32(kvActive, off + 4) == 0xFFFFFFFFu) {
+			break;
+		}
+		if (KvRead32(kvActive, off + 4) != KV_RECORD_MAGIC || len > KV_MAX_VALUE || off + size > kvFlash->pageSize) {
+			// Unparseable; treat the page as full so the next write compacts it
+			off = kvFlash->pageSize;
+			break;
+		}
+		if (key < KV_MAX_KEYS && (head >> 16) == KvCrc(key, len, kvFlash->page[kvActive] + off + KV_HEADER_SIZE)) {
+			kvIndex[key] = (len != 0) ? off : KV_NO_RECORD;
+		}
+		off += size;
+	}
+	kvWrite = off;
+}
+
+KV_Error_t KV_Init(const KV_Flash_t* flash) {
+	bool valid[2];
+	uint32_t seq[2];
+	uint8_t p;
+
+	kvFlash = flash;
+	for (p = 0; p < 2; p++) {
+		valid[p] = KvRead32(p, 0) == KV_PAGE_MAGIC;
+		seq[p] = KvRead32(p, 4);
+	}
+	if (valid[0] && valid[1]) {
+		kvActive = ((int32_t)(seq[1] - seq[0]) > 0) ? 1 : 0;
+	}
+	else if (valid[0] || valid[1]) {
+		kvActive = valid[1] ? 1 : 0;
+	}
+	else {
+		// Blank or unrecognised flash: format page 0, only ever on first boot
+		kvActive = 0;
+		seq[0] = 1;
+		if (!KvErased(0, 0, flash->pageSize)) {
+			if (flash->eraseStart(0) != 0) {
+				return KV_ERR;
+			}
+			while (flash->eraseBusy()) {
+			}
+		}
+		if (flash->program(0, 0, KvPack(KV_PAGE_MAGIC, seq[0])) != 0) {
+			return KV_ERR;
+		}
+	}
+	kvSeq = seq[kvActive];
+	KvScan();
+	kvSpare = KvErased(kvActive ^ 1, 0, flash->pageSize) ? SPARE_CLEAN : SPARE_DIRTY;
+	return KV_OK;
+}
+
+int KV_Get(uint8_t key, void* value, uint8_t maxLen) {
+	uint32_t off;
+	uint8_t len;
+
+	if (key >= KV_MAX_KEYS || kvIndex[key] == KV_NO_RECORD) {
+		return KV_ERR_NOT_FOUND;
+	}
+	off = kvIndex[key];
+	len = (KvRead32(kvActive, off) >> 8) & 0xFF;
+	if (len > maxLen) {
+		return KV_ERR_PARAM;
+	}
+	memcpy(value, kvFlash->page[kvActive] + off + KV_HEADER_SIZE, len);
+	return len;
+}
+
+// Copies every live record to the spare page and switches to it, with the
+// record for key replaced by value, or dropped when len is 0. The new value
+// goes live with the page switch: nothing is programmed after it, when the
+// old page is already erasing, and a reset in between loses neither value.
+static KV_Error_t KvCompact(uint8_t key, const uint8_t* value, uint8_t len) {
+	uint8_t spare = kvActive ^ 1;
+	uint16_t newIndex[KV_MAX_KEYS];
+	uint32_t off = KV_HEADER_SIZE;
+	uint8_t k;
+
+	if (kvSpare != SPARE_CLEAN) {
+		KV_Task();
+		return KV_ERR_BUSY;
+	}
+	memset(newIndex, 0, sizeof(newIndex));
+	for (k = 0; k < KV_MAX_KEYS; k++) {
+		const uint8_t* data = value;
+		uint8_t n = len;
+		if (k != key) {
+			if (kvIndex[k] == KV_NO_RECORD) {
+				continue;
+			}
+			data = kvFlash->page[kvActive] + kvIndex[k] + KV_HEADER_SIZE;
+			n = (KvRead32(kvActive, kvIndex[k]) >> 8) & 0xFF;
+		}
+		else if (len == 0) {
+			continue;
+		}
+		if (off + KvRecordSize(n) > kvFlash->pageSize) {
+			kvSpare = SPARE_DIRTY;
+			return KV_ERR_FULL;
+		}
+		if (KvProgramRecord(spare, off, k, data, n) != KV_OK) {
+			kvSpare = SPARE_DIRTY;
+			return KV_ERR;
+		}
+		newIndex[k] = off;
+		off += KvRecordSize(n);
+	}
+	// Stamping the header last makes the switch atomic across a reset
+	if (kvFlash->program(spare, 0, KvPack(KV_PAGE_MAGIC, kvSeq + 1)) != 0) {
+		kvSpare = SPARE_DIRTY;
+		return KV_ERR;
+	}
+	kvSeq++;
+	kvActive = spare;
+	kvWrite = off;
+	memcpy(kvIndex, newIndex, sizeof(kvIndex));
+	kvSpare = SPARE_DIRTY;
+	KV_Task();
+	return KV_OK;
+}
+
+KV_Error_t KV_Set(uint8_t key, const void* value, uint8_t len) {
+	uint32_t size = KvRecordSize(len);
+	KV_Error_t err;
+
+	if (kvFlash == NULL || key >= KV_MAX_KEYS || len > KV_MAX_VALUE) {
+		return KV_ERR_PARAM;
+	}
+	if (kvIndex[key] != KV_NO_RECORD) {
+		uint32_t off = kvIndex[key];
+		if (((KvRead32(kvActive, off) >> 8) & 0xFF) == len &&
+				memcmp(kvFlash->page[kvActive] + off + KV_HEADER_SIZE, value, len) == 0) {
+			// Unchanged, save the wear
+			return KV_OK;
+		}
+	}
+	// The flash controller can only run one operation at a time
+	if (kvSpare == SPARE_ERASING && kvFlash->eraseBusy()) {
+		return KV_ERR_BUSY;
+	}
+	if (kvWrite + size > kvFlash->pageSize) {
+		return KvCompact(key, value, len);
+	}
+	err = KvProgramRecord(kvActive, kvWrite, key, value, len);
+	if (err != KV_OK) {
+		// Skip whatever got programmed; the CRC keeps it out of the index
+		kvWrite += size;
+		return err;
+	}
+	kvIndex[key] = (len != 0) ? kvWrite : KV_NO_RECORD;
+	kvWrite += size;
+	return KV_OK;
+}
+
+KV_Error_t KV_Delete(uint8_t key) {
+	if (key >= KV_MAX_KEYS) {
+		return KV_ERR_PARAM;
+	}
+	if (kvIndex[key] == KV_NO_RECORD) {
+		return KV_OK;
+	}
+	return KV_Set(key, NULL, 0);
+}
+
+// Call from the main loop; keeps the spare page erased in the background
+void KV_Task(void) {
+	if (kvFlash == NULL) {
+		return;
+	}
+	switch (kvSpare) {
+		case SPARE_DIRTY:
+			if (!kvFlash->eraseBusy() && kvFlash->eraseStart(kvActive ^ 1) == 0) {
+				kvSpare = SPARE_ERASING;
+			}
+			break;
+		case SPARE_ERASING:
+			if (!kvFlash->eraseBusy()) {
+				kvSpare = KvErased(kvActive ^ 1, 0, kvFlash->pageSize) ? SPARE_CLEAN : SPARE_DIRTY;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+uint32_t KV_FreeBytes(void) {
+	return kvFlash->pageSize - kvWrite;
+}
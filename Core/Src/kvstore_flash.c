@@ -0,0 +1,74 @@
+/*
+ * kvstore_flash.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "stm32l4xx_hal.h"
+#include "kvstore_flash.h"
+
+static volatile bool eraseBusy = false;
+
+static int KvFlashProgram(uint8_t page, uint32_t offset, uint64_t data) {
+	HAL_StatusTypeDef result;
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+	result = HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, KV_FLASH_BASE + page * FLASH_PAGE_SIZE + offset, data);
+	HAL_FLASH_Lock();
+	return result != HAL_OK;
+}
+
+// Interrupt driven erase; completion arrives through the HAL flash callbacks
+static int KvFlashEraseStart(uint8_t page) {
+	FLASH_EraseInitTypeDef erase = {0};
+
+	erase.TypeErase = FLASH_TYPEERASE_PAGES;
+	erase.Banks = FLASH_BANK_2;
+	erase.Page = KV_FLASH_FIRST_PAGE + page;
+	erase.NbPages = 1;
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_ALL_ERRORS);
+	eraseBusy = true;
+	if (HAL_FLASHEx_Erase_IT(&erase) != HAL_OK) {
+		eraseBusy = false;
+		HAL_FLASH_Lock();
+		return 1;
+	}
+	return 0;
+}
+
+static bool KvFlashEraseBusy(void) {
+	return eraseBusy;
+}
+
+const KV_Flash_t KV_Stm32Flash = {
+	{(const uint8_t*)KV_FLASH_BASE, (const uint8_t*)(KV_FLASH_BASE + FLASH_PAGE_SIZE)},
+	FLASH_PAGE_SIZE,
+	KvFlashProgram,
+	KvFlashEraseStart,
+	KvFlashEraseBusy
+};
+
+void KV_FlashInit(void) {
+	HAL_NVIC_SetPriority(FLASH_IRQn, 3, 0);
+	HAL_NVIC_EnableIRQ(FLASH_IRQn);
+}
+
+void KV_FlashIRQHandler(void) {
+	HAL_FLASH_IRQHandler();
+}
+
+void HAL_FLASH_EndOfOperationCallback(uint32_t ReturnValue) {
+	// Called per page with its number, and with 0xFFFFFFFF once all are done
+	if (ReturnValue == 0xFFFFFFFFu) {
+		eraseBusy = false;
+		HAL_FLASH_Lock();
+	}
+}
+
+void HAL_FLASH_OperationErrorCallback(uint32_t ReturnValue) {
+	eraseBusy = false;
+	HAL_FLASH_Lock();
+}
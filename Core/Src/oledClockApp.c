@@ -1,733 +1,2200 @@
-/*
- * oledClockApp.c
- *
- *  Created on: Apr 5, 2025
- *      Author: dwilk
- */
-
-#include "stdio.h"
-#include "stdlib.h"
-#include "string.h"
-#include "ssd1306.h"
-#include "ssd1306_tests.h"
-#include "ssd1306_fonts.h"
-#include "stdbool.h"
-#include "math.h"
-#include "stm32l4xx_hal.h"
-#include "app.h"
-
-#define TEA5767_I2C_ADDR (0x60 << 1) // 7-bit address shifted for STM32 HAL
-#define TEA5767_MUTE  0x80
-#define TEA5767_SCAN  0x40
-#define TEA5767_PLLREF 0x10
-#define TEA5767_HIGHLO 0x08
-
-void DisplayFM(void);
-void DisplayTimeOled(void);
-void TEA5767_SetFrequency(float freqMHz, bool mute, bool searchUp, bool searchMode);
-void TEA5767_Status(void);
-void DisplayAlarm(void);
-void AlarmProc(void);
-void TimeFace(void);
-char* GetOrdinalSuffix(int number);
-
-extern RTC_HandleTypeDef hrtc;
-extern I2C_HandleTypeDef hi2c2;
-extern TIM_HandleTypeDef htim2;
-extern TIM_HandleTypeDef htim3;
-
-static int32_t lastEncoderValue = 0;
-static int lastEncoder = 0;
-
-volatile int button = 0;
-volatile int buttonCounter = 0;
-volatile int buttonPressed = 0;
-volatile int menuSelect = 0;
-volatile int elementSelect = 0;
-volatile int editElement = 0;
-volatile int flagA = 0;
-int elementInc = 0;
-bool muteS = false;
-bool wasA;
-
-float readFreq = 0;
-int freqI = 0;
-int scanFlag = 0;
-float lastScan = 0;
-int adcLevel = 0;
-float setFreq = 0;
-int setFreqS = 0;
-
-const char* weekdays[] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
-const char* months[] = {"January","February","March","April","May","June","July","August","September","October","November","December"};
-RTC_TimeTypeDef sTime = {0};
-RTC_DateTypeDef sDate = {0};
-RTC_AlarmTypeDef sAlarmA = {0};
-RTC_AlarmTypeDef sAlarmB = {0};
-HAL_StatusTypeDef result = {1};
-
-void App_Init(void) {
-	ssd1306_Init();
-	HAL_RTC_Init(&hrtc);
-	HAL_TIM_Base_Start_IT(&htim3);
-
-	sTime.Hours = 21;   // 12-hour format
-	sTime.Minutes = 24;
-	sTime.Seconds = 0;
-	sTime.TimeFormat = RTC_HOURFORMAT_24; // 24-hour format
-
-	sDate.WeekDay = RTC_WEEKDAY_MONDAY;
-	sDate.Month = RTC_MONTH_APRIL;
-	sDate.Date = 5;
-	sDate.Year = 25;    // Year 2025
-
-    HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
-    HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-
-    HAL_TIM_Encoder_Start(&htim2, TIM_CHANNEL_ALL);
-
-
-    TEA5767_SetFrequency(88.1, true, false, false);
-    TEA5767_Status();
-}
-
-void App_MainLoop(void) {
-
-	int32_t currentEncoderValue = __HAL_TIM_GET_COUNTER(&htim2);
-	int32_t diff = (int16_t)(currentEncoderValue - lastEncoderValue);
-	if (diff > 1) {
-	    // Clockwise rotation
-		__HAL_TIM_SET_COUNTER(&htim3, __HAL_TIM_GET_AUTORELOAD(&htim3));
-	    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_5, GPIO_PIN_SET);  // Turn LED on
-	    if (editElement == 0){
-	    	elementSelect--;
-	    }
-	    else if (editElement != 0){
-	    	elementInc = -1;
-	    }
-	}
-	else if (diff < -1) {
-	    // Counter-clockwise rotation
-		__HAL_TIM_SET_COUNTER(&htim3, __HAL_TIM_GET_AUTORELOAD(&htim3));
-	    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_5, GPIO_PIN_RESET);  // Turn LED off
-	    if (editElement == 0){
-	    	elementSelect++;
-	    }
-	    else if (editElement != 0){
-	       	elementInc = 1;
-	    }
-	}
-	lastEncoderValue = currentEncoderValue;
-	lastEncoder = lastEncoderValue;
-	switch(menuSelect){
-		case 0:{
-			DisplayTimeOled();
-			break;
-		}
-		case 1:{
-			DisplayFM();
-			break;
-		}
-		case 2:{
-			DisplayAlarm();
-			break;
-		}
-		case 3:{
-			menuSelect = 0;
-			break;
-		}
-		case 4:{
-			AlarmProc();
-			break;
-		}
-		case 5:{
-			if (wasA){
-				TEA5767_SetFrequency(readFreq, true, false, false);
-			}
-			else {
-				TEA5767_SetFrequency(readFreq, false, false, false);
-			}
-			wasA = false;
-			menuSelect = 6;
-			break;
-		}
-		case 6:{
-			TimeFace();
-			break;
-		}
-		case 7:{
-			HAL_TIM_Base_Start(&htim3);
-			menuSelect =  0;
-		}
-	}
-}
-
-void TEA5767_SetFrequency(float freqMHz, bool mute, bool searchUp, bool searchMode)
-{
-    uint8_t txbuf[5] = {0};
-    uint16_t pll;
-    float IF = 0.225;
-    muteS = mute;
-    pll = (uint16_t)(((freqMHz + IF) * 1000000) / 8192);
-    // Byte 1: High 6 bits of PLL, bits 7-6 = 00
-    txbuf[0] = ((pll >> 8) & 0x3F); // Ensure 01xxxxxx pattern
-    if (mute) {
-        txbuf[0] |= 0x80;
-    }
-    if(searchMode){
-    	txbuf[0] |= 0x40;
-    }
-    // Byte 2: Low 8 bits of PLL
-    txbuf[1] = pll & 0xFF;
-    // Byte 3: 10111000 — PLLREF (0x80) | HIGHLO (0x10) | SUD (0x20) | MUTE (0x80 if mute in byte 0 only)
-    txbuf[2] = 0x38;
-    if (searchUp){
-    	txbuf[2] |= 0x80;
-    }
-    // Byte 4: 00010000 — HCC = 1
-    txbuf[3] = 0x14;
-
-    // Byte 5: 01000000 — DTC = 1 (75us)
-    txbuf[4] = 0x40;
-    result = HAL_I2C_Master_Transmit(&hi2c2, TEA5767_I2C_ADDR, txbuf, 5, HAL_MAX_DELAY);
-}
-
-void TEA5767_Status(void){
-	uint8_t rxbuf[5];
-
-	result = HAL_I2C_Master_Receive(&hi2c2, TEA5767_I2C_ADDR | 0x01, rxbuf, 5, HAL_MAX_DELAY);
-	uint16_t pll = ((rxbuf[0] & 0x3F) << 8) | rxbuf[1];
-	float IF = 0.225; // Intermediate Frequency in MHz
-	readFreq = roundf((((float)pll * 8192.0f) / 1000000.0f - IF)*10.0f)/10.0f;
-	freqI = (int)(readFreq * 100);
-	uint8_t signalLevel = (rxbuf[3] & 0xF0) >> 4;
-	adcLevel = signalLevel;
-}
-
-void TimeFace(void){
-	HAL_RTC_GetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
-	HAL_RTC_GetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-	editElement = 0;
-	elementInc = 0;
-	elementSelect = 0;
-	char alarmMenu[20];
-	ssd1306_Reset();
-	ssd1306_Fill(Black);
-	sprintf(alarmMenu, "20%d", sDate.Year);
-	ssd1306_SetCursor(95, 0);
-	ssd1306_WriteString(alarmMenu, Font_7x10, White);
-	sprintf(alarmMenu, "%02d:%02d", sTime.Hours, sTime.Minutes, sTime.Seconds);
-	ssd1306_SetCursor(24, 16);
-	ssd1306_WriteString(alarmMenu, Font_16x26, White);
-	const char* weekdayStr = weekdays[sDate.WeekDay - 1];
-    const char* monthStr = months[sDate.Month -1];
-	sprintf(alarmMenu, "%s, %s %s", weekdayStr, monthStr, GetOrdinalSuffix(sDate.Date));
-	ssd1306_SetCursor(0, 50);
-	ssd1306_WriteString(alarmMenu, Font_7x10, White);
-	ssd1306_UpdateScreen();
-	HAL_SuspendTick();
-	HAL_PWR_EnterSLEEPMode(PWR_LOWPOWERREGULATOR_ON, PWR_SLEEPENTRY_WFI);
-}
-
-char* GetOrdinalSuffix(int number) {
-    static char ordinal[10];
-    if (number % 100 >= 11 && number % 100 <= 13) {
-        sprintf(ordinal, "%dth", number);
-    }
-    else {
-        switch (number % 10) {
-            case 1:
-                sprintf(ordinal, "%dst", number);
-                break;
-            case 2:
-                sprintf(ordinal, "%dnd", number);
-                break;
-            case 3:
-                sprintf(ordinal, "%drd", number);
-                break;
-            default:
-                sprintf(ordinal, "%dth", number);
-                break;
-        }
-    }
-    return ordinal;
-}
-
-void AlarmProc(void){
-	if (flagA != 1){
-		if (muteS){
-			wasA = muteS;
-		}
-		else{
-			wasA = false;
-		}
-		TEA5767_SetFrequency(readFreq, false, false, false);
-	}
-	flagA = 1;
-	editElement = 0;
-	elementInc = 0;
-	elementSelect = 0;
-    static int counter = 0;
-    char alarmMenu[20];
-    ssd1306_Reset();
-    ssd1306_Fill(Black);
-    if (counter % 20 < 10) {
-        sprintf(alarmMenu, "ALARM!!!");
-        ssd1306_SetCursor(0, 20);
-        ssd1306_WriteString(alarmMenu, Font_16x26, White);
-    }
-    else {
-        ssd1306_SetCursor(0, 20);
-        ssd1306_WriteString(alarmMenu, Font_16x26, Black);
-    }
-    ssd1306_UpdateScreen();
-    counter++;
-}
-
-
-void DisplayAlarm(void){
-	char alarmMenu[20];
-	static uint8_t editingHour;
-	static uint8_t editingMinute;
-	static uint8_t editingSecond;
-	HAL_RTC_GetAlarm(&hrtc, &sAlarmA, RTC_ALARM_A, RTC_FORMAT_BIN);
-	HAL_RTC_GetAlarm(&hrtc, &sAlarmB, RTC_ALARM_B, RTC_FORMAT_BIN);
-	ssd1306_Reset();
-	ssd1306_Fill(Black);
-	sprintf(alarmMenu, "Set Alarm:  Next");
-	ssd1306_SetCursor(0, 0);
-	ssd1306_WriteString(alarmMenu, Font_7x10, White);
-	sprintf(alarmMenu, "Alarm 1: %02d:%02d:%02d", sAlarmA.AlarmTime.Hours, sAlarmA.AlarmTime.Minutes, sAlarmA.AlarmTime.Seconds);
-	ssd1306_SetCursor(0, 16);
-	ssd1306_WriteString(alarmMenu, Font_7x10, White);
-	switch (elementSelect) {
-		case -1:{
-			elementSelect = 0;
-			break;
-		}
-		case 0: {
-			sprintf(alarmMenu, "Next");
-			ssd1306_SetCursor(85, 0);
-			ssd1306_WriteString(alarmMenu, Font_7x10, Black);
-			ssd1306_UpdateScreen();
-			editElement = 0;
-			elementInc = 0;
-			break;
-		}
-		case 1:{
-			if (editElement == 0){
-				editingHour = sAlarmA.AlarmTime.Hours;
-				editingMinute = sAlarmA.AlarmTime.Minutes;
-				editingSecond = sAlarmA.AlarmTime.Seconds;
-				sprintf(alarmMenu, "%02d:%02d:%02d", sAlarmA.AlarmTime.Hours, sAlarmA.AlarmTime.Minutes, sAlarmA.AlarmTime.Seconds);
-				ssd1306_SetCursor(63, 16);
-				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
-				ssd1306_UpdateScreen();
-			}
-			else if (editElement == 1){
-				sprintf(alarmMenu, "%02d", editingHour);
-				ssd1306_SetCursor(63, 16);
-				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
-				ssd1306_UpdateScreen();
-				if (elementInc == 1){
-					editingHour = (editingHour + 1) % 24;
-					elementInc = 0;
-				}
-				else if (elementInc == -1) {
-					editingHour = (editingHour == 0) ? 23 : editingHour - 1;
-					elementInc = 0;
-				}
-			}
-			else if (editElement == 2){
-				sAlarmA.AlarmTime.Hours = editingHour;
-				HAL_RTC_SetAlarm_IT(&hrtc, &sAlarmA, RTC_FORMAT_BIN);
-				editElement = 3;
-			}
-			else if (editElement == 3){
-				sprintf(alarmMenu, "%02d", editingMinute);
-				ssd1306_SetCursor(83, 16);
-				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
-				ssd1306_UpdateScreen();
-				if (elementInc == 1) {
-					editingMinute = (editingMinute + 1) % 60;
-					elementInc = 0;
-				}
-				else if (elementInc == -1) {
-					editingMinute = (editingMinute == 0) ? 59 : editingMinute - 1;
-					elementInc = 0;
-				}
-			}
-			else if (editElement == 4){
-				sAlarmA.AlarmTime.Minutes = editingMinute;
-				HAL_RTC_SetAlarm_IT(&hrtc, &sAlarmA, RTC_FORMAT_BIN);
-				editElement = 5;
-			}
-			else if (editElement == 5){
-				sprintf(alarmMenu, "%02d", editingSecond);
-				ssd1306_SetCursor(104, 16);
-				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
-				ssd1306_UpdateScreen();
-				if (elementInc == 1) {
-					editingSecond = (editingSecond + 1) % 60;
-					elementInc = 0;
-				}
-				else if (elementInc == -1) {
-					editingSecond = (editingSecond == 0) ? 59 : editingSecond - 1;
-					elementInc = 0;
-				}
-			}
-			else if (editElement == 6){
-				sAlarmA.AlarmTime.Seconds = editingSecond;
-				HAL_RTC_SetAlarm_IT(&hrtc, &sAlarmA, RTC_FORMAT_BIN);
-				editElement = 0;
-				elementInc = 0;
-			}
-			break;
-		}
-		case 2:{
-			elementSelect = 1;
-			break;
-		}
-	}
-}
-
-void DisplayFM(void){
-	TEA5767_Status();
-	char fmMenu[20];
-	ssd1306_Reset();
-	ssd1306_Fill(Black);
-	sprintf(fmMenu, "FM Radio  %d  Next",adcLevel);
-	ssd1306_SetCursor(0, 0);
-	ssd1306_WriteString(fmMenu, Font_7x10, White);
-	sprintf(fmMenu, "Freq: %d.%02d MHz", freqI / 100, abs(freqI % 100));
-	ssd1306_SetCursor(0, 16);
-	ssd1306_WriteString(fmMenu, Font_7x10, White);
-	sprintf(fmMenu, "scan: up / down");
-	ssd1306_SetCursor(0, 28);
-	ssd1306_WriteString(fmMenu, Font_7x10, White);
-	sprintf(fmMenu, "Toggle: on/off");
-	ssd1306_SetCursor(0, 40);
-	ssd1306_WriteString(fmMenu, Font_7x10, White);
-	switch (elementSelect){
-		case -1:{
-			elementSelect = 0;
-			break;
-		}
-		case 0:{
-			sprintf(fmMenu, "Next");
-			ssd1306_SetCursor(89, 0);
-			ssd1306_WriteString(fmMenu, Font_7x10, Black);
-			ssd1306_UpdateScreen();
-			editElement = 0;
-			elementInc = 0;
-			break;
-		}
-		case 1:{
-			if (editElement == 0){
-			    setFreqS = freqI;
-			}
-			sprintf(fmMenu, " %d.%02d MHz  ", setFreqS / 100, abs(setFreqS % 100));
-			ssd1306_SetCursor(34, 16);
-			ssd1306_WriteString(fmMenu, Font_7x10, Black);
-			ssd1306_UpdateScreen();
-			if(editElement == 1){
-				if (scanFlag == 0){
-					setFreq = readFreq;
-				}
-				scanFlag = 1;
-				if (elementInc == 1){
-					setFreq = roundf((setFreq + .1)*10.0f)/10.0f;
-					setFreqS = (int)(setFreq *100);
-					elementInc = 0;
-				}
-				else if (elementInc == -1){
-					setFreq = roundf((setFreq - .1)*10.0f)/10.0f;
-					setFreqS = (int)(setFreq *100);
-					elementInc = 0;
-				}
-			}
-			else if (editElement > 1){
-				TEA5767_SetFrequency(setFreq, false, false, false);
-				elementInc = 0;
-				editElement = 0;
-				scanFlag = 0;
-			}
-			break;
-		}
-		case 2:{
-			sprintf(fmMenu, " up ");
-			ssd1306_SetCursor(35, 28);
-			ssd1306_WriteString(fmMenu, Font_7x10, Black);
-			ssd1306_UpdateScreen();
-			if (editElement == 1){
-				if (scanFlag == 0){
-					TEA5767_SetFrequency(readFreq+.1, false, true, true);
-				}
-				if (lastScan == readFreq){
-					editElement++;
-				}
-				lastScan = readFreq;
-				scanFlag = 1;
-			}
-			else if (editElement == 2){
-				TEA5767_SetFrequency(readFreq, false, false, false);
-				lastScan = 0;
-				scanFlag = 0;
-				editElement = 0;
-				elementInc = 0;
-			}
-			break;
-		}
-		case 3:{
-			sprintf(fmMenu, " down ");
-			ssd1306_SetCursor(70, 28);
-			ssd1306_WriteString(fmMenu, Font_7x10, Black);
-			ssd1306_UpdateScreen();
-			if (editElement == 1){
-			    if (scanFlag == 0){
-			    	TEA5767_SetFrequency(readFreq-.1, false, false, true);
-			    }
-			    if (lastScan == readFreq){
-			    	editElement++;
-			    }
-			    lastScan = readFreq;
-			    scanFlag = 1;
-			}
-			else if (editElement == 2){
-			    TEA5767_SetFrequency(readFreq, false, false, false);
-			    lastScan = 0;
-			    scanFlag = 0;
-			    editElement = 0;
-			    elementInc = 0;
-			}
-			break;
-		}
-		case 4:{
-			sprintf(fmMenu, "on/off");
-			ssd1306_SetCursor(56, 40);
-			ssd1306_WriteString(fmMenu, Font_7x10, Black);
-			ssd1306_UpdateScreen();
-			if (editElement == 1){
-				if (muteS){
-					TEA5767_SetFrequency(readFreq, false, false, false);
-				}
-				else {
-					TEA5767_SetFrequency(readFreq, true, false, false);
-				}
-				editElement = 2;
-			}
-			else if (editElement == 2){
-				editElement = 0;
-				elementInc = 0;
-			}
-			break;
-		}
-		case 5:{
-			elementSelect = 4;
-			break;
-		}
-	}
-}
-
-void DisplayTimeOled(void) {
-    char timeStr[20];
-    HAL_RTC_GetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
-    HAL_RTC_GetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-    ssd1306_Reset();
-    ssd1306_Fill(Black);
-    // Format the time as a string
-    sprintf(timeStr, "Set Time: Next");
-    ssd1306_SetCursor(0, 0);
-    ssd1306_WriteString(timeStr, Font_7x10, White);
-    sprintf(timeStr, "Time: %02d:%02d:%02d", sTime.Hours, sTime.Minutes, sTime.Seconds);
-    ssd1306_SetCursor(0, 16);
-    ssd1306_WriteString(timeStr, Font_7x10, White);
-
-    sprintf(timeStr, "Date: %02d/%02d/%02d", sDate.Month, sDate.Date, 2000 + sDate.Year);
-    ssd1306_SetCursor(0, 28);
-    ssd1306_WriteString(timeStr, Font_7x10, White);
-
-    const char* weekdayStr = weekdays[sDate.WeekDay - 1];
-
-    sprintf(timeStr, "Weekday: %s",weekdayStr);
-    ssd1306_SetCursor(0, 40);
-    ssd1306_WriteString(timeStr, Font_7x10, White);
-    switch(elementSelect){
-    	case -1:{
-    		elementSelect = 0;
-    		break;
-    	}
-    	case 0:{
-    		sprintf(timeStr, "Next");
-    		ssd1306_SetCursor(70, 0);
-    	    ssd1306_WriteString(timeStr, Font_7x10, Black);
-    	    ssd1306_UpdateScreen();
-    	    editElement = 0;
-    	    elementInc = 0;
-    	    break;
-    	}
-    	case 1:{
-    		if (editElement == 0){
-    			sprintf(timeStr, "%02d:%02d:%02d", sTime.Hours, sTime.Minutes, sTime.Seconds);
-    			ssd1306_SetCursor(42, 16);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    		}
-    		else if (editElement == 1){
-       	    	sprintf(timeStr, "%02d", sTime.Hours);
-       	    	ssd1306_SetCursor(42, 16);
-       	    	ssd1306_WriteString(timeStr, Font_7x10, Black);
-       	    	ssd1306_UpdateScreen();
-       	    	if (elementInc == 1){
-       	    		sTime.Hours = (sTime.Hours + 1) % 24;
-       	   	    	elementInc = 0;
-       	       	}
-       	    	else if (elementInc == -1){
-       	    		sTime.Hours = (sTime.Hours == 0) ? 23 : sTime.Hours - 1;
-       	    		elementInc = 0;
-       	    	}
-       	    	HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
-       	    }
-    		else if (editElement == 2){
-    			sprintf(timeStr, "%02d", sTime.Minutes);
-    			ssd1306_SetCursor(62, 16);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    		   	if (elementInc == 1){
-    		   		sTime.Minutes = (sTime.Minutes + 1) % 60;
-    		   		elementInc = 0;
-    		   	}
-    		    else if (elementInc == -1){
-    		    	sTime.Minutes = (sTime.Minutes == 0) ? 59 : sTime.Minutes - 1;
-    		       	elementInc = 0;
-    		    }
-    		    HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
-    		}
-    		else if (editElement == 3){
-    			sprintf(timeStr, "%02d", sTime.Seconds);
-    			ssd1306_SetCursor(83, 16);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    			if (elementInc == 1){
-    		    	sTime.Seconds = (sTime.Seconds + 1) % 60;
-    		    	elementInc = 0;
-    		    }
-    		    else if (elementInc == -1){
-    		    	sTime.Seconds = (sTime.Seconds == 0) ? 59 : sTime.Seconds - 1;
-    		    	elementInc = 0;
-    		    }
-    		    HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
-    	    }
-    		else if (editElement > 3){
-    			editElement = 0;
-    			elementInc = 0;
-    		}
-    		break;
-    	}
-    	case 2:{
-    		if (editElement == 0){
-    			sprintf(timeStr, "%02d/%02d/%02d", sDate.Month, sDate.Date, 2000 + sDate.Year);
-    			ssd1306_SetCursor(42, 28);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    		}
-    		else if (editElement == 1){
-    			sprintf(timeStr, "%02d", sDate.Month);
-    			ssd1306_SetCursor(42, 28);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    			if (elementInc == 1){
-    				sDate.Month = (sDate.Month % 12) + 1;
-    				elementInc = 0;
-    			}
-    			else if (elementInc == -1){
-    				sDate.Month = (sDate.Month == 1) ? 12 : sDate.Month - 1;
-    				elementInc = 0;
-    			}
-    			HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-    		}
-    		else if (editElement == 2){
-    			sprintf(timeStr, "%02d", sDate.Year);
-    			ssd1306_SetCursor(97, 28);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    			if (elementInc == 1) {
-    				sDate.Year = (sDate.Year + 1) % 100;  // RTC allows 00–99 (i.e., 2000–2099)
-    				elementInc = 0;
-    			}
-    			else if (elementInc == -1) {
-    				sDate.Year = (sDate.Year == 0) ? 99 : sDate.Year - 1;
-    				elementInc = 0;
-    			}
-    			HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-    		}
-    		else if (editElement == 3){
-    			uint8_t daysInMonth[] = { 31,28,31,30,31,30,31,31,30,31,30,31 };
-    			uint16_t fullYear = 2000 + sDate.Year;
-    			if ((sDate.Month == 2) && ((fullYear % 4 == 0 && fullYear % 100 != 0) || (fullYear % 400 == 0))) {
-    			    daysInMonth[1] = 29;
-    			}
-    			sprintf(timeStr, "%02d", sDate.Date);
-    			ssd1306_SetCursor(62, 28);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    			if (elementInc == 1) {
-    			    sDate.Date++;
-    			    if (sDate.Date > daysInMonth[sDate.Month - 1]){
-    			        sDate.Date = 1;
-    			    }
-    			    elementInc = 0;
-    			}
-    			else if (elementInc == -1) {
-    			    if (sDate.Date == 1){
-    			        sDate.Date = daysInMonth[sDate.Month - 1];
-    			    }
-    			    else {
-    			        sDate.Date--;
-    			    }
-    			    elementInc = 0;
-    			}
-    			HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-    		}
-    		else if (editElement > 3){
-    			editElement = 0;
-    			elementInc = 0;
-    		}
-    		break;
-    	}
-    	case 3:{
-    		if (editElement == 0){
-    			sprintf(timeStr, "%s",weekdayStr);
-    			ssd1306_SetCursor(63, 40);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    		}
-    		else if (editElement == 1){
-    			sprintf(timeStr, "%s",weekdayStr);
-    			ssd1306_SetCursor(63, 40);
-    			ssd1306_WriteString(timeStr, Font_7x10, Black);
-    			ssd1306_UpdateScreen();
-    			if (elementInc == 1){
-    				sDate.WeekDay = (sDate.WeekDay % 7) + 1;
-    		    	elementInc = 0;
-    		    }
-    		    else if (elementInc == -1){
-    		    	sDate.WeekDay = (sDate.WeekDay == 1) ? 7 : sDate.WeekDay - 1;
-    		    	elementInc = 0;
-    		    }
-    		    HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
-    		}
-    		else if (editElement > 1){
-    		    editElement = 0;
-    		    elementInc = 0;
-    		}
-    		break;
-    	}
-    	case 4:{
-    		elementSelect = 3;
-    		break;
-    	}
-    }
-}
-
-
+/*
+ * oledClockApp.c
+ *
+ *  Created on: Apr 5, 2025
+ *      Author: dwilk
+ */
+
+#include "string.h"
+#include "ssd1306.h"
+#include "ssd1306_tests.h"
+#include "ssd1306_fonts.h"
+#include "stdbool.h"
+#include "stm32l4xx_hal.h"
+#include "main.h"
+#include "app.h"
+#include "fmt.h"
+#include "tea5767.h"
+#include "tea5767_seek.h"
+#include "tea5767_scan.h"
+#include "kvstore_flash.h"
+#include "alarm_sched.h"
+#include "alarm_session.h"
+#include "calendar.h"
+#include "tz.h"
+#include "rtc_drift.h"
+#include "rtc_time.h"
+#include "clock_gov.h"
+#include "prof.h"
+#include "uart_log.h"
+#include "trace.h"
+#include "console_uart.h"
+#include "shot.h"
+#include "i2c_bus.h"
+#include "i2c_speed.h"
+
+#define FM_START_FREQ 8810 // 88.10 MHz
+
+// Key/value store keys
+#define KEY_FM_FREQ     1
+#define KEY_FM_PRESETS  2
+#define KEY_ALARM_A     3 // single alarm from before the scheduler, read once to migrate
+#define KEY_ALARMS      4
+#define KEY_TZ          5
+#define KEY_FM_BAND     6
+
+// Settings waiting to be written, see SettingsTask
+#define SAVE_FM_FREQ    0x01
+#define SAVE_FM_PRESETS 0x02
+#define SAVE_ALARMS     0x04
+#define SAVE_TZ         0x08
+#define SAVE_FM_BAND    0x10
+#define SAVE_DELAY_MS   2000 // let the encoder settle before touching flash
+#define SAVE_RETRY_MAX_MS 64000 // longest wait after a failed save
+
+// RTC wake-up timer clocked at RTCCLK / 16 = 2048 Hz paces the alarm blink
+#define BLINK_WAKEUP_COUNT  (SESSION_BLINK_MS * 2048 / 1000 - 1)
+
+// Deferred log events, formatted by Log_Task from logFormats
+#define LOG_EV_MENU         0
+#define LOG_EV_SEEK         1
+#define LOG_EV_ALARM        2
+
+// Clock face in Stop 2; MCU supply current from the datasheet, for the estimate FaceLeave logs
+#define FACE_FIELDS         4
+#define FACE_STOP2_NA       1400    // Stop 2 with the RTC on LSE
+#define FACE_FULL_UA        10000   // Run at 80 MHz, range 1
+#define FACE_LOW_UA         450     // Run at 4 MHz MSI, range 2
+
+void DisplayFM(void);
+void DisplayTimeOled(void);
+void RadioTune(uint16_t freq, bool mute, bool searchUp, bool searchMode);
+void RadioMute(bool mute);
+void RadioStatus(void);
+static int RadioBusWrite(const uint8_t regs[TEA5767_REG_COUNT]);
+static int RadioBusRead(uint8_t regs[TEA5767_REG_COUNT]);
+void DisplayAlarm(void);
+void AlarmProc(void);
+void TimeFace(void);
+void FaceField(uint8_t field, uint8_t x, uint8_t y, SSD1306_Font_t font, const char* text);
+void FaceWakeSources(bool on);
+void FaceSleep(void);
+void FaceLeave(void);
+uint32_t ClockNowMs(void);
+void ClockIdle(void);
+void ClockReport(void);
+void UartWrite(const char* text, uint16_t len);
+void SettingsLoad(void);
+void SettingsMark(uint8_t bits);
+void SettingsTask(void);
+void ReportBootTime(void);
+uint32_t RtcNow(void);
+void RtcRead(RTC_TimeTypeDef* time, RTC_DateTypeDef* date);
+uint32_t RtcSeconds(const RTC_DateTypeDef* date, const RTC_TimeTypeDef* time);
+void SetDate(void);
+void ClockChanged(void);
+void ZoneSelect(uint8_t index);
+void RtcStamp(RtcTime_t* now);
+bool TimeFrameDue(void);
+void TimeFrameDone(int select, int edit, bool input);
+void DriftLoad(void);
+void DriftSave(void);
+void DriftApply(void);
+void DriftSessionStart(void);
+void DriftSessionEnd(void);
+void AlarmEdit(uint8_t id, const Sched_Alarm_t* alarm);
+void AlarmsDefault(void);
+static int AlarmProgram(uint32_t due);
+static void AlarmCancel(void);
+void AlarmStop(void);
+static Console_Result_t CmdTime(uint8_t argc, char* argv[]);
+static Console_Result_t CmdDate(uint8_t argc, char* argv[]);
+static Console_Result_t CmdAlarm(uint8_t argc, char* argv[]);
+static Console_Result_t CmdTune(uint8_t argc, char* argv[]);
+static Console_Result_t CmdScan(uint8_t argc, char* argv[]);
+static Console_Result_t CmdBand(uint8_t argc, char* argv[]);
+static Console_Result_t CmdProf(uint8_t argc, char* argv[]);
+static Console_Result_t CmdStats(uint8_t argc, char* argv[]);
+static Console_Result_t CmdShot(uint8_t argc, char* argv[]);
+static Console_Result_t CmdBench(uint8_t argc, char* argv[]);
+static Console_Result_t CmdOledTest(uint8_t argc, char* argv[]);
+
+extern RTC_HandleTypeDef hrtc;
+extern I2C_HandleTypeDef hi2c2;
+extern TIM_HandleTypeDef htim2;
+extern TIM_HandleTypeDef htim3;
+extern UART_HandleTypeDef huart2;
+
+static const Seek_Bus_t radioBus = {RadioBusWrite, RadioBusRead};
+static Seek_Event_t seekEvent;
+static const Sched_Rtc_t alarmRtc = {AlarmProgram, AlarmCancel};
+static volatile bool alarmsFired = false;
+static volatile int alarmRinging = -1;
+static uint8_t alarmSlot = 0;
+static TZ_Zone_t zone;
+static uint8_t zoneIndex = 0;
+static int editingZone;
+static Drift_State_t drift;
+static bool driftSession = false;
+static RtcTime_t driftStart;
+static uint32_t driftStartTick;
+static int frameMenu = -1;
+static bool frameDirty = true;
+static uint32_t frameTick;
+static uint32_t frameWaitMs;
+static int frameSelect;
+static int frameEdit;
+static uint8_t shotPrevious[SSD1306_BUFFER_SIZE];  // last screenshot, the base of the next delta
+static uint8_t shotSeq;
+static bool shotValid = false;
+static char faceText[FACE_FIELDS][24];   // what each face field shows now
+static bool faceFull;
+static RtcTime_t faceWoke;
+static struct {
+	uint32_t wakes;
+	uint32_t stopMs;
+	uint32_t runMs;
+	uint32_t resumeUs;
+	uint32_t resumeMaxUs;
+} faceStats;
+
+static bool bootReported = false;
+static uint8_t settingsDirty = 0;
+static uint32_t settingsDirtyTick = 0;
+static uint32_t settingsDelayMs = SAVE_DELAY_MS;
+
+static int32_t lastEncoderValue = 0;
+static int lastEncoder = 0;
+
+volatile int button = 0;
+volatile int buttonCounter = 0;
+volatile int buttonPressed = 0;
+volatile int menuSelect = 0;
+volatile int elementSelect = 0;
+volatile int editElement = 0;
+volatile int flagA = 0;
+volatile int rtcWarmBoot = 0;
+int elementInc = 0;
+bool muteS = false;
+bool wasA;
+
+uint16_t readFreq = 0; // 10 kHz units
+uint16_t tunedFreq = FM_START_FREQ;
+int scanFlag = 0;
+int adcLevel = 0;
+uint16_t setFreq = 0;
+
+const char* weekdays[] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+const char* months[] = {"January","February","March","April","May","June","July","August","September","October","November","December"};
+RTC_TimeTypeDef sTime = {0};
+RTC_DateTypeDef sDate = {0};
+RTC_AlarmTypeDef sAlarmA = {0};
+
+// Daylight saving rules offered in the time menu, the RTC keeps local time
+#define ZONE_COUNT 7
+const char* zoneNames[ZONE_COUNT] = {"off", "US/Canada", "UK/Ireland", "Central EU", "Eastern EU", "SE Australia", "New Zealand"};
+const char* zoneSpecs[ZONE_COUNT] = {
+	"UTC0",
+	"EST5EDT,M3.2.0,M11.1.0",
+	"GMT0BST,M3.5.0/1,M10.5.0",
+	"CET-1CEST,M3.5.0,M10.5.0/3",
+	"EET-2EEST,M3.5.0/3,M10.5.0/4",
+	"AEST-10AEDT,M10.1.0,M4.1.0/3",
+	"NZST-12NZDT,M9.5.0,M4.1.0/3"
+};
+HAL_StatusTypeDef result = {1};
+
+static const char* const logFormats[] = {
+	"menu %u",
+	"seek %u level %u",
+	"alarm fired, ringing %d"
+};
+
+static const Console_Command_t consoleCommands[] = {
+	{"time", "[hh:mm[:ss]]", CmdTime},
+	{"date", "[yyyy-mm-dd]", CmdDate},
+	{"alarm", "[n [hh:mm[:ss] [daily|weekdays|weekend|once|mon,tue,..] | on | off]]", CmdAlarm},
+	{"tune", "[mhz]", CmdTune},
+	{"scan", "[list]", CmdScan},
+	{"band", "[us|jp]", CmdBand},
+	{"prof", "", CmdProf},
+	{"stats", "", CmdStats},
+	{"shot", "[full]", CmdShot},
+	{"i2cbench", "[frames]", CmdBench},
+	{"oledtest", "fonts1|fonts2|line|rect|fill|invert|circle|arc|polyline", CmdOledTest}
+};
+
+// The library's test screens that draw a single still frame
+static const struct {
+	const char* name;
+	void (*draw)(void);
+} oledTests[] = {
+	{"fonts1", ssd1306_TestFonts1},
+	{"fonts2", ssd1306_TestFonts2},
+	{"line", ssd1306_TestLine},
+	{"rect", ssd1306_TestRectangle},
+	{"fill", ssd1306_TestRectangleFill},
+	{"invert", ssd1306_TestRectangleInvert},
+	{"circle", ssd1306_TestCircle},
+	{"arc", ssd1306_TestArc},
+	{"polyline", ssd1306_TestPolyline}
+};
+
+void App_Init(void) {
+	Prof_Init();
+	Trace_Init();
+	Bus_Init();
+	// The OLED can take Fast-mode Plus; the TEA5767 is only rated to 400 kHz
+	Bus_SetSpeed(BUS_OLED, SPEED_FAST_PLUS_HZ, SSD1306_I2C_ADDR);
+	Bus_SetSpeed(BUS_RADIO, SPEED_FAST_HZ, TEA5767_I2C_ADDR);
+	Log_Init(logFormats, sizeof(logFormats) / sizeof(logFormats[0]));
+	Console_UartInit(consoleCommands, sizeof(consoleCommands) / sizeof(consoleCommands[0]));
+	ssd1306_Init();
+	HAL_TIM_Base_Start_IT(&htim3);
+
+	// MX_RTC_Init leaves a calendar that survived the reset alone
+	if (!rtcWarmBoot){
+		sTime.Hours = 21;
+		sTime.Minutes = 24;
+		sTime.Seconds = 0;
+		sTime.TimeFormat = RTC_HOURFORMAT_24; // 24-hour format
+
+		sDate.Month = RTC_MONTH_APRIL;
+		sDate.Date = 5;
+		sDate.Year = 25;    // Year 2025
+		sDate.WeekDay = Cal_Weekday(sDate.Year, sDate.Month, sDate.Date);
+
+		HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
+		HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
+	}
+
+    HAL_TIM_Encoder_Start(&htim2, TIM_CHANNEL_ALL);
+
+
+    Seek_Init(&radioBus, SEEK_POLL_MS, SEEK_TIMEOUT_MS);
+    Scan_Init(&radioBus);
+    Sched_Init(&alarmRtc);
+    DriftLoad();
+    Clock_Init(ClockNowMs);
+    TZ_Parse(zoneSpecs[zoneIndex], &zone);
+    SettingsLoad();
+    if (rtcWarmBoot){
+    	// A change the RTC ran through while the CPU was off is applied on the next minute
+    	TZ_Sync(&zone, RtcNow(), HAL_RTC_DST_ReadStoreOperation(&hrtc) != 0);
+    }
+    else {
+    	ClockChanged();
+    }
+    RadioTune(tunedFreq, true, false, false);
+    RadioStatus();
+}
+
+void App_MainLoop(void) {
+
+	int32_t currentEncoderValue = __HAL_TIM_GET_COUNTER(&htim2);
+	int32_t diff = (int16_t)(currentEncoderValue - lastEncoderValue);
+	if (diff > 1) {
+	    // Clockwise rotation
+		__HAL_TIM_SET_COUNTER(&htim3, __HAL_TIM_GET_AUTORELOAD(&htim3));
+	    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_5, GPIO_PIN_SET);  // Turn LED on
+	    if (editElement == 0){
+	    	elementSelect--;
+	    }
+	    else if (editElement != 0){
+	    	elementInc = -1;
+	    }
+	}
+	else if (diff < -1) {
+	    // Counter-clockwise rotation
+		__HAL_TIM_SET_COUNTER(&htim3, __HAL_TIM_GET_AUTORELOAD(&htim3));
+	    HAL_GPIO_WritePin(GPIOA, GPIO_PIN_5, GPIO_PIN_RESET);  // Turn LED off
+	    if (editElement == 0){
+	    	elementSelect++;
+	    }
+	    else if (editElement != 0){
+	       	elementInc = 1;
+	    }
+	}
+	if (diff > 1 || diff < -1){
+		Trace_Event(TRACE_ENCODER, diff);
+	}
+	lastEncoderValue = currentEncoderValue;
+	lastEncoder = lastEncoderValue;
+	if (Seek_Poll(HAL_GetTick(), &seekEvent)){
+		Log_Event(LOG_EV_SEEK, seekEvent.freq, seekEvent.level, 0);
+		if (Scan_Busy()){
+			if (Scan_SeekDone(&seekEvent, HAL_GetTick())){
+				SettingsMark(SAVE_FM_PRESETS);
+			}
+		}
+		else if (seekEvent.type == SEEK_EVT_ERROR){
+			// The chip may still be searching; the face shows the failure
+			result = HAL_ERROR;
+		}
+		else {
+			readFreq = seekEvent.freq;
+			adcLevel = seekEvent.level;
+			tunedFreq = seekEvent.freq;
+			SettingsMark(SAVE_FM_FREQ);
+		}
+		// A mute asked for during the search, once the chip is out of search
+		// mode; if muteS is unchanged the write is skipped
+		if (!Seek_Busy() && !(TEA5767_GetCache()->regs[0] & TEA5767_SM)){
+			RadioMute(muteS);
+		}
+	}
+	if (driftSession && menuSelect != 0){
+		DriftSessionEnd();
+	}
+	if (alarmsFired){
+		alarmsFired = false;
+		Log_Event(LOG_EV_ALARM, alarmRinging, 0, 0);
+		SettingsMark(SAVE_ALARMS);
+	}
+	if (!Sched_Armed()){
+		// The RTC was busy when the interrupt tried to arm the next alarm
+		HAL_NVIC_DisableIRQ(RTC_Alarm_IRQn);
+		Sched_Arm();
+		HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+	}
+	SettingsTask();
+	Bus_Task();
+	Log_Task();
+	Console_UartTask();
+	if (menuSelect != frameMenu){
+		// A screen always draws as soon as it is entered
+		if (frameMenu == 6){
+			FaceLeave();
+		}
+		else if (menuSelect == 6){
+			ClockReport();
+		}
+		Trace_Event(TRACE_MENU, ((frameMenu & 0xFF) << 8) | menuSelect);
+		frameMenu = menuSelect;
+		frameDirty = true;
+		Log_Event(LOG_EV_MENU, menuSelect, 0, 0);
+	}
+	switch(menuSelect){
+		case 0:{
+			DisplayTimeOled();
+			break;
+		}
+		case 1:{
+			Clock_Set(CLOCK_FULL);
+			PROF_BEGIN(PROF_MENU_FM);
+			DisplayFM();
+			PROF_END(PROF_MENU_FM);
+			break;
+		}
+		case 2:{
+			Clock_Set(CLOCK_FULL);
+			PROF_BEGIN(PROF_MENU_ALARM);
+			DisplayAlarm();
+			PROF_END(PROF_MENU_ALARM);
+			break;
+		}
+		case 3:{
+			menuSelect = 0;
+			break;
+		}
+		case 4:{
+			AlarmProc();
+			break;
+		}
+		case 5:{
+			AlarmStop();
+			if (wasA){
+				RadioMute(true);
+			}
+			else {
+				RadioMute(false);
+			}
+			wasA = false;
+			menuSelect = 6;
+			break;
+		}
+		case 6:{
+			TimeFace();
+			break;
+		}
+		case 7:{
+			HAL_TIM_Base_Start(&htim3);
+			menuSelect =  0;
+		}
+	}
+	if (!bootReported){
+		ReportBootTime();
+		bootReported = true;
+	}
+}
+
+void RadioTune(uint16_t freq, bool mute, bool searchUp, bool searchMode){
+	muteS = mute;
+	result = TEA5767_SetFrequency(freq, mute, searchUp, searchMode);
+	if (!searchMode && freq != tunedFreq){
+		tunedFreq = freq;
+		SettingsMark(SAVE_FM_FREQ);
+	}
+}
+
+// Time from reset to the first rendered frame, once over USART2
+void ReportBootTime(void){
+	char msg[32];
+	char* p;
+
+	p = Fmt_Str(msg, "boot: ");
+	p = Fmt_UDec(p, HAL_GetTick());
+	p = Fmt_Str(p, rtcWarmBoot ? " ms, rtc kept\r\n" : " ms, rtc set\r\n");
+	UartWrite(msg, p - msg);
+}
+
+void SettingsLoad(void){
+	uint16_t freq;
+	uint8_t index;
+	uint8_t band;
+	Scan_Station_t stations[SCAN_MAX_STATIONS];
+	Sched_Alarm_t alarms[SCHED_MAX_ALARMS];
+	int len;
+
+	KV_FlashInit();
+	if (KV_Init(&KV_Stm32Flash) != KV_OK){
+		AlarmsDefault();
+		return;
+	}
+	// The band first: it decides which frequencies are in range
+	if (KV_Get(KEY_FM_BAND, &band, sizeof(band)) == sizeof(band)){
+		TEA5767_SetBandJapan(band != 0);
+	}
+	if (KV_Get(KEY_FM_FREQ, &freq, sizeof(freq)) == sizeof(freq)){
+		tunedFreq = TEA5767_ClampFreq(freq);
+	}
+	if (KV_Get(KEY_TZ, &index, sizeof(index)) == sizeof(index) && index < ZONE_COUNT){
+		zoneIndex = index;
+		TZ_Parse(zoneSpecs[zoneIndex], &zone);
+	}
+	len = KV_Get(KEY_FM_PRESETS, stations, sizeof(stations));
+	if (len > 0){
+		Scan_Load(stations, len / sizeof(Scan_Station_t));
+	}
+	// The schedule lives in RAM, so it is reloaded even when the RTC kept running
+	len = KV_Get(KEY_ALARMS, alarms, sizeof(alarms));
+	if (len > 0){
+		Sched_Load(alarms, len / sizeof(Sched_Alarm_t), RtcNow());
+	}
+	else {
+		AlarmsDefault();
+		SettingsMark(SAVE_ALARMS);
+	}
+}
+
+// Alarm 1 rings daily at the old single alarm time, or at whatever Alarm A holds
+void AlarmsDefault(void){
+	Sched_Alarm_t alarm = {0, 0, 0, SCHED_DAILY, SCHED_ENABLED};
+	uint8_t stored[3];
+
+	if (KV_Get(KEY_ALARM_A, stored, sizeof(stored)) == sizeof(stored)){
+		alarm.hours = stored[0];
+		alarm.minutes = stored[1];
+		alarm.seconds = stored[2];
+	}
+	else if (HAL_RTC_GetAlarm(&hrtc, &sAlarmA, RTC_ALARM_A, RTC_FORMAT_BIN) == HAL_OK){
+		alarm.hours = sAlarmA.AlarmTime.Hours;
+		alarm.minutes = sAlarmA.AlarmTime.Minutes;
+		alarm.seconds = sAlarmA.AlarmTime.Seconds;
+	}
+	Sched_Load(&alarm, 1, RtcNow());
+}
+
+// Seconds since 2000-01-01 from the RTC calendar, safe to call from the alarm interrupt
+uint32_t RtcNow(void){
+	RTC_TimeTypeDef time;
+	RTC_DateTypeDef date;
+
+	RtcRead(&time, &date);
+	return RtcSeconds(&date, &time);
+}
+
+// Reading SSR and TR freezes the date shadow register until DR is read. The
+// alarm interrupt reads the calendar too, and its DR read between our TR and
+// DR reads would let the date move on past the time we hold, so it is held
+// off for the pair unless the caller already masked it.
+void RtcRead(RTC_TimeTypeDef* time, RTC_DateTypeDef* date){
+	bool unmask = NVIC_GetEnableIRQ(RTC_Alarm_IRQn) != 0;
+
+	if (unmask){
+		HAL_NVIC_DisableIRQ(RTC_Alarm_IRQn);
+	}
+	HAL_RTC_GetTime(&hrtc, time, RTC_FORMAT_BIN);
+	HAL_RTC_GetDate(&hrtc, date, RTC_FORMAT_BIN);
+	if (unmask){
+		HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+	}
+}
+
+uint32_t RtcSeconds(const RTC_DateTypeDef* date, const RTC_TimeTypeDef* time){
+	Cal_DateTime_t dt = {date->Year, date->Month, date->Date, date->WeekDay, time->Hours, time->Minutes, time->Seconds};
+
+	return Cal_ToSeconds(&dt);
+}
+
+// Called from the RTC Alarm A interrupt, returns 1 when an alarm should ring
+int App_AlarmDue(void){
+	int id = Sched_Fire(RtcNow());
+
+	Trace_Event(TRACE_ALARM, id);
+	// Skip-next and one-shot flags may have changed, the main loop saves them
+	alarmsFired = true;
+	if (id < 0){
+		return 0;
+	}
+	alarmRinging = id;
+	return 1;
+}
+
+// Replaces one alarm; the RTC interrupt is held off while the heap changes
+void AlarmEdit(uint8_t id, const Sched_Alarm_t* alarm){
+	HAL_NVIC_DisableIRQ(RTC_Alarm_IRQn);
+	Sched_Set(id, alarm, RtcNow());
+	HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+	SettingsMark(SAVE_ALARMS);
+}
+
+// Called from the RTC Alarm B interrupt at the top of every minute
+void App_MinuteTick(void){
+	uint32_t wall = RtcNow();
+
+	switch (TZ_Check(wall)){
+		case TZ_ADD_HOUR:
+			HAL_RTC_DST_Add1Hour(&hrtc);
+			HAL_RTC_DST_SetStoreOperation(&hrtc);
+			wall += 3600;
+			TZ_Sync(&zone, wall, true);
+			break;
+		case TZ_SUB_HOUR:
+			HAL_RTC_DST_Sub1Hour(&hrtc);
+			HAL_RTC_DST_ClearStoreOperation(&hrtc);
+			wall -= 3600;
+			TZ_Sync(&zone, wall, false);
+			break;
+		default:
+			return;
+	}
+	// The shadow registers lag the shift, so the new time comes from wall
+	Sched_Resync(wall);
+}
+
+// The user set the clock to the current local time. The RTC BKP bit
+// records whether that is daylight time, and every due time moves.
+void ClockChanged(void){
+	uint32_t wall = RtcNow();
+	bool dst = TZ_IsDst(&zone, wall, HAL_RTC_DST_ReadStoreOperation(&hrtc) != 0);
+
+	if (dst){
+		HAL_RTC_DST_SetStoreOperation(&hrtc);
+	}
+	else {
+		HAL_RTC_DST_ClearStoreOperation(&hrtc);
+	}
+	HAL_NVIC_DisableIRQ(RTC_Alarm_IRQn);
+	TZ_Sync(&zone, wall, dst);
+	Sched_Resync(wall);
+	HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+}
+
+// RtcNow to the millisecond, from the sub-second counter
+void RtcStamp(RtcTime_t* now){
+	RTC_TimeTypeDef time;
+	RTC_DateTypeDef date;
+
+	RtcRead(&time, &date);
+	RtcTime_Make(now, RtcSeconds(&date, &time), time.SubSeconds, time.SecondFraction);
+}
+
+// The drift estimate lives in the backup domain next to the RTC it describes
+void DriftLoad(void){
+	Drift_Reset(&drift);
+	if (rtcWarmBoot){
+		drift.anchor = HAL_RTCEx_BKUPRead(&hrtc, BKP_DRIFT_ANCHOR_REG);
+		drift.elapsed = HAL_RTCEx_BKUPRead(&hrtc, BKP_DRIFT_ELAPSED_REG);
+		drift.error = (int32_t)HAL_RTCEx_BKUPRead(&hrtc, BKP_DRIFT_ERROR_REG);
+		drift.ppb = (int32_t)HAL_RTCEx_BKUPRead(&hrtc, BKP_DRIFT_PPB_REG);
+	}
+	DriftApply();
+}
+
+void DriftSave(void){
+	HAL_RTCEx_BKUPWrite(&hrtc, BKP_DRIFT_ANCHOR_REG, drift.anchor);
+	HAL_RTCEx_BKUPWrite(&hrtc, BKP_DRIFT_ELAPSED_REG, drift.elapsed);
+	HAL_RTCEx_BKUPWrite(&hrtc, BKP_DRIFT_ERROR_REG, (uint32_t)drift.error);
+	HAL_RTCEx_BKUPWrite(&hrtc, BKP_DRIFT_PPB_REG, (uint32_t)drift.ppb);
+}
+
+void DriftApply(void){
+	bool plus;
+	uint16_t minus;
+
+	Drift_Calr(drift.ppb, &plus, &minus);
+	HAL_RTCEx_SetSmoothCalib(&hrtc, RTC_SMOOTHCALIB_PERIOD_32SEC,
+			plus ? RTC_SMOOTHCALIB_PLUSPULSES_SET : RTC_SMOOTHCALIB_PLUSPULSES_RESET, minus);
+}
+
+// Notes where the RTC was before the user starts editing the clock
+void DriftSessionStart(void){
+	RtcStamp(&driftStart);
+	driftStartTick = HAL_GetTick();
+	driftSession = true;
+}
+
+// Compares the clock the user left with where the RTC would have been
+// without the edits, timing the edit itself with SysTick
+void DriftSessionEnd(void){
+	uint32_t ms = driftStart.ms + (HAL_GetTick() - driftStartTick);
+	RtcTime_t predicted = {driftStart.seconds + ms / 1000, ms % 1000};
+	RtcTime_t now;
+	int64_t correctionMs;
+
+	driftSession = false;
+	RtcStamp(&now);
+	// Not RtcTime_DiffMs, which saturates at 24.8 days: a new date is further
+	correctionMs = ((int64_t)now.seconds - predicted.seconds) * 1000 + now.ms - predicted.ms;
+	if (Drift_Record(&drift, predicted.seconds, correctionMs)){
+		DriftApply();
+	}
+	DriftSave();
+}
+
+// Millisecond clock for the governor's accounting; the RTC keeps running in Stop 2
+uint32_t ClockNowMs(void){
+	RtcTime_t now;
+
+	RtcStamp(&now);
+	return now.seconds * 1000 + now.ms;
+}
+
+// Drops to the low clock point unless the radio is still seeking, or a drift
+// session is timing the edit with SysTick: every switch goes through
+// HAL_InitTick, which drops the partial tick and would bias the estimate
+void ClockIdle(void){
+	if (!Seek_Busy() && !Scan_Busy() && !driftSession){
+		Clock_Set(CLOCK_LOW);
+	}
+}
+
+// Milliseconds as seconds; unsigned, so 25 days at one point stays positive
+static char* FmtSeconds(char* p, uint32_t ms){
+	p = Fmt_UDec(p, ms / 1000);
+	*p++ = '.';
+	return Fmt_UPad(p, ms % 1000, 3);
+}
+
+// Logs the time spent at each clock point since the last report, e.g.
+// "clock: full 12.345 s, low 250.100 s, 41 switches, 38 us max 52"
+void ClockReport(void){
+	const Clock_Stats_t* stats = Clock_GetStats();
+	char msg[100];      // every counter at its longest: 98
+	char* p = msg;
+
+	p = FmtSeconds(Fmt_Str(p, "clock: full "), stats->ms[CLOCK_FULL]);
+	p = FmtSeconds(Fmt_Str(p, " s, low "), stats->ms[CLOCK_LOW]);
+	p = Fmt_UDec(Fmt_Str(p, " s, "), stats->switches[CLOCK_FULL] + stats->switches[CLOCK_LOW]);
+	p = Fmt_UDec(Fmt_Str(p, " switches, "), stats->switchUs);
+	p = Fmt_UDec(Fmt_Str(p, " us max "), stats->switchMaxUs);
+	p = Fmt_Str(p, "\r\n");
+	UartWrite(msg, p - msg);
+	Clock_ResetStats();
+}
+
+// Reports and dumps; these wait for room in the log rather than lose lines
+void UartWrite(const char* text, uint16_t len){
+	Log_WriteWait(text, len);
+}
+
+void ZoneSelect(uint8_t index){
+	zoneIndex = index;
+	TZ_Parse(zoneSpecs[zoneIndex], &zone);
+	ClockChanged();
+	SettingsMark(SAVE_TZ);
+}
+
+// USART2 console commands, see console.h for the line protocol
+
+// "time" prints the clock, "time 21:24" or "time 21:24:05" sets it
+static Console_Result_t CmdTime(uint8_t argc, char* argv[]){
+	RTC_TimeTypeDef time;
+	RTC_DateTypeDef date;
+	uint32_t f[3] = {0, 0, 0};
+	uint8_t n;
+	bool drift;
+	char text[12];
+
+	if (argc > 2){
+		return CONSOLE_ERR_USAGE;
+	}
+	RtcRead(&time, &date);
+	if (argc == 2){
+		n = Console_ParseFields(argv[1], ':', f, 3);
+		if (n < 2){
+			return CONSOLE_ERR_USAGE;
+		}
+		if (f[0] > 23 || f[1] > 59 || f[2] > 59){
+			return CONSOLE_ERR_ARG;
+		}
+		// Only a time given to the second is precise enough to teach the drift estimate
+		drift = n == 3 && !driftSession;
+		if (drift){
+			DriftSessionStart();
+		}
+		time.Hours = f[0];
+		time.Minutes = f[1];
+		time.Seconds = f[2];
+		HAL_RTC_SetTime(&hrtc, &time, RTC_FORMAT_BIN);
+		ClockChanged();
+		if (drift){
+			DriftSessionEnd();
+		}
+		frameDirty = true;
+	}
+	Fmt_Str(Fmt_Time(text, time.Hours, time.Minutes, time.Seconds), "\r\n");
+	Console_Print(text);
+	return CONSOLE_OK;
+}
+
+// "date" prints the date, "date 2025-04-05" sets it
+static Console_Result_t CmdDate(uint8_t argc, char* argv[]){
+	RTC_TimeTypeDef time;
+	RTC_DateTypeDef date;
+	uint32_t f[3];
+	char text[24];
+	char* p;
+
+	if (argc > 2){
+		return CONSOLE_ERR_USAGE;
+	}
+	RtcRead(&time, &date);
+	if (argc == 2){
+		if (Console_ParseFields(argv[1], '-', f, 3) != 3){
+			return CONSOLE_ERR_USAGE;
+		}
+		if (f[0] < 2000 || f[0] > 2099 || f[1] < 1 || f[1] > 12 || f[2] < 1 ||
+				f[2] > Cal_DaysInMonth(f[0] - 2000, f[1])){
+			return CONSOLE_ERR_ARG;
+		}
+		date.Year = f[0] - 2000;
+		date.Month = f[1];
+		date.Date = f[2];
+		date.WeekDay = Cal_Weekday(date.Year, date.Month, date.Date);
+		HAL_RTC_SetDate(&hrtc, &date, RTC_FORMAT_BIN);
+		ClockChanged();
+		frameDirty = true;
+	}
+	p = Fmt_UDec(text, 2000 + date.Year);
+	p = Fmt_U2(Fmt_Char(p, '-'), date.Month);
+	p = Fmt_U2(Fmt_Char(p, '-'), date.Date);
+	Fmt_Str(Fmt_Str(Fmt_Char(p, ' '), weekdays[date.WeekDay - 1]), "\r\n");
+	Console_Print(text);
+	return CONSOLE_OK;
+}
+
+static const char* const dayNames[] = {"mon", "tue", "wed", "thu", "fri", "sat", "sun"};
+
+// "daily", "weekdays", "weekend", "once" or a list like "mon,wed,fri"
+static bool AlarmParseDays(const char* text, uint8_t* days){
+	uint8_t d;
+
+	if (strcmp(text, "daily") == 0){
+		*days = SCHED_DAILY;
+		return true;
+	}
+	if (strcmp(text, "weekdays") == 0){
+		*days = SCHED_WEEKDAYS;
+		return true;
+	}
+	if (strcmp(text, "weekend") == 0){
+		*days = SCHED_WEEKEND;
+		return true;
+	}
+	if (strcmp(text, "once") == 0){
+		*days = 0;
+		return true;
+	}
+	*days = 0;
+	while (*text != '\0'){
+		for (d = 0; d < 7; d++){
+			if (strncmp(text, dayNames[d], 3) == 0 && (text[3] == ',' || text[3] == '\0')){
+				break;
+			}
+		}
+		if (d == 7){
+			return false;
+		}
+		*days |= 1 << d;
+		text += (text[3] == ',') ? 4 : 3;
+	}
+	return *days != 0;
+}
+
+// "2 06:30:00 weekdays on"
+static void AlarmPrint(uint8_t id){
+	const Sched_Alarm_t* alarm = Sched_Get(id);
+	char text[64];
+	char* p;
+	uint8_t d;
+
+	p = Fmt_Char(Fmt_UDec(text, id + 1), ' ');
+	p = Fmt_Char(Fmt_Time(p, alarm->hours, alarm->minutes, alarm->seconds), ' ');
+	switch (alarm->days){
+		case SCHED_DAILY:
+			p = Fmt_Str(p, "daily");
+			break;
+		case SCHED_WEEKDAYS:
+			p = Fmt_Str(p, "weekdays");
+			break;
+		case SCHED_WEEKEND:
+			p = Fmt_Str(p, "weekend");
+			break;
+		case 0:
+			p = Fmt_Str(p, "once");
+			break;
+		default:
+			for (d = 0; d < 7; d++){
+				if (alarm->days & (1 << d)){
+					if (p[-1] != ' '){
+						p = Fmt_Char(p, ',');
+					}
+					p = Fmt_Str(p, dayNames[d]);
+				}
+			}
+			break;
+	}
+	p = Fmt_Str(p, (alarm->flags & SCHED_ENABLED) ? " on" : " off");
+	p = Fmt_Str(p, (alarm->flags & SCHED_SKIP_NEXT) ? ", skip next\r\n" : "\r\n");
+	Console_Print(text);
+}
+
+// "alarm" lists, "alarm 1 06:30 weekdays" sets, "alarm 1 off" disables
+static Console_Result_t CmdAlarm(uint8_t argc, char* argv[]){
+	Sched_Alarm_t alarm;
+	uint32_t id;
+	uint32_t f[3] = {0, 0, 0};
+	uint8_t i;
+
+	if (argc == 1){
+		for (i = 0; i < SCHED_MAX_ALARMS; i++){
+			AlarmPrint(i);
+		}
+		return CONSOLE_OK;
+	}
+	if (argc > 4 || !Console_ParseU(argv[1], &id)){
+		return CONSOLE_ERR_USAGE;
+	}
+	if (id < 1 || id > SCHED_MAX_ALARMS){
+		return CONSOLE_ERR_ARG;
+	}
+	id--;
+	alarm = *Sched_Get(id);
+	if (argc == 3 && strcmp(argv[2], "on") == 0){
+		alarm.flags |= SCHED_ENABLED;
+	}
+	else if (argc == 3 && strcmp(argv[2], "off") == 0){
+		alarm.flags &= ~SCHED_ENABLED;
+	}
+	else if (argc >= 3){
+		if (Console_ParseFields(argv[2], ':', f, 3) < 2){
+			return CONSOLE_ERR_USAGE;
+		}
+		if (f[0] > 23 || f[1] > 59 || f[2] > 59){
+			return CONSOLE_ERR_ARG;
+		}
+		if (argc == 4 && !AlarmParseDays(argv[3], &alarm.days)){
+			return CONSOLE_ERR_ARG;
+		}
+		alarm.hours = f[0];
+		alarm.minutes = f[1];
+		alarm.seconds = f[2];
+		// Setting a time arms the alarm and forgets a skip
+		alarm.flags = SCHED_ENABLED;
+	}
+	if (argc >= 3){
+		AlarmEdit(id, &alarm);
+	}
+	AlarmPrint(id);
+	return CONSOLE_OK;
+}
+
+// "tune" prints the station, "tune 98.1" tunes in MHz
+static Console_Result_t CmdTune(uint8_t argc, char* argv[]){
+	uint32_t freq;
+	char text[32];
+
+	if (argc > 2){
+		return CONSOLE_ERR_USAGE;
+	}
+	if (argc == 2){
+		if (!Console_ParseFixed(argv[1], 2, &freq)){
+			return CONSOLE_ERR_USAGE;
+		}
+		if (freq > 0xFFFF || freq != TEA5767_ClampFreq(freq)){
+			return CONSOLE_ERR_ARG;
+		}
+		if (Seek_Busy() || Scan_Busy()){
+			return CONSOLE_ERR_BUSY;
+		}
+		RadioTune(freq, muteS, false, false);
+		if (result != HAL_OK){
+			return CONSOLE_ERR;
+		}
+	}
+	RadioStatus();
+	Fmt_Str(Fmt_UDec(Fmt_Str(Fmt_Fixed(text, readFreq, 2), " MHz, level "), adcLevel), "\r\n");
+	Console_Print(text);
+	return CONSOLE_OK;
+}
+
+// "scan" sweeps the band for presets in the background, "scan list" shows them
+// and how long the last sweep took
+static Console_Result_t CmdScan(uint8_t argc, char* argv[]){
+	char text[32];
+	uint8_t i;
+
+	if (argc == 2 && strcmp(argv[1], "list") == 0){
+		for (i = 0; i < Scan_Count(); i++){
+			const Scan_Station_t* station = Scan_Station(i);
+			Fmt_Str(Fmt_UDec(Fmt_Str(Fmt_Fixed(text, station->freq, 2), " MHz, level "), station->level),
+					station->stereo ? " stereo\r\n" : "\r\n");
+			Console_Print(text);
+		}
+		Fmt_Str(Fmt_UDec(Fmt_Str(text, "swept in "), Scan_ElapsedMs()), " ms\r\n");
+		Console_Print(text);
+		return CONSOLE_OK;
+	}
+	if (argc != 1){
+		return CONSOLE_ERR_USAGE;
+	}
+	if (Seek_Busy() || Scan_Busy() || !Scan_Start(readFreq, muteS, HAL_GetTick())){
+		return CONSOLE_ERR_BUSY;
+	}
+	return CONSOLE_OK;
+}
+
+// "band" prints the FM band, "band jp" switches to 76-91 MHz and "band us" back
+// to 87.5-108 MHz. The presets belong to the old band and are dropped.
+static Console_Result_t CmdBand(uint8_t argc, char* argv[]){
+	bool japan;
+	char text[32];
+	char* p;
+
+	if (argc > 2){
+		return CONSOLE_ERR_USAGE;
+	}
+	if (argc == 2){
+		if (strcmp(argv[1], "jp") == 0){
+			japan = true;
+		}
+		else if (strcmp(argv[1], "us") == 0){
+			japan = false;
+		}
+		else {
+			return CONSOLE_ERR_USAGE;
+		}
+		if (Seek_Busy() || Scan_Busy()){
+			return CONSOLE_ERR_BUSY;
+		}
+		if (japan != TEA5767_GetBandJapan()){
+			TEA5767_SetBandJapan(japan);
+			Scan_Clear();
+			SettingsMark(SAVE_FM_BAND | SAVE_FM_PRESETS);
+			// Sends the band bit even when the station stays in range
+			RadioTune(TEA5767_ClampFreq(tunedFreq), muteS, false, false);
+			if (result != HAL_OK){
+				return CONSOLE_ERR;
+			}
+		}
+	}
+	japan = TEA5767_GetBandJapan();
+	p = Fmt_Str(text, japan ? "jp " : "us ");
+	p = Fmt_Fixed(p, japan ? TEA5767_FREQ_JP_MIN : TEA5767_FREQ_MIN, 2);
+	p = Fmt_Char(p, '-');
+	p = Fmt_Fixed(p, japan ? TEA5767_FREQ_JP_MAX : TEA5767_FREQ_MAX, 2);
+	Fmt_Str(p, " MHz\r\n");
+	Console_Print(text);
+	return CONSOLE_OK;
+}
+
+// Dumps and clears the profiler counters
+static Console_Result_t CmdProf(uint8_t argc, char* argv[]){
+	if (argc != 1){
+		return CONSOLE_ERR_USAGE;
+	}
+#if PROF_ENABLE
+	Prof_Dump(UartWrite);
+	Prof_Reset();
+#else
+	Console_Print("profiler not in this build\r\n");
+#endif
+	return CONSOLE_OK;
+}
+
+// Transfer counts and latency of one I2C bus; max against the bound for a full OLED page
+static void BusReport(Bus_Id_t bus){
+	const Bus_Stats_t* s = Bus_GetStats(bus);
+	char text[112];     // longest piece, every counter at ten digits: 110
+	char* p;
+
+	p = Fmt_UDec(Fmt_Str(text, (bus == BUS_OLED) ? "i2c oled: " : "i2c radio: "), s->transfers);
+	p = Fmt_UDec(Fmt_Str(p, " transfers, "), s->failures);
+	p = Fmt_UDec(Fmt_Str(p, " failed, "), s->skipped);
+	Fmt_UDec(Fmt_Str(p, " skipped, "), s->nacks);
+	Console_Print(text);
+	p = Fmt_UDec(Fmt_Str(text, " nack, "), s->timeouts);
+	p = Fmt_UDec(Fmt_Str(p, " timeout, "), s->busErrors);
+	p = Fmt_UDec(Fmt_Str(p, " bus err, "), s->retries);
+	p = Fmt_UDec(Fmt_Str(p, " retries, "), s->recoveries);
+	Fmt_Str(Fmt_UDec(Fmt_Str(p, " recoveries ("), s->stuck), " stuck)\r\n");
+	Console_Print(text);
+	p = Fmt_UDec(Fmt_Str(text, "  last "), s->lastUs);
+	p = Fmt_UDec(Fmt_Str(p, " us, max "), s->maxUs);
+	p = Fmt_UDec(Fmt_Str(p, " us, mean "), s->transfers ? (uint32_t)(s->totalUs / s->transfers) : 0);
+	p = Fmt_UDec(Fmt_Str(p, " us, bound "), Bus_WorstCaseMs(SSD1306_WIDTH));
+	p = Fmt_UDec(Fmt_Str(p, " ms, queue peak "), s->depthMax);
+	Fmt_Str(p, "\r\n");
+	Console_Print(text);
+	// Throughput while the bus is working, not over the uptime
+	p = Fmt_UDec(Fmt_Str(text, "  "), Bus_GetSpeed(bus) / 1000);
+	p = Fmt_UDec(Fmt_Str(p, " kHz, "), s->fallbacks);
+	p = Fmt_UDec(Fmt_Str(p, " fallbacks, "), s->bytes);
+	p = Fmt_UDec(Fmt_Str(p, " bytes, "), s->totalUs ? (uint32_t)((uint64_t)s->bytes * 1000000u / s->totalUs) : 0);
+	Fmt_Str(p, " bytes/s\r\n");
+	Console_Print(text);
+}
+
+// Clock governor, logger, radio and I2C bus counters
+static Console_Result_t CmdStats(uint8_t argc, char* argv[]){
+	const Log_Stats_t* log = Log_GetStats();
+	const TEA5767_Stats_t* radio = TEA5767_GetStats();
+	char text[104];     // the radio line, every counter at ten digits: 103
+	char* p;
+
+	if (argc != 1){
+		return CONSOLE_ERR_USAGE;
+	}
+	ClockReport();
+	p = Fmt_UDec(Fmt_Str(text, "log: "), log->bytes);
+	p = Fmt_UDec(Fmt_Str(p, " bytes, "), log->dropped);
+	p = Fmt_UDec(Fmt_Str(p, " dropped, "), log->eventsDropped);
+	p = Fmt_UDec(Fmt_Str(p, " events dropped, peak "), log->peak);
+	Fmt_Str(p, "\r\n");
+	Console_Print(text);
+	p = Fmt_UDec(Fmt_Str(text, "radio: "), radio->writes);
+	p = Fmt_UDec(Fmt_Str(p, " writes, "), radio->writesSkipped);
+	p = Fmt_UDec(Fmt_Str(p, " skipped, "), radio->reads);
+	p = Fmt_UDec(Fmt_Str(p, " reads, "), radio->readsCached);
+	p = Fmt_UDec(Fmt_Str(p, " cached, "), radio->errors);
+	Fmt_Str(p, " errors\r\n");
+	Console_Print(text);
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++){
+		BusReport(bus);
+	}
+	return CONSOLE_OK;
+}
+
+static void ShotWrite(const uint8_t* data, uint16_t len){
+	Log_WriteWait((const char*)data, len);
+}
+
+// Sends the framebuffer as a binary frame, see shot.h; tools/shot_decode.py
+// picks it out of the capture. "shot full" restarts the delta chain.
+static Console_Result_t CmdShot(uint8_t argc, char* argv[]){
+	bool full = argc == 2 && strcmp(argv[1], "full") == 0;
+
+	if (argc > 2 || (argc == 2 && !full)){
+		return CONSOLE_ERR_USAGE;
+	}
+	Shot_Send(ssd1306_GetBuffer(), shotPrevious, SSD1306_WIDTH, SSD1306_HEIGHT, ++shotSeq, shotValid && !full, ShotWrite);
+	shotValid = true;
+	Console_Print("\r\n");
+	return CONSOLE_OK;
+}
+
+// Draws one of the library's test screens on a blank buffer and sends it as a
+// full shot, for tools/shot_decode.py --golden to hold against known-good
+// images. The face draws over it on its next tick.
+static Console_Result_t CmdOledTest(uint8_t argc, char* argv[]){
+	if (argc != 2){
+		return CONSOLE_ERR_USAGE;
+	}
+	for (uint8_t i = 0; i < sizeof(oledTests) / sizeof(oledTests[0]); i++){
+		if (strcmp(argv[1], oledTests[i].name) == 0){
+			ssd1306_Fill(Black);
+			oledTests[i].draw();
+			Shot_Send(ssd1306_GetBuffer(), shotPrevious, SSD1306_WIDTH, SSD1306_HEIGHT, ++shotSeq, false, ShotWrite);
+			shotValid = true;
+			Console_Print("\r\n");
+			return CONSOLE_OK;
+		}
+	}
+	return CONSOLE_ERR_ARG;
+}
+
+// Times frames of a radio status read and a full OLED flush, first one after
+// the other as the blocking calls ran them, then with the read queued on I2C2
+// to run alongside the flush on I2C1. The screen is sent as it is.
+static Console_Result_t CmdBench(uint8_t argc, char* argv[]){
+	Bus_Job_t read = {.op = BUS_OP_RX, .addr = TEA5767_I2C_ADDR | 0x01, .len = TEA5767_REG_COUNT};
+	uint8_t regs[TEA5767_REG_COUNT];
+	uint32_t frames = 20;
+	uint32_t start;
+	uint32_t us[2];
+	char text[80];
+	char* p;
+
+	if (argc > 2 || (argc == 2 && !Console_ParseU(argv[1], &frames))){
+		return CONSOLE_ERR_USAGE;
+	}
+	// The cycle counter wraps after about a minute at 80 MHz
+	if (frames == 0 || frames > 200){
+		return CONSOLE_ERR_ARG;
+	}
+	if (Seek_Busy() || Scan_Busy()){
+		return CONSOLE_ERR_BUSY;
+	}
+	read.data = regs;
+	Bus_WaitAll();
+	for (uint8_t pass = 0; pass < 2; pass++){
+		start = DWT->CYCCNT;
+		for (uint32_t i = 0; i < frames; i++){
+			if (pass == 0){
+				Bus_Run(BUS_RADIO, BUS_PRIO_BACKGROUND, &read);
+				ssd1306_UpdateScreen();
+			}
+			else {
+				Bus_Submit(BUS_RADIO, BUS_PRIO_BACKGROUND, &read);
+				ssd1306_UpdateScreen();
+				Bus_Finish(&read);
+			}
+		}
+		us[pass] = (uint32_t)((uint64_t)(DWT->CYCCNT - start) * 1000000u / SystemCoreClock / frames);
+	}
+	p = Fmt_UDec(Fmt_Str(text, "serial "), us[0]);
+	p = Fmt_UDec(Fmt_Str(p, " us, overlapped "), us[1]);
+	p = Fmt_UDec(Fmt_Str(p, " us per frame, "), frames);
+	Fmt_Str(p, " frames\r\n");
+	Console_Print(text);
+	return CONSOLE_OK;
+}
+
+// Alarm A matches on day of month; the next alarm is never more than a week out
+static int AlarmProgram(uint32_t due){
+	RTC_AlarmTypeDef alarm = {0};
+	Cal_DateTime_t dt;
+
+	Cal_FromSeconds(due, &dt);
+	alarm.AlarmTime.Hours = dt.hours;
+	alarm.AlarmTime.Minutes = dt.minutes;
+	alarm.AlarmTime.Seconds = dt.seconds;
+	alarm.AlarmMask = RTC_ALARMMASK_NONE;
+	alarm.AlarmSubSecondMask = RTC_ALARMSUBSECONDMASK_ALL;
+	alarm.AlarmDateWeekDaySel = RTC_ALARMDATEWEEKDAYSEL_DATE;
+	alarm.AlarmDateWeekDay = dt.date;
+	alarm.Alarm = RTC_ALARM_A;
+	return HAL_RTC_SetAlarm_IT(&hrtc, &alarm, RTC_FORMAT_BIN) != HAL_OK;
+}
+
+static void AlarmCancel(void){
+	HAL_RTC_DeactivateAlarm(&hrtc, RTC_ALARM_A);
+}
+
+void SettingsMark(uint8_t bits){
+	settingsDirty |= bits;
+	settingsDirtyTick = HAL_GetTick();
+}
+
+// Saves one setting if it is marked; false if the store is busy and the rest
+// should wait for the next pass. A failed write keeps its bit for a retry.
+static bool SettingsSave(uint8_t bit, uint8_t key, const void* value, uint8_t len){
+	KV_Error_t err;
+
+	if (!(settingsDirty & bit)){
+		return true;
+	}
+	err = KV_Set(key, value, len);
+	if (err == KV_ERR_BUSY){
+		return false;
+	}
+	if (err == KV_OK){
+		settingsDirty &= ~bit;
+	}
+	return true;
+}
+
+// Writes changed settings once they have been stable for SAVE_DELAY_MS. After
+// a failed write the wait doubles, up to SAVE_RETRY_MAX_MS, until all is saved.
+void SettingsTask(void){
+	uint8_t band = TEA5767_GetBandJapan();
+
+	KV_Task();
+	if (settingsDirty == 0 || HAL_GetTick() - settingsDirtyTick < settingsDelayMs){
+		return;
+	}
+	if (!SettingsSave(SAVE_FM_FREQ, KEY_FM_FREQ, &tunedFreq, sizeof(tunedFreq)) ||
+			!SettingsSave(SAVE_FM_BAND, KEY_FM_BAND, &band, sizeof(band)) ||
+			!SettingsSave(SAVE_FM_PRESETS, KEY_FM_PRESETS, Scan_Station(0), Scan_Count() * sizeof(Scan_Station_t)) ||
+			!SettingsSave(SAVE_TZ, KEY_TZ, &zoneIndex, sizeof(zoneIndex))){
+		return;
+	}
+	if (settingsDirty & SAVE_ALARMS){
+		if (!SettingsSave(SAVE_ALARMS, KEY_ALARMS, Sched_Get(0), SCHED_MAX_ALARMS * sizeof(Sched_Alarm_t))){
+			return;
+		}
+		if (!(settingsDirty & SAVE_ALARMS)){
+			KV_Delete(KEY_ALARM_A);
+		}
+	}
+	if (settingsDirty == 0){
+		settingsDelayMs = SAVE_DELAY_MS;
+	}
+	else {
+		// What is left failed; try it again later rather than wear the flash
+		settingsDirtyTick = HAL_GetTick();
+		if (settingsDelayMs < SAVE_RETRY_MAX_MS){
+			settingsDelayMs *= 2;
+		}
+	}
+}
+
+void RadioMute(bool mute){
+	if (Seek_Busy()){
+		// The search owns the registers; the main loop applies muteS after it
+		muteS = mute;
+		return;
+	}
+	if (!TEA5767_GetCache()->regsValid){
+		RadioTune(readFreq, mute, false, false);
+		return;
+	}
+	muteS = mute;
+	result = TEA5767_SetMute(mute);
+}
+
+static int RadioBusWrite(const uint8_t regs[TEA5767_REG_COUNT]){
+	return TEA5767_Write(regs) != HAL_OK;
+}
+
+static int RadioBusRead(uint8_t regs[TEA5767_REG_COUNT]){
+	return TEA5767_Read(regs) != HAL_OK;
+}
+
+// The read runs on I2C2 while the frame is drawn and flushed on I2C1, so a
+// screen shows the status from the read before
+void RadioStatus(void){
+	TEA5767_Status_t status;
+
+	result = TEA5767_PollStatusAsync(&status);
+	if (result == HAL_OK){
+		readFreq = status.freq;
+		adcLevel = status.level;
+	}
+}
+
+// Stop 2 clock face. Only the characters that changed since the last wake
+// are redrawn and sent; a wake that changed nothing goes straight back to sleep.
+void TimeFace(void){
+	char text[24];
+	uint32_t next;
+
+	editElement = 0;
+	elementInc = 0;
+	elementSelect = 0;
+	RtcRead(&sTime, &sDate);
+	if (frameDirty){
+		memset(faceText, 0, sizeof(faceText));
+		memset(&faceStats, 0, sizeof(faceStats));
+		ssd1306_Fill(Black);
+		faceFull = true;
+		frameDirty = false;
+		FaceWakeSources(true);
+		RtcStamp(&faceWoke);
+		ClockIdle();
+	}
+	PROF_BEGIN(PROF_MENU_FACE);
+	text[0] = '\0';
+	if (Sched_Next(&next) >= 0){
+		uint32_t now = RtcSeconds(&sDate, &sTime);
+
+		// An alarm due this second, not yet taken by the interrupt, is 0h00
+		next = (next > now) ? next - now : 0;
+		Fmt_U2(Fmt_Char(Fmt_UDec(Fmt_Str(text, "alarm "), next / 3600), 'h'), (next / 60) % 60);
+	}
+	FaceField(0, 0, 0, Font_7x10, text);
+	Fmt_UDec(text, 2000 + sDate.Year);
+	FaceField(1, 95, 0, Font_7x10, text);
+	Fmt_HourMin(text, sTime.Hours, sTime.Minutes);
+	FaceField(2, 24, 16, Font_16x26, text);
+	const char* weekdayStr = weekdays[sDate.WeekDay - 1];
+    const char* monthStr = months[sDate.Month -1];
+	Fmt_Ordinal(Fmt_Str(Fmt_Str(Fmt_Str(text, weekdayStr), ", "), monthStr), sDate.Date);
+	FaceField(3, 0, 50, Font_7x10, text);
+	if (faceFull){
+		ssd1306_UpdateScreen();
+		faceFull = false;
+	}
+	PROF_END(PROF_MENU_FACE);
+	FaceSleep();
+}
+
+// Redraws the character cells of a face field that differ from what it shows
+void FaceField(uint8_t field, uint8_t x, uint8_t y, SSD1306_Font_t font, const char* text){
+	char* shown = faceText[field];
+	uint8_t len = strlen(text);
+	uint8_t old = strlen(shown);
+	uint8_t i;
+
+	for (i = 0; i < len || i < old; i++){
+		char c = (i < len) ? text[i] : '\0';
+		char was = (i < old) ? shown[i] : '\0';
+		uint16_t cx = x + i * font.width;
+		if (c == was || cx >= SSD1306_WIDTH){
+			continue;
+		}
+		ssd1306_FillRectangle(cx, y, cx + font.width - 1, y + font.height - 1, Black);
+		if (c != '\0'){
+			ssd1306_SetCursor(cx, y);
+			ssd1306_WriteChar(c, font, White);
+		}
+		if (!faceFull){
+			ssd1306_UpdateArea(cx, y, font.width, font.height);
+		}
+	}
+	strcpy(shown, text);
+}
+
+// TIM2 does not count in Stop 2, so encoder input A wakes the face through EXTI0,
+// and the start bit of a console byte on USART2 RX (PA3) through EXTI3. The pins
+// stay in their alternate functions; EXTI taps the input path either way.
+void FaceWakeSources(bool on){
+	if (on){
+		MODIFY_REG(SYSCFG->EXTICR[0], SYSCFG_EXTICR1_EXTI0 | SYSCFG_EXTICR1_EXTI3,
+				SYSCFG_EXTICR1_EXTI0_PA | SYSCFG_EXTICR1_EXTI3_PA);
+		SET_BIT(EXTI->RTSR1, EXTI_RTSR1_RT0);
+		SET_BIT(EXTI->FTSR1, EXTI_FTSR1_FT0 | EXTI_FTSR1_FT3);
+		__HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_0 | GPIO_PIN_3);
+		SET_BIT(EXTI->IMR1, EXTI_IMR1_IM0 | EXTI_IMR1_IM3);
+		HAL_NVIC_SetPriority(EXTI0_IRQn, 0, 0);
+		HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+		HAL_NVIC_SetPriority(EXTI3_IRQn, 3, 0);
+		HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+	}
+	else {
+		HAL_NVIC_DisableIRQ(EXTI0_IRQn);
+		HAL_NVIC_DisableIRQ(EXTI3_IRQn);
+		CLEAR_BIT(EXTI->IMR1, EXTI_IMR1_IM0 | EXTI_IMR1_IM3);
+		__HAL_GPIO_EXTI_CLEAR_IT(GPIO_PIN_0 | GPIO_PIN_3);
+	}
+}
+
+// Stops until Alarm B at the next minute, the button, the encoder or the
+// console. The core wakes on the oscillator of the current clock point, so at
+// most the PLL has to be restarted; Clock_Resume times that with the cycle counter.
+void FaceSleep(void){
+	RtcTime_t asleep;
+	uint32_t us;
+	uint32_t ms;
+
+	if (Console_UartActive() || Seek_Busy() || Scan_Busy()){
+		// USART2 cannot receive in Stop 2, and a console scan is polled on
+		// SysTick; the run time is charged at the next real stop
+		HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+		return;
+	}
+	RtcStamp(&asleep);
+	faceStats.runMs += RtcTime_DiffMs(&asleep, &faceWoke);
+	// DMA and I2C stop in Stop 2, so let the log and bus jobs finish first
+	Bus_WaitAll();
+	Log_Drain();
+	Trace_Event(TRACE_SLEEP, TRACE_SLEEP_STOP2);
+	Clock_PrepareStop();
+	HAL_SuspendTick();
+	HAL_PWREx_EnterSTOP2Mode(PWR_STOPENTRY_WFI);
+	us = Clock_Resume();
+	HAL_ResumeTick();
+	// The calendar shadow registers are stale until they resynchronise after Stop
+	__HAL_RTC_WRITEPROTECTION_DISABLE(&hrtc);
+	HAL_RTC_WaitForSynchro(&hrtc);
+	__HAL_RTC_WRITEPROTECTION_ENABLE(&hrtc);
+	RtcStamp(&faceWoke);
+	ms = RtcTime_DiffMs(&faceWoke, &asleep);
+	Trace_Wake(ms);
+	faceStats.stopMs += ms;
+	faceStats.wakes++;
+	faceStats.resumeUs = us;
+	if (us > faceStats.resumeMaxUs){
+		faceStats.resumeMaxUs = us;
+	}
+}
+
+// Leaving the face: drop the extra wake sources and log how it slept, e.g.
+// "face: 42 wakes, stop 99.9%, resume 31 us max 33, est 12 uA"
+void FaceLeave(void){
+	char msg[80];
+	char* p = msg;
+	uint32_t total = faceStats.stopMs + faceStats.runMs;
+	uint32_t runUa = (Clock_Get() == CLOCK_FULL) ? FACE_FULL_UA : FACE_LOW_UA;
+
+	FaceWakeSources(false);
+	if (faceStats.wakes == 0 || total == 0){
+		return;
+	}
+	p = Fmt_UDec(Fmt_Str(p, "face: "), faceStats.wakes);
+	p = Fmt_Fixed(Fmt_Str(p, " wakes, stop "), (int32_t)((uint64_t)faceStats.stopMs * 1000 / total), 1);
+	p = Fmt_UDec(Fmt_Str(p, "%, resume "), faceStats.resumeUs);
+	p = Fmt_UDec(Fmt_Str(p, " us max "), faceStats.resumeMaxUs);
+	p = Fmt_UDec(Fmt_Str(p, ", est "),
+			(uint32_t)(((uint64_t)faceStats.stopMs * FACE_STOP2_NA / 1000 + (uint64_t)faceStats.runMs * runUa) / total));
+	p = Fmt_Str(p, " uA\r\n");
+	UartWrite(msg, p - msg);
+}
+
+void AlarmProc(void){
+	if (flagA != 1){
+		if (muteS){
+			wasA = muteS;
+		}
+		else{
+			wasA = false;
+		}
+		RadioMute(false);
+		if (alarmRinging == SCHED_SNOOZE){
+			Session_Resume();
+		}
+		else {
+			// A scheduled alarm replaces any snooze still pending
+			HAL_NVIC_DisableIRQ(RTC_Alarm_IRQn);
+			Sched_CancelSnooze();
+			HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+			Session_Start();
+		}
+		HAL_NVIC_SetPriority(RTC_WKUP_IRQn, 0, 0);
+		HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+		HAL_RTCEx_SetWakeUpTimer_IT(&hrtc, BLINK_WAKEUP_COUNT, RTC_WAKEUPCLOCK_RTCCLK_DIV16);
+	}
+	flagA = 1;
+	// Turning the knob snoozes, the button stops the alarm through menu 5
+	if (elementSelect != 0 && Session_Snooze()){
+		HAL_NVIC_DisableIRQ(RTC_Alarm_IRQn);
+		Sched_Snooze(RtcNow() + SESSION_SNOOZE_S);
+		HAL_NVIC_EnableIRQ(RTC_Alarm_IRQn);
+		menuSelect = 5;
+		return;
+	}
+	if (Session_TimedOut()){
+		menuSelect = 5;
+		return;
+	}
+	editElement = 0;
+	elementInc = 0;
+	elementSelect = 0;
+	if (Session_TakeRedraw()){
+		Clock_Set(CLOCK_FULL);
+		PROF_BEGIN(PROF_MENU_RING);
+		ssd1306_Fill(Black);
+		ssd1306_SetCursor(0, 20);
+		ssd1306_WriteString("ALARM!!!", Font_16x26, Session_BlinkOn() ? White : Black);
+		if (Session_Snoozes() > 0){
+			char snoozeStr[12];
+			Fmt_UDec(Fmt_Str(snoozeStr, "snooze "), Session_Snoozes());
+			ssd1306_SetCursor(0, 52);
+			ssd1306_WriteString(snoozeStr, Font_7x10, White);
+		}
+		ssd1306_UpdateScreen();
+		PROF_END(PROF_MENU_RING);
+	}
+	// Sleep until the next blink phase unless a button press is being debounced
+	if (button == 0){
+		ClockIdle();
+		Trace_Event(TRACE_SLEEP, TRACE_SLEEP_WFI);
+		HAL_SuspendTick();
+		HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+		HAL_ResumeTick();
+		Trace_Event(TRACE_WAKE, 0);
+	}
+}
+
+// Leaving the ring screen; a snoozed session stays armed in the scheduler
+void AlarmStop(void){
+	HAL_RTCEx_DeactivateWakeUpTimer(&hrtc);
+	if (Session_State() == SESSION_RINGING){
+		Session_Stop();
+	}
+}
+
+void HAL_RTCEx_WakeUpTimerEventCallback(RTC_HandleTypeDef *hrtc){
+	Session_Tick();
+}
+
+
+// Repeat choices offered for an alarm, index 0 turns it off
+static const uint8_t repeatDays[] = {0, 0, SCHED_DAILY, SCHED_WEEKDAYS, SCHED_WEEKEND};
+static const char* repeatNames[] = {"off", "once", "daily", "Mon-Fri", "Sat-Sun", "custom"};
+
+static int AlarmRepeat(const Sched_Alarm_t* alarm){
+	int i;
+
+	if (!(alarm->flags & SCHED_ENABLED)){
+		return 0;
+	}
+	for (i = 1; i < (int)sizeof(repeatDays); i++){
+		if (alarm->days == repeatDays[i]){
+			return i;
+		}
+	}
+	return sizeof(repeatDays);
+}
+
+void DisplayAlarm(void){
+	char alarmMenu[20];
+	char* p;
+	static Sched_Alarm_t editing;
+	static int editingRepeat;
+	const Sched_Alarm_t* alarm = Sched_Get(alarmSlot);
+	uint32_t next;
+	Cal_DateTime_t dt;
+	int id;
+	ssd1306_Fill(Black);
+	ssd1306_SetCursor(0, 0);
+	ssd1306_WriteString("Set Alarm:  Next", Font_7x10, White);
+	p = Fmt_Str(Fmt_UDec(Fmt_Str(alarmMenu, "Alarm "), alarmSlot + 1), ": ");
+	Fmt_Time(p, alarm->hours, alarm->minutes, alarm->seconds);
+	ssd1306_SetCursor(0, 16);
+	ssd1306_WriteString(alarmMenu, Font_7x10, White);
+	Fmt_Str(Fmt_Str(alarmMenu, "Repeat: "), repeatNames[AlarmRepeat(alarm)]);
+	ssd1306_SetCursor(0, 28);
+	ssd1306_WriteString(alarmMenu, Font_7x10, White);
+	Fmt_Str(Fmt_Str(alarmMenu, "Skip next: "), (alarm->flags & SCHED_SKIP_NEXT) ? "yes" : "no");
+	ssd1306_SetCursor(0, 40);
+	ssd1306_WriteString(alarmMenu, Font_7x10, White);
+	id = Sched_Next(&next);
+	p = Fmt_Str(alarmMenu, "Next: ");
+	if (id >= 0){
+		Cal_FromSeconds(next, &dt);
+		p = Fmt_Str(Fmt_Str(p, weekdays[dt.weekday - 1]), " ");
+		p = Fmt_HourMin(p, dt.hours, dt.minutes);
+		if (id == SCHED_SNOOZE){
+			Fmt_Str(p, " zz");
+		}
+		else {
+			Fmt_UDec(Fmt_Str(p, " #"), id + 1);
+		}
+	}
+	else {
+		Fmt_Str(p, "none");
+	}
+	ssd1306_SetCursor(0, 52);
+	ssd1306_WriteString(alarmMenu, Font_7x10, White);
+	switch (elementSelect) {
+		case -1:{
+			elementSelect = 0;
+			break;
+		}
+		case 0: {
+			ssd1306_SetCursor(85, 0);
+			ssd1306_WriteString("Next", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			editElement = 0;
+			elementInc = 0;
+			break;
+		}
+		case 1:{
+			Fmt_UDec(Fmt_Str(alarmMenu, "Alarm "), alarmSlot + 1);
+			ssd1306_SetCursor(0, 16);
+			ssd1306_WriteString(alarmMenu, Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1){
+				if (elementInc == 1){
+					alarmSlot = (alarmSlot + 1) % SCHED_MAX_ALARMS;
+				}
+				else if (elementInc == -1){
+					alarmSlot = (alarmSlot == 0) ? SCHED_MAX_ALARMS - 1 : alarmSlot - 1;
+				}
+				elementInc = 0;
+			}
+			else if (editElement > 1){
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 2:{
+			if (editElement == 0){
+				editing = *alarm;
+				Fmt_Time(alarmMenu, alarm->hours, alarm->minutes, alarm->seconds);
+				ssd1306_SetCursor(63, 16);
+				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
+				ssd1306_UpdateScreen();
+			}
+			else if (editElement == 1){
+				Fmt_U2(alarmMenu, editing.hours);
+				ssd1306_SetCursor(63, 16);
+				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
+				ssd1306_UpdateScreen();
+				if (elementInc == 1){
+					editing.hours = (editing.hours + 1) % 24;
+					elementInc = 0;
+				}
+				else if (elementInc == -1) {
+					editing.hours = (editing.hours == 0) ? 23 : editing.hours - 1;
+					elementInc = 0;
+				}
+			}
+			else if (editElement == 2){
+				// Setting a time switches the alarm on
+				editing.flags |= SCHED_ENABLED;
+				AlarmEdit(alarmSlot, &editing);
+				editElement = 3;
+			}
+			else if (editElement == 3){
+				Fmt_U2(alarmMenu, editing.minutes);
+				ssd1306_SetCursor(83, 16);
+				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
+				ssd1306_UpdateScreen();
+				if (elementInc == 1) {
+					editing.minutes = (editing.minutes + 1) % 60;
+					elementInc = 0;
+				}
+				else if (elementInc == -1) {
+					editing.minutes = (editing.minutes == 0) ? 59 : editing.minutes - 1;
+					elementInc = 0;
+				}
+			}
+			else if (editElement == 4){
+				AlarmEdit(alarmSlot, &editing);
+				editElement = 5;
+			}
+			else if (editElement == 5){
+				Fmt_U2(alarmMenu, editing.seconds);
+				ssd1306_SetCursor(104, 16);
+				ssd1306_WriteString(alarmMenu, Font_7x10, Black);
+				ssd1306_UpdateScreen();
+				if (elementInc == 1) {
+					editing.seconds = (editing.seconds + 1) % 60;
+					elementInc = 0;
+				}
+				else if (elementInc == -1) {
+					editing.seconds = (editing.seconds == 0) ? 59 : editing.seconds - 1;
+					elementInc = 0;
+				}
+			}
+			else if (editElement == 6){
+				AlarmEdit(alarmSlot, &editing);
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 3:{
+			if (editElement == 0){
+				editingRepeat = AlarmRepeat(alarm);
+			}
+			Fmt_Str(Fmt_Char(alarmMenu, ' '), repeatNames[editingRepeat]);
+			ssd1306_SetCursor(49, 28);
+			ssd1306_WriteString(alarmMenu, Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1){
+				if (elementInc == 1){
+					editingRepeat = (editingRepeat + 1) % sizeof(repeatDays);
+				}
+				else if (elementInc == -1){
+					editingRepeat = (editingRepeat <= 0) ? sizeof(repeatDays) - 1 : editingRepeat - 1;
+				}
+				elementInc = 0;
+			}
+			else if (editElement > 1){
+				editing = *alarm;
+				if (editingRepeat == 0){
+					editing.flags &= ~SCHED_ENABLED;
+				}
+				else if (editingRepeat < (int)sizeof(repeatDays)){
+					editing.days = repeatDays[editingRepeat];
+					editing.flags |= SCHED_ENABLED;
+				}
+				AlarmEdit(alarmSlot, &editing);
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 4:{
+			ssd1306_SetCursor(77, 40);
+			ssd1306_WriteString((alarm->flags & SCHED_SKIP_NEXT) ? "yes" : "no", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1){
+				editing = *alarm;
+				editing.flags ^= SCHED_SKIP_NEXT;
+				AlarmEdit(alarmSlot, &editing);
+				editElement = 2;
+			}
+			else if (editElement == 2){
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 5:{
+			elementSelect = 4;
+			break;
+		}
+	}
+}
+
+void DisplayFM(void){
+	char fmMenu[20];
+	char* p;
+	int preset;
+	if (!Seek_Busy()){
+		RadioStatus();
+	}
+	else if (!Scan_Busy()){
+		// A band sweep keeps showing the station it will return to
+		readFreq = Seek_CurrentFreq();
+	}
+	ssd1306_Fill(Black);
+	Fmt_Str(Fmt_IDec(Fmt_Str(fmMenu, "FM Radio  "), adcLevel), "  Next");
+	ssd1306_SetCursor(0, 0);
+	ssd1306_WriteString(fmMenu, Font_7x10, White);
+	// The last radio transfer failed; readFreq is stale
+	if (result == HAL_OK){
+		Fmt_Str(Fmt_Fixed(Fmt_Str(fmMenu, "Freq: "), readFreq, 2), " MHz");
+	}
+	else {
+		Fmt_Str(fmMenu, Bus_Down(BUS_RADIO) ? "Freq: no radio" : "Freq: retrying");
+	}
+	ssd1306_SetCursor(0, 16);
+	ssd1306_WriteString(fmMenu, Font_7x10, White);
+	ssd1306_SetCursor(0, 28);
+	ssd1306_WriteString("scan: up / down", Font_7x10, White);
+	ssd1306_SetCursor(0, 40);
+	ssd1306_WriteString("Toggle: on/off", Font_7x10, White);
+	if (Scan_Busy()){
+		p = Fmt_Str(fmMenu, "Scanning ");
+		Fmt_Fixed(p, Seek_CurrentFreq() / TEA5767_FREQ_STEP, 1);
+	}
+	else {
+		p = Fmt_Str(fmMenu, "Preset ");
+		preset = Scan_Find(readFreq);
+		p = (preset >= 0) ? Fmt_UDec(p, preset + 1) : Fmt_Char(p, '-');
+		Fmt_UDec(Fmt_Char(p, '/'), Scan_Count());
+	}
+	ssd1306_SetCursor(0, 52);
+	ssd1306_WriteString(fmMenu, Font_7x10, White);
+	ssd1306_SetCursor(98, 52);
+	ssd1306_WriteString("scan", Font_7x10, White);
+	switch (elementSelect){
+		case -1:{
+			elementSelect = 0;
+			break;
+		}
+		case 0:{
+			ssd1306_SetCursor(89, 0);
+			ssd1306_WriteString("Next", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			editElement = 0;
+			elementInc = 0;
+			break;
+		}
+		case 1:{
+			if (editElement == 0){
+			    setFreq = TEA5767_ClampFreq(readFreq);
+			}
+			Fmt_Str(Fmt_Fixed(Fmt_Char(fmMenu, ' '), setFreq, 2), " MHz  ");
+			ssd1306_SetCursor(34, 16);
+			ssd1306_WriteString(fmMenu, Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if(editElement == 1){
+				if (scanFlag == 0){
+					setFreq = TEA5767_ClampFreq(readFreq);
+				}
+				scanFlag = 1;
+				// Stepping starts inside the band, so going down cannot wrap
+				if (elementInc == 1){
+					setFreq = TEA5767_ClampFreq(setFreq + TEA5767_FREQ_STEP);
+					elementInc = 0;
+				}
+				else if (elementInc == -1){
+					setFreq = TEA5767_ClampFreq(setFreq - TEA5767_FREQ_STEP);
+					elementInc = 0;
+				}
+			}
+			else if (editElement > 1){
+				RadioTune(setFreq, false, false, false);
+				elementInc = 0;
+				editElement = 0;
+				scanFlag = 0;
+			}
+			break;
+		}
+		case 2:{
+			ssd1306_SetCursor(35, 28);
+			ssd1306_WriteString(" up ", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1 && scanFlag == 0 && Scan_Busy()){
+				// The background sweep owns the seek engine until it ends
+				editElement = 0;
+				elementInc = 0;
+			}
+			else if (editElement == 1){
+				if (scanFlag == 0){
+					muteS = false;
+					Seek_Start(readFreq, true, false, HAL_GetTick());
+				}
+				else if (!Seek_Busy()){
+					editElement++;
+				}
+				scanFlag = 1;
+			}
+			else if (editElement == 2){
+				if (!Seek_Cancel()){
+					result = HAL_ERROR;
+				}
+				scanFlag = 0;
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 3:{
+			ssd1306_SetCursor(70, 28);
+			ssd1306_WriteString(" down ", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1 && scanFlag == 0 && Scan_Busy()){
+			    // The background sweep owns the seek engine until it ends
+			    editElement = 0;
+			    elementInc = 0;
+			}
+			else if (editElement == 1){
+			    if (scanFlag == 0){
+			    	muteS = false;
+			    	Seek_Start(readFreq, false, false, HAL_GetTick());
+			    }
+			    else if (!Seek_Busy()){
+			    	editElement++;
+			    }
+			    scanFlag = 1;
+			}
+			else if (editElement == 2){
+			    if (!Seek_Cancel()){
+			    	result = HAL_ERROR;
+			    }
+			    scanFlag = 0;
+			    editElement = 0;
+			    elementInc = 0;
+			}
+			break;
+		}
+		case 4:{
+			ssd1306_SetCursor(56, 40);
+			ssd1306_WriteString("on/off", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1){
+				if (muteS){
+					RadioMute(false);
+				}
+				else {
+					RadioMute(true);
+				}
+				editElement = 2;
+			}
+			else if (editElement == 2){
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 5:{
+			ssd1306_SetCursor(0, 52);
+			ssd1306_WriteString("Preset", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1){
+				if (elementInc != 0 && !Scan_Busy() && Scan_Count() > 0){
+					preset = Scan_Next(readFreq, elementInc == 1);
+					readFreq = Scan_Station(preset)->freq;
+					RadioTune(readFreq, muteS, false, false);
+				}
+				elementInc = 0;
+			}
+			else if (editElement > 1){
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 6:{
+			ssd1306_SetCursor(98, 52);
+			ssd1306_WriteString("scan", Font_7x10, Black);
+			ssd1306_UpdateScreen();
+			if (editElement == 1){
+				if (scanFlag == 0){
+					Scan_Start(readFreq, muteS, HAL_GetTick());
+				}
+				else if (!Scan_Busy()){
+					editElement++;
+				}
+				scanFlag = 1;
+			}
+			else if (editElement == 2){
+				// A press leaves the sweep running in the background
+				scanFlag = 0;
+				editElement = 0;
+				elementInc = 0;
+			}
+			break;
+		}
+		case 7:{
+			elementSelect = 6;
+			break;
+		}
+	}
+}
+
+// The time menu only changes when a second ticks over or the knob or button
+// is used. Until then sleep on SysTick, which keeps the encoder polled every
+// millisecond, instead of redrawing the same frame over I2C.
+bool TimeFrameDue(void){
+	if (frameDirty || elementInc != 0 || elementSelect != frameSelect || editElement != frameEdit ||
+			HAL_GetTick() - frameTick >= frameWaitMs){
+		Clock_Set(CLOCK_FULL);
+		return true;
+	}
+	ClockIdle();
+	HAL_PWR_EnterSLEEPMode(PWR_MAINREGULATOR_ON, PWR_SLEEPENTRY_WFI);
+	return false;
+}
+
+// Schedules the next frame for the next second boundary, or right away when
+// the frame just applied an edit the screen does not show yet
+void TimeFrameDone(int select, int edit, bool input){
+	RtcTime_t now;
+
+	RtcStamp(&now);
+	frameTick = HAL_GetTick();
+	frameWaitMs = input ? 0 : RtcTime_UntilSecond(&now);
+	frameSelect = select;
+	frameEdit = edit;
+	frameDirty = false;
+}
+
+void DisplayTimeOled(void) {
+    char timeStr[20];
+    int select = elementSelect;
+    int edit = editElement;
+    bool input = elementInc != 0;
+
+    if (!TimeFrameDue()){
+    	return;
+    }
+    PROF_BEGIN(PROF_MENU_TIME);
+    RtcRead(&sTime, &sDate);
+    ssd1306_Fill(Black);
+    // Format the time as a string
+    ssd1306_SetCursor(0, 0);
+    ssd1306_WriteString("Set Time: Next", Font_7x10, White);
+    Fmt_Time(Fmt_Str(timeStr, "Time: "), sTime.Hours, sTime.Minutes, sTime.Seconds);
+    ssd1306_SetCursor(0, 16);
+    ssd1306_WriteString(timeStr, Font_7x10, White);
+
+    Fmt_Date(Fmt_Str(timeStr, "Date: "), sDate.Month, sDate.Date, 2000 + sDate.Year);
+    ssd1306_SetCursor(0, 28);
+    ssd1306_WriteString(timeStr, Font_7x10, White);
+
+    const char* weekdayStr = weekdays[sDate.WeekDay - 1];
+
+    Fmt_Str(Fmt_Str(timeStr, "Weekday: "), weekdayStr);
+    ssd1306_SetCursor(0, 40);
+    ssd1306_WriteString(timeStr, Font_7x10, White);
+
+    Fmt_Str(Fmt_Str(timeStr, "DST: "), zoneNames[zoneIndex]);
+    ssd1306_SetCursor(0, 52);
+    ssd1306_WriteString(timeStr, Font_7x10, White);
+    if (editElement != 0 && (elementSelect == 1 || elementSelect == 2) && !driftSession){
+    	DriftSessionStart();
+    }
+    switch(elementSelect){
+    	case -1:{
+    		elementSelect = 0;
+    		break;
+    	}
+    	case 0:{
+    		ssd1306_SetCursor(70, 0);
+    		ssd1306_WriteString("Next", Font_7x10, Black);
+    	    ssd1306_UpdateScreen();
+    	    editElement = 0;
+    	    elementInc = 0;
+    	    break;
+    	}
+    	case 1:{
+    		if (editElement == 0){
+    			Fmt_Time(timeStr, sTime.Hours, sTime.Minutes, sTime.Seconds);
+    			ssd1306_SetCursor(42, 16);
+    			ssd1306_WriteString(timeStr, Font_7x10, Black);
+    			ssd1306_UpdateScreen();
+    		}
+    		else if (editElement == 1){
+       	    	Fmt_U2(timeStr, sTime.Hours);
+       	    	ssd1306_SetCursor(42, 16);
+       	    	ssd1306_WriteString(timeStr, Font_7x10, Black);
+       	    	ssd1306_UpdateScreen();
+       	    	if (elementInc == 1){
+       	    		sTime.Hours = (sTime.Hours + 1) % 24;
+       	   	    	elementInc = 0;
+       	       	}
+       	    	else if (elementInc == -1){
+       	    		sTime.Hours = (sTime.Hours == 0) ? 23 : sTime.Hours - 1;
+       	    		elementInc = 0;
+       	    	}
+       	    	HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
+       	    	ClockChanged();
+       	    }
+    		else if (editElement == 2){
+    			Fmt_U2(timeStr, sTime.Minutes);
+    			ssd1306_SetCursor(62, 16);
+    			ssd1306_WriteString(timeStr, Font_7x10, Black);
+    			ssd1306_UpdateScreen();
+    		   	if (elementInc == 1){
+    		   		sTime.Minutes = (sTime.Minutes + 1) % 60;
+    		   		elementInc = 0;
+    		   	}
+    		    else if (elementInc == -1){
+    		    	sTime.Minutes = (sTime.Minutes == 0) ? 59 : sTime.Minutes - 1;
+    		       	elementInc = 0;
+    		    }
+    		    HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
+    		    ClockChanged();
+    		}
+    		else if (editElement == 3){
+    			Fmt_U2(timeStr, sTime.Seconds);
+    			ssd1306_SetCursor(83, 16);
+    			ssd1306_WriteString(timeStr, Font_7x10, Black);
+    			ssd1306_UpdateScreen();
+    			if (elementInc == 1){
+    		    	sTime.Seconds = (sTime.Seconds + 1) % 60;
+    		    	elementInc = 0;
+    		    }
+    		    else if (elementInc == -1){
+    		    	sTime.Seconds = (sTime.Seconds == 0) ? 59 : sTime.Seconds - 1;
+    		    	elementInc = 0;
+    		    }
+    		    HAL_RTC_SetTime(&hrtc, &sTime, RTC_FORMAT_BIN);
+    		    ClockChanged();
+    	    }
+    		else if (editElement > 3){
+    			editElement = 0;
+    			elementInc = 0;
+    		}
+    		break;
+    	}
+    	case 2:{
+    		if (editElement == 0){
+    			Fmt_Date(timeStr, sDate.Month, sDate.Date, 2000 + sDate.Year);
+    			ssd1306_SetCursor(42, 28);
+    			ssd1306_WriteString(timeStr, Font_7x10, Black);
+    			ssd1306_UpdateScreen();
+    		}
+    		else if (editElement == 1){
+    			Fmt_U2(timeStr, sDate.Month);
+    			ssd1306_SetCursor(42, 28);
+    			ssd1306_WriteString(timeStr, Font_7x10, Black);
+    			ssd1306_UpdateScreen();
+    			if (elementInc == 1){
+    				sDate.Month = (sDate.Month % 12) + 1;
+    				elementInc = 0;
+    			}
+    			else if (elementInc == -1){
+    				sDate.Month = (sDate.Month == 1) ? 12 : sDate.Month - 1;
+    				elementInc = 0;
+    			}
+    			SetDate();
+    		}
+    		else if (editElement == 2){
+    			Fmt_U2(timeStr, sDate.Year);
+    			ssd1306_SetCursor(97, 28);
+    			ssd1306_WriteString(timeStr, Font_7x10, Black);
+    			ssd1306_UpdateScreen();
+    			if (elementInc == 1) {
+    				sDate.Year = (sDate.Year + 1) % 100;  // RTC allows 00–99 (i.e., 2000–2099)
+    				elementInc = 0;
+    			}
+    			else if (elementInc == -1) {
+    				sDate.Year = (sDate.Year == 0) ? 99 : sDate.Year - 1;
+    				elementInc = 0;
+    			}
+    			SetDate();
+    		}
+    		else if (editElement == 3){
+    			Fmt_U2(timeStr, sDate.Date);
+    			ssd1306_SetCursor(62, 28);
+    			ssd1306_WriteString(timeStr, Font_7x10, Black);
+    			ssd1306_UpdateScreen();
+    			if (elementInc == 1) {
+    			    sDate.Date++;
+    			    if (sDate.Date > Cal_DaysInMonth(sDate.Year, sDate.Month)){
+    			        sDate.Date = 1;
+    			    }
+    			    elementInc = 0;
+    			}
+    			else if (elementInc == -1) {
+    			    if (sDate.Date == 1){
+    			        sDate.Date = Cal_DaysInMonth(sDate.Year, sDate.Month);
+    			    }
+    			    else {
+    			        sDate.Date--;
+    			    }
+    			    elementInc = 0;
+    			}
+    			SetDate();
+    		}
+    		else if (editElement > 3){
+    			editElement = 0;
+    			elementInc = 0;
+    		}
+    		break;
+    	}
+    	case 3:{
+    		// The weekday follows the date, so the next row is the DST rule
+    		if (editElement == 0){
+    			editingZone = zoneIndex;
+    		}
+    		Fmt_Str(timeStr, zoneNames[editingZone]);
+    		ssd1306_SetCursor(35, 52);
+    		ssd1306_WriteString(timeStr, Font_7x10, Black);
+    		ssd1306_UpdateScreen();
+    		if (editElement == 1){
+    			if (elementInc == 1){
+    				editingZone = (editingZone + 1) % ZONE_COUNT;
+    			}
+    			else if (elementInc == -1){
+    				editingZone = (editingZone == 0) ? ZONE_COUNT - 1 : editingZone - 1;
+    			}
+    			elementInc = 0;
+    		}
+    		else if (editElement > 1){
+    			ZoneSelect(editingZone);
+    			editElement = 0;
+    			elementInc = 0;
+    		}
+    		break;
+    	}
+    	case 4:{
+    		elementSelect = 3;
+    		break;
+    	}
+    }
+    TimeFrameDone(select, edit, input);
+    PROF_END(PROF_MENU_TIME);
+}
+
+// Keeps the day valid for the month and year and the weekday in step with the date
+void SetDate(void){
+	sDate.Date = Cal_ClampDate(sDate.Year, sDate.Month, sDate.Date);
+	sDate.WeekDay = Cal_Weekday(sDate.Year, sDate.Month, sDate.Date);
+	HAL_RTC_SetDate(&hrtc, &sDate, RTC_FORMAT_BIN);
+	ClockChanged();
+}
+
+
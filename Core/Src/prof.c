@@ -0,0 +1,126 @@
+/*
+ * prof.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "prof.h"
+
+#if PROF_ENABLE
+
+#include <string.h>
+#include "fmt.h"
+
+#if !defined(__arm__)
+#include <time.h>
+#endif
+
+static const char* const siteNames[PROF_SITES] = {
+	"oled update", "oled string", "oled fill", "oled i2c", "radio i2c",
+	"menu time", "menu fm", "menu alarm", "menu ring", "menu face"
+};
+
+static Prof_Stats_t stats[PROF_SITES];
+
+#if defined(__arm__)
+
+void Prof_Init(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	Prof_Reset();
+}
+
+// Cycles to ns at the clock the site ran at; 8 fraction bits keep 12.5 ns exact
+static uint32_t ProfToNs(uint32_t ticks) {
+	uint32_t nsPerCycleQ8 = (1000u << 8) / (SystemCoreClock / 1000000u);
+	return (uint32_t)(((uint64_t)ticks * nsPerCycleQ8) >> 8);
+}
+
+#else
+
+void Prof_Init(void) {
+	Prof_Reset();
+}
+
+uint32_t Prof_Now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec);
+}
+
+static uint32_t ProfToNs(uint32_t ticks) {
+	return ticks;
+}
+
+#endif
+
+void Prof_Record(Prof_Site_t site, uint32_t ticks) {
+	Prof_Stats_t* s = &stats[site];
+	uint32_t ns = ProfToNs(ticks);
+
+	s->count++;
+	s->sumNs += ns;
+	if (ns < s->minNs) {
+		s->minNs = ns;
+	}
+	if (ns > s->maxNs) {
+		s->maxNs = ns;
+	}
+	s->hist[31 - __builtin_clz(ns | 1)]++;
+}
+
+const Prof_Stats_t* Prof_Get(Prof_Site_t site) {
+	return &stats[site];
+}
+
+void Prof_Reset(void) {
+	uint8_t i;
+
+	memset(stats, 0, sizeof(stats));
+	for (i = 0; i < PROF_SITES; i++) {
+		stats[i].minNs = UINT32_MAX;
+	}
+}
+
+// One line per site that ran, times in microseconds, then its histogram:
+// "menu time n=61 min=2104.5 mean=2390.1 max=4021.7 us"
+// "  2^21:3 2^22:58"
+void Prof_Dump(void (*write)(const char* text, uint16_t len)) {
+	char line[96];
+	char* p;
+	uint8_t i;
+	uint8_t b;
+
+	for (i = 0; i < PROF_SITES; i++) {
+		const Prof_Stats_t* s = &stats[i];
+		if (s->count == 0) {
+			continue;
+		}
+		p = Fmt_Str(line, siteNames[i]);
+		p = Fmt_UDec(Fmt_Str(p, " n="), s->count);
+		p = Fmt_Fixed(Fmt_Str(p, " min="), s->minNs / 100, 1);
+		p = Fmt_Fixed(Fmt_Str(p, " mean="), (int32_t)(s->sumNs / s->count / 100), 1);
+		p = Fmt_Fixed(Fmt_Str(p, " max="), s->maxNs / 100, 1);
+		p = Fmt_Str(p, " us\r\n");
+		write(line, p - line);
+		p = Fmt_Str(line, " ");
+		for (b = 0; b < PROF_BUCKETS; b++) {
+			if (s->hist[b] == 0) {
+				continue;
+			}
+			if (p - line > (int)sizeof(line) - 24) {
+				p = Fmt_Str(p, "\r\n");
+				write(line, p - line);
+				p = Fmt_Str(line, " ");
+			}
+			p = Fmt_UDec(Fmt_Str(p, " 2^"), b);
+			p = Fmt_UDec(Fmt_Char(p, ':'), s->hist[b]);
+		}
+		p = Fmt_Str(p, "\r\n");
+		write(line, p - line);
+	}
+}
+
+#endif /* PROF_ENABLE */
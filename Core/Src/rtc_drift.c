@@ -0,0 +1,83 @@
+/*
+ * rtc_drift.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "rtc_drift.h"
+
+// One CALM step removes a pulse in 2^20, about 953.67 ppb
+#define DRIFT_CALM_PPB_X100     95367
+
+void Drift_Reset(Drift_State_t* state) {
+	state->anchor = 0;
+	state->elapsed = 0;
+	state->error = 0;
+	state->ppb = 0;
+}
+
+// rtcTime is what the RTC read just before the set, correctionMs how far
+// the set moved it, measured to the sub-second; a new date can move it by
+// years, so it is 64-bit. Returns true when ppb has changed and the
+// calibration register needs reprogramming.
+bool Drift_Record(Drift_State_t* state, uint32_t rtcTime, int64_t correctionMs) {
+	uint32_t span;
+	uint64_t magnitude = (correctionMs < 0) ? (uint64_t)-correctionMs : (uint64_t)correctionMs;
+	uint32_t anchor = state->anchor;
+	int64_t setTime = (int64_t)rtcTime + correctionMs / 1000;
+	int64_t ppb;
+
+	// A set the anchor cannot hold is discarded, leaving the anchor alone
+	if (setTime <= 0 || setTime > (int64_t)UINT32_MAX) {
+		return false;
+	}
+	state->anchor = (uint32_t)setTime;
+	if (anchor == 0 || rtcTime <= anchor) {
+		return false;
+	}
+	span = rtcTime - anchor;
+	if (magnitude > DRIFT_MAX_STEP_MS || magnitude * 1000u > (uint64_t)DRIFT_MAX_PPM * span) {
+		return false;
+	}
+	// The half second or so a set loses by restarting the second comes
+	// back in the next measured correction, so the sum stays unbiased
+	state->elapsed += span;
+	state->error += (int32_t)correctionMs;
+	if (state->elapsed < DRIFT_MIN_SPAN_S ||
+			(state->error < DRIFT_MIN_ERROR_MS && state->error > -DRIFT_MIN_ERROR_MS)) {
+		return false;
+	}
+	// A clock that needed time added ran slow and has to speed up
+	ppb = state->ppb + (int64_t)state->error * 1000000 / state->elapsed;
+	if (ppb > DRIFT_PPB_MAX) {
+		ppb = DRIFT_PPB_MAX;
+	}
+	else if (ppb < DRIFT_PPB_MIN) {
+		ppb = DRIFT_PPB_MIN;
+	}
+	state->elapsed = 0;
+	state->error = 0;
+	if (ppb == state->ppb) {
+		return false;
+	}
+	state->ppb = (int32_t)ppb;
+	return true;
+}
+
+// Smooth calibration over the 32 s window: CALP adds 512 pulses, CALM
+// removes 0-511, for a net (512 * CALP - CALM) pulses per 2^20
+void Drift_Calr(int32_t ppb, bool* plusPulses, uint16_t* minusPulses) {
+	int64_t pulses;
+
+	if (ppb > DRIFT_PPB_MAX) {
+		ppb = DRIFT_PPB_MAX;
+	}
+	else if (ppb < DRIFT_PPB_MIN) {
+		ppb = DRIFT_PPB_MIN;
+	}
+	// Rounded to the nearest pulse
+	pulses = ((int64_t)ppb * 100 + (ppb >= 0 ? DRIFT_CALM_PPB_X100 / 2 : -DRIFT_CALM_PPB_X100 / 2)) / DRIFT_CALM_PPB_X100;
+	*plusPulses = pulses > 0;
+	*minusPulses = (uint16_t)(*plusPulses ? 512 - pulses : -pulses);
+}
@@ -0,0 +1,50 @@
+/*
+ * rtc_time.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "rtc_time.h"
+
+// subSeconds and secondFraction are SSR and PREDIV_S as HAL_RTC_GetTime reports them
+void RtcTime_Make(RtcTime_t* t, uint32_t seconds, uint32_t subSeconds, uint32_t secondFraction) {
+	uint32_t span = secondFraction + 1;
+
+	if (subSeconds > secondFraction) {
+		// A pending shift: the counter is already into the previous second
+		subSeconds -= span;
+		seconds--;
+		subSeconds = (subSeconds > secondFraction) ? 0 : subSeconds;
+	}
+	t->seconds = seconds;
+	t->ms = (uint16_t)((secondFraction - subSeconds) * 1000u / span);
+}
+
+// a - b in milliseconds, saturated to the int32_t range
+int32_t RtcTime_DiffMs(const RtcTime_t* a, const RtcTime_t* b) {
+	int64_t d = ((int64_t)a->seconds - b->seconds) * 1000 + a->ms - b->ms;
+
+	if (d > INT32_MAX) {
+		return INT32_MAX;
+	}
+	if (d < -INT32_MAX) {
+		return -INT32_MAX;
+	}
+	return (int32_t)d;
+}
+
+// Milliseconds until seconds next reaches a multiple of periodS, never 0
+uint32_t RtcTime_UntilBoundary(const RtcTime_t* now, uint32_t periodS) {
+	uint32_t into = (now->seconds % periodS) * 1000u + now->ms;
+
+	return periodS * 1000u - into;
+}
+
+uint32_t RtcTime_UntilSecond(const RtcTime_t* now) {
+	return RtcTime_UntilBoundary(now, 1);
+}
+
+uint32_t RtcTime_UntilMinute(const RtcTime_t* now) {
+	return RtcTime_UntilBoundary(now, 60);
+}
@@ -0,0 +1,140 @@
+/*
+ * shot.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "shot.h"
+
+static const uint8_t* shotImage;
+static const uint8_t* shotBase;     // previous frame for a delta, NULL for a full frame
+static Shot_Write_t shotWrite;
+static uint16_t shotCrc;
+static uint32_t shotBytes;
+
+// CRC-16/CCITT-FALSE, continued over each piece of the frame
+static uint16_t ShotCrc(uint16_t crc, const uint8_t* data, uint32_t len) {
+	while (len--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for (int b = 0; b < 8; b++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+static void ShotOut(const uint8_t* data, uint16_t len) {
+	shotCrc = ShotCrc(shotCrc, data, len);
+	shotBytes += len;
+	shotWrite(data, len);
+}
+
+static uint8_t ShotByte(uint16_t i) {
+	return (shotBase != NULL) ? shotImage[i] ^ shotBase[i] : shotImage[i];
+}
+
+static void ShotLiterals(uint16_t start, uint16_t end) {
+	uint8_t packet[1 + SHOT_LITERAL_MAX];
+
+	while (start < end) {
+		uint16_t n = (end - start > SHOT_LITERAL_MAX) ? SHOT_LITERAL_MAX : end - start;
+		packet[0] = n - 1;
+		for (uint16_t k = 0; k < n; k++) {
+			packet[1 + k] = ShotByte(start + k);
+		}
+		ShotOut(packet, 1 + n);
+		start += n;
+	}
+}
+
+// Sends one frame of image and leaves a copy in previous for the next delta;
+// returns the bytes written. A delta needs previous to hold frame seq - 1.
+uint32_t Shot_Send(const uint8_t* image, uint8_t* previous, uint8_t width, uint8_t height,
+		uint8_t seq, bool delta, Shot_Write_t write) {
+	uint16_t size = (uint16_t)width * height / 8;
+	uint8_t header[SHOT_HEADER_SIZE] = {'S', 'H', 'O', 'T', 0, width, height, seq};
+	uint16_t literal = 0;
+	uint16_t i = 0;
+	uint8_t trailer[2];
+
+	shotImage = image;
+	shotBase = (delta && previous != NULL) ? previous : NULL;
+	shotWrite = write;
+	shotCrc = 0xFFFF;
+	shotBytes = 0;
+	header[4] = (shotBase != NULL) ? SHOT_DELTA : 0;
+	ShotOut(header, sizeof(header));
+	while (i < size) {
+		uint8_t b = ShotByte(i);
+		uint16_t run = 1;
+
+		while (i + run < size && run < SHOT_RUN_MAX && ShotByte(i + run) == b) {
+			run++;
+		}
+		if (run >= SHOT_RUN_MIN) {
+			uint8_t packet[2] = {0x80 | (run - SHOT_RUN_MIN), b};
+			ShotLiterals(literal, i);
+			ShotOut(packet, sizeof(packet));
+			literal = i + run;
+		}
+		i += run;
+	}
+	ShotLiterals(literal, size);
+	trailer[0] = shotCrc & 0xFF;
+	trailer[1] = shotCrc >> 8;
+	shotWrite(trailer, sizeof(trailer));
+	if (previous != NULL) {
+		memcpy(previous, image, size);
+	}
+	return shotBytes + sizeof(trailer);
+}
+
+// Walks the packets of a frame; with image set, stores or XORs what they code.
+// Returns the offset of the CRC, or 0 when the packets are malformed.
+static uint32_t ShotPackets(const uint8_t* frame, uint32_t len, uint8_t* image, uint16_t size) {
+	bool delta = (frame[4] & SHOT_DELTA) != 0;
+	uint32_t p = SHOT_HEADER_SIZE;
+	uint16_t n = 0;
+
+	while (n < size) {
+		uint8_t c;
+		uint16_t count;
+		bool run;
+		if (p >= len) {
+			return 0;
+		}
+		c = frame[p++];
+		run = c >= 0x80;
+		count = run ? (c & 0x7F) + SHOT_RUN_MIN : c + 1;
+		if (p + (run ? 1 : count) > len || n + count > size) {
+			return 0;
+		}
+		for (uint16_t k = 0; image != NULL && k < count; k++) {
+			uint8_t b = run ? frame[p] : frame[p + k];
+			image[n + k] = delta ? image[n + k] ^ b : b;
+		}
+		p += run ? 1 : count;
+		n += count;
+	}
+	return p;
+}
+
+// Applies a frame to image, which must hold the previous frame for a delta.
+// Returns the frame length, or -1 when it is malformed or fails its CRC;
+// image is only touched once the whole frame has checked out.
+int Shot_Decode(const uint8_t* frame, uint32_t len, uint8_t* image, uint16_t size) {
+	uint32_t p;
+
+	if (len < SHOT_HEADER_SIZE + 2 || memcmp(frame, "SHOT", 4) != 0 ||
+			(uint32_t)frame[5] * frame[6] / 8 != size) {
+		return -1;
+	}
+	p = ShotPackets(frame, len, NULL, size);
+	if (p == 0 || p + 2 > len || (frame[p] | (frame[p + 1] << 8)) != ShotCrc(0xFFFF, frame, p)) {
+		return -1;
+	}
+	ShotPackets(frame, len, image, size);
+	return p + 2;
+}
@@ -1,58 +1,35 @@
 #include "ssd1306.h"
+#include "prof.h"
+#include "trace.h"
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>  // For memcpy
 
-#if defined(SSD1306_USE_I2C)
-
-void ssd1306_Reset(void) {
-    /* for I2C - do nothing */
-}
-
-// Send a byte to the command register
-void ssd1306_WriteCommand(uint8_t byte) {
-    HAL_I2C_Mem_Write(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x00, 1, &byte, 1, HAL_MAX_DELAY);
-}
+#if defined(SSD1306_USE_SPI)
+static const SSD1306_Transport_t* SSD1306_Transport = &ssd1306_SPI;
+#else
+static const SSD1306_Transport_t* SSD1306_Transport = &ssd1306_I2C;
+#endif
 
-// Send data
-void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
-    HAL_I2C_Mem_Write(&SSD1306_I2C_PORT, SSD1306_I2C_ADDR, 0x40, 1, buffer, buff_size, HAL_MAX_DELAY);
+/* Choose the bus the panel is on; call before ssd1306_Init */
+void ssd1306_SetTransport(const SSD1306_Transport_t* transport) {
+    SSD1306_Transport = transport;
 }
 
-#elif defined(SSD1306_USE_SPI)
-
 void ssd1306_Reset(void) {
-    // CS = High (not selected)
-    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET);
-
-    // Reset the OLED
-    HAL_GPIO_WritePin(SSD1306_Reset_Port, SSD1306_Reset_Pin, GPIO_PIN_RESET);
-    HAL_Delay(10);
-    HAL_GPIO_WritePin(SSD1306_Reset_Port, SSD1306_Reset_Pin, GPIO_PIN_SET);
-    HAL_Delay(10);
+    SSD1306_Transport->Reset();
 }
 
 // Send a byte to the command register
 void ssd1306_WriteCommand(uint8_t byte) {
-    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_RESET); // select OLED
-    HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_RESET); // command
-    HAL_SPI_Transmit(&SSD1306_SPI_PORT, (uint8_t *) &byte, 1, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET); // un-select OLED
+    SSD1306_Transport->WriteCommands(&byte, 1);
 }
 
 // Send data
 void ssd1306_WriteData(uint8_t* buffer, size_t buff_size) {
-    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_RESET); // select OLED
-    HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_SET); // data
-    HAL_SPI_Transmit(&SSD1306_SPI_PORT, buffer, buff_size, HAL_MAX_DELAY);
-    HAL_GPIO_WritePin(SSD1306_CS_Port, SSD1306_CS_Pin, GPIO_PIN_SET); // un-select OLED
+    SSD1306_Transport->WriteData(buffer, buff_size);
 }
 
-#else
-#error "You should define SSD1306_USE_SPI or SSD1306_USE_I2C macro"
-#endif
-
-
 // Screenbuffer
 static uint8_t SSD1306_Buffer[SSD1306_BUFFER_SIZE];
 
@@ -69,8 +46,17 @@ SSD1306_Error_t ssd1306_FillBuffer(uint8_t* buf, uint32_t len) {
     return ret;
 }
 
+/* Gives read access to the Screenbuffer, e.g. for screenshots */
+const uint8_t* ssd1306_GetBuffer(void) {
+    return SSD1306_Buffer;
+}
+
 /* Initialize the oled screen */
 void ssd1306_Init(void) {
+    if(SSD1306_Transport->Init != NULL) {
+        SSD1306_Transport->Init();
+    }
+
     // Reset OLED
     ssd1306_Reset();
 
@@ -173,23 +159,55 @@ void ssd1306_Init(void) {
 
 /* Fill the whole screen with the given color */
 void ssd1306_Fill(SSD1306_COLOR color) {
+    PROF_BEGIN(PROF_OLED_FILL);
     memset(SSD1306_Buffer, (color == Black) ? 0x00 : 0xFF, sizeof(SSD1306_Buffer));
+    PROF_END(PROF_OLED_FILL);
 }
 
 /* Write the screenbuffer with changed to the screen */
 void ssd1306_UpdateScreen(void) {
-    // Write data to each page of RAM. Number of pages
-    // depends on the screen height:
-    //
-    //  * 32px   ==  4 pages
-    //  * 64px   ==  8 pages
-    //  * 128px  ==  16 pages
-    for(uint8_t i = 0; i < SSD1306_HEIGHT/8; i++) {
-        ssd1306_WriteCommand(0xB0 + i); // Set the current RAM page address.
-        ssd1306_WriteCommand(0x00 + SSD1306_X_OFFSET_LOWER);
-        ssd1306_WriteCommand(0x10 + SSD1306_X_OFFSET_UPPER);
-        ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH*i],SSD1306_WIDTH);
+    PROF_BEGIN(PROF_OLED_UPDATE);
+    SSD1306_Transport->Flush(SSD1306_Buffer);
+    // Drawing into the buffer goes on once this returns
+    while(SSD1306_Transport->Busy != NULL && SSD1306_Transport->Busy()) {
+    }
+    PROF_END(PROF_OLED_UPDATE);
+    Trace_Event(TRACE_FLUSH, SSD1306_BUFFER_SIZE);
+}
+
+/*
+ * Write only the part of the screenbuffer covering a rectangle
+ * The display runs in horizontal addressing mode, so the column and page
+ * window is narrowed for the transfer and opened up again afterwards
+ */
+void ssd1306_UpdateArea(uint8_t x, uint8_t y, uint8_t w, uint8_t h) {
+    const uint8_t offset = (SSD1306_X_OFFSET_UPPER << 4) | SSD1306_X_OFFSET_LOWER;
+
+    if(x >= SSD1306_WIDTH || y >= SSD1306_HEIGHT || w == 0 || h == 0) {
+        return;
+    }
+    if(w > SSD1306_WIDTH - x) {
+        w = SSD1306_WIDTH - x;
     }
+    if(h > SSD1306_HEIGHT - y) {
+        h = SSD1306_HEIGHT - y;
+    }
+    ssd1306_WriteCommand(0x21); // Set column address window
+    ssd1306_WriteCommand(offset + x);
+    ssd1306_WriteCommand(offset + x + w - 1);
+    ssd1306_WriteCommand(0x22); // Set page address window
+    ssd1306_WriteCommand(y / 8);
+    ssd1306_WriteCommand((y + h - 1) / 8);
+    for(uint8_t i = y / 8; i <= (y + h - 1) / 8; i++) {
+        ssd1306_WriteData(&SSD1306_Buffer[SSD1306_WIDTH*i + x], w);
+    }
+    ssd1306_WriteCommand(0x21);
+    ssd1306_WriteCommand(offset);
+    ssd1306_WriteCommand(offset + SSD1306_WIDTH - 1);
+    ssd1306_WriteCommand(0x22);
+    ssd1306_WriteCommand(0);
+    ssd1306_WriteCommand(SSD1306_HEIGHT/8 - 1);
+    Trace_Event(TRACE_FLUSH, w * ((y + h - 1) / 8 - y / 8 + 1));
 }
 
 /*
@@ -256,15 +274,17 @@ char ssd1306_WriteChar(char ch, SSD1306_Font_t Font, SSD1306_COLOR color) {
 
 /* Write full string to screenbuffer */
 char ssd1306_WriteString(char* str, SSD1306_Font_t Font, SSD1306_COLOR color) {
+    PROF_BEGIN(PROF_OLED_STRING);
     while (*str) {
         if (ssd1306_WriteChar(*str, Font, color) != *str) {
             // Char could not be written
-            return *str;
+            break;
         }
         str++;
     }
-    
-    // Everything ok
+    PROF_END(PROF_OLED_STRING);
+
+    // Everything ok, or the char that could not be written
     return *str;
 }
 
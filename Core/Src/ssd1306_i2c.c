@@ -0,0 +1,88 @@
+#include "ssd1306.h"
+#include "prof.h"
+#include "trace.h"
+#include "i2c_bus.h"
+
+/*
+ * I2C transport: the panel sits on the OLED bus of i2c_bus.c, which
+ * Bus_Init brings up, so there is no Init here.
+ */
+
+// A full update in flight: page address commands and data, per page
+static uint8_t SSD1306_PageCmds[SSD1306_HEIGHT/8][3];
+static Bus_Job_t SSD1306_PageJobs[SSD1306_HEIGHT/8][2];
+
+static void ssd1306_I2cReset(void) {
+    /* for I2C - do nothing */
+}
+
+// Send bytes to the command register
+static void ssd1306_I2cWriteCommands(const uint8_t* cmds, size_t len) {
+    PROF_BEGIN(PROF_OLED_I2C);
+    Bus_MemWrite(BUS_OLED, SSD1306_I2C_ADDR, 0x00, (uint8_t*)cmds, len);
+    PROF_END(PROF_OLED_I2C);
+}
+
+// Send data
+static void ssd1306_I2cWriteData(const uint8_t* data, size_t len) {
+    HAL_StatusTypeDef status;
+
+    Trace_Event(TRACE_I2C_START, (TRACE_DEV_OLED << 16) | len);
+    PROF_BEGIN(PROF_OLED_I2C);
+    status = Bus_MemWrite(BUS_OLED, SSD1306_I2C_ADDR, 0x40, (uint8_t*)data, len);
+    PROF_END(PROF_OLED_I2C);
+    Trace_Event(TRACE_I2C_END, (TRACE_DEV_OLED << 16) | status);
+    (void)status;
+}
+
+// Queue a command (control byte 0x00) or data (0x40) write without waiting
+static void ssd1306_I2cQueueWrite(Bus_Job_t* job, uint8_t control, const uint8_t* buffer, size_t buff_size) {
+    job->op = BUS_OP_MEM;
+    job->addr = SSD1306_I2C_ADDR;
+    job->reg = control;
+    job->data = (uint8_t*)buffer;
+    job->len = buff_size;
+    job->done = NULL;
+    Bus_Submit(BUS_OLED, BUS_PRIO_UI, job);
+}
+
+static void ssd1306_I2cFlush(const uint8_t* buffer) {
+    // Write data to each page of RAM. Number of pages
+    // depends on the screen height:
+    //
+    //  * 32px   ==  4 pages
+    //  * 64px   ==  8 pages
+    //  * 128px  ==  16 pages
+    //
+    // All pages are queued at once so the bus runs them back to back,
+    // alongside whatever the radio bus is doing, then waited for since the
+    // caller draws into the buffer next.
+    HAL_StatusTypeDef status = HAL_OK;
+
+    Trace_Event(TRACE_I2C_START, (TRACE_DEV_OLED << 16) | SSD1306_BUFFER_SIZE);
+    for(uint8_t i = 0; i < SSD1306_HEIGHT/8; i++) {
+        SSD1306_PageCmds[i][0] = 0xB0 + i; // Set the current RAM page address.
+        SSD1306_PageCmds[i][1] = 0x00 + SSD1306_X_OFFSET_LOWER;
+        SSD1306_PageCmds[i][2] = 0x10 + SSD1306_X_OFFSET_UPPER;
+        ssd1306_I2cQueueWrite(&SSD1306_PageJobs[i][0], 0x00, SSD1306_PageCmds[i], 3);
+        ssd1306_I2cQueueWrite(&SSD1306_PageJobs[i][1], 0x40, &buffer[SSD1306_WIDTH*i], SSD1306_WIDTH);
+    }
+    for(uint8_t i = 0; i < SSD1306_HEIGHT/8; i++) {
+        for(uint8_t j = 0; j < 2; j++) {
+            if(Bus_Finish(&SSD1306_PageJobs[i][j]) != HAL_OK) {
+                status = SSD1306_PageJobs[i][j].status;
+            }
+        }
+    }
+    Trace_Event(TRACE_I2C_END, (TRACE_DEV_OLED << 16) | status);
+    (void)status;
+}
+
+const SSD1306_Transport_t ssd1306_I2C = {
+    .Init = NULL,
+    .Reset = ssd1306_I2cReset,
+    .WriteCommands = ssd1306_I2cWriteCommands,
+    .WriteData = ssd1306_I2cWriteData,
+    .Flush = ssd1306_I2cFlush,
+    .Busy = NULL,
+};
@@ -0,0 +1,250 @@
+#include "ssd1306.h"
+
+/*
+ * SPI transport: 4-wire SPI on SPI2, with DMA1 channel 5 moving the bytes
+ * out and channel 4 reading back a dummy byte for each. The tree carries
+ * no HAL SPI driver, so the peripheral is set up through its registers;
+ * DMA and GPIO go through HAL as elsewhere.
+ *
+ * CS is the SPI's own NSS output (SSOE): low from the moment SPE is set
+ * until it is cleared, so it spans a whole transfer. NSSP stays off; its
+ * pulse would put a clock of idle between every byte. A transfer is
+ * commands with D/C low, then optionally data with D/C high.
+ *
+ * Every transfer runs full duplex only so that it can be finished from an
+ * interrupt. The TX completion only says the last byte is in the FIFO,
+ * but the RX channel completes when the last byte has been clocked out:
+ * by then FTLVL is 0, RX is drained and BSY drops within half an SCK
+ * cycle, well inside the interrupt's entry. That interrupt flips D/C and
+ * starts the data, or clears SPE to raise CS and clears ssd1306_SpiBusy.
+ * MISO is left unconnected, so the bytes read back are don't-care.
+ *
+ * Flush returns as soon as the transfer is started and ssd1306_UpdateScreen
+ * waits on Busy; commands and data from ssd1306_WriteCommand and friends
+ * are waited for here, since they may live on the caller's stack. A full
+ * screen flush is the 6 window bytes and the whole buffer back to back:
+ * about 0.8 ms at 10 MHz.
+ */
+
+static DMA_HandleTypeDef ssd1306_SpiTxDma;
+static DMA_HandleTypeDef ssd1306_SpiRxDma;
+static uint8_t ssd1306_SpiWindow[6];        // address window ahead of a flush
+static uint8_t ssd1306_SpiDummy;            // where the read-back bytes go
+static const uint8_t* ssd1306_SpiData;      // data phase still to come
+static size_t ssd1306_SpiDataLen;
+static uint32_t ssd1306_SpiStart;
+static volatile uint8_t ssd1306_SpiBusy;    // from start until CS is up again
+
+// RX first, so no byte clocked in is missed; with SPE set the TX channel
+// starts the clock straight away. Returns 0 on success.
+static int ssd1306_SpiDmaStart(const uint8_t* data, size_t len) {
+    if(HAL_DMA_Start_IT(&ssd1306_SpiRxDma, (uint32_t)(uintptr_t)&SPI2->DR, (uint32_t)(uintptr_t)&ssd1306_SpiDummy,
+            len) != HAL_OK) {
+        return -1;
+    }
+    if(HAL_DMA_Start(&ssd1306_SpiTxDma, (uint32_t)(uintptr_t)data, (uint32_t)(uintptr_t)&SPI2->DR, len) != HAL_OK) {
+        HAL_DMA_Abort(&ssd1306_SpiRxDma);
+        return -1;
+    }
+    return 0;
+}
+
+// Both channels stopped, CS up. Interrupt context, or with it masked.
+static void ssd1306_SpiEnd(void) {
+    HAL_DMA_Abort(&ssd1306_SpiRxDma);
+    HAL_DMA_Abort(&ssd1306_SpiTxDma);
+    SPI2->CR1 &= ~SPI_CR1_SPE;
+    ssd1306_SpiDataLen = 0;
+    ssd1306_SpiBusy = 0;
+}
+
+// The last byte of a phase has left the pin
+static void ssd1306_SpiDmaDone(DMA_HandleTypeDef* hdma) {
+    (void)hdma;
+    // TX finished before RX could; this only hands the channel back
+    HAL_DMA_PollForTransfer(&ssd1306_SpiTxDma, HAL_DMA_FULL_TRANSFER, 0);
+    if(ssd1306_SpiDataLen > 0) {
+        size_t len = ssd1306_SpiDataLen;
+
+        ssd1306_SpiDataLen = 0;
+        HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, GPIO_PIN_SET); // data
+        if(ssd1306_SpiDmaStart(ssd1306_SpiData, len) == 0) {
+            return;
+        }
+    }
+    SPI2->CR1 &= ~SPI_CR1_SPE; // un-select OLED
+    ssd1306_SpiBusy = 0;
+}
+
+static void ssd1306_SpiDmaError(DMA_HandleTypeDef* hdma) {
+    (void)hdma;
+    ssd1306_SpiEnd();
+}
+
+// Keep SCK at or below SSD1306_SPI_MAX_HZ for whatever PCLK1 is now;
+// clock_gov may have moved it since the last transfer. SPE is clear.
+static void ssd1306_SpiClock(void) {
+    uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+    uint32_t br = 0;
+
+    while(br < 7 && (pclk >> (br + 1)) > SSD1306_SPI_MAX_HZ) {
+        br++;
+    }
+    MODIFY_REG(SPI2->CR1, SPI_CR1_BR, br << SPI_CR1_BR_Pos);
+}
+
+// Nonzero while a transfer is going out. One that has run past
+// SSD1306_SPI_TIMEOUT_MS is given up on, so the next one starts clean.
+static uint8_t ssd1306_SpiPending(void) {
+    if(ssd1306_SpiBusy && HAL_GetTick() - ssd1306_SpiStart > SSD1306_SPI_TIMEOUT_MS) {
+        HAL_NVIC_DisableIRQ(DMA1_Channel4_IRQn);
+        if(ssd1306_SpiBusy) {
+            ssd1306_SpiEnd();
+        }
+        HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+    }
+    return ssd1306_SpiBusy;
+}
+
+static void ssd1306_SpiWait(void) {
+    while(ssd1306_SpiPending()) {
+    }
+}
+
+// Start commands, then data, under one chip select; either may be empty.
+// Both must stay put until ssd1306_SpiPending returns 0.
+static void ssd1306_SpiTransfer(const uint8_t* cmds, size_t cmdLen, const uint8_t* data, size_t dataLen) {
+    ssd1306_SpiWait();
+    if(cmdLen == 0 && dataLen == 0) {
+        return;
+    }
+    ssd1306_SpiClock();
+    ssd1306_SpiStart = HAL_GetTick();
+    ssd1306_SpiBusy = 1;
+    if(cmdLen > 0) {
+        ssd1306_SpiData = data;
+        ssd1306_SpiDataLen = dataLen;
+        data = cmds;
+        dataLen = cmdLen;
+    }
+    HAL_GPIO_WritePin(SSD1306_DC_Port, SSD1306_DC_Pin, (cmdLen > 0) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+    if(ssd1306_SpiDmaStart(data, dataLen) != 0) {
+        ssd1306_SpiDataLen = 0;
+        ssd1306_SpiBusy = 0;
+        return;
+    }
+    SPI2->CR1 |= SPI_CR1_SPE; // select OLED, clock starts
+}
+
+static void ssd1306_SpiInit(void) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_SPI2_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    // Out of reset before the pins start driving
+    HAL_GPIO_WritePin(SSD1306_Reset_Port, SSD1306_Reset_Pin, GPIO_PIN_SET);
+    gpio.Mode = GPIO_MODE_OUTPUT_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio.Pin = SSD1306_DC_Pin;
+    HAL_GPIO_Init(SSD1306_DC_Port, &gpio);
+    gpio.Pin = SSD1306_Reset_Pin;
+    HAL_GPIO_Init(SSD1306_Reset_Port, &gpio);
+
+    // PB13 SCK, PB15 MOSI
+    gpio.Pin = GPIO_PIN_13 | GPIO_PIN_15;
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF5_SPI2;
+    HAL_GPIO_Init(GPIOB, &gpio);
+    // CS on NSS, which is not driven while SPE is clear: the pull-up keeps
+    // the panel deselected between transfers
+    gpio.Pin = SSD1306_CS_Pin;
+    gpio.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(SSD1306_CS_Port, &gpio);
+
+    // Master, mode 0, MSB first, full duplex, NSS driven by the SPI; SPE
+    // is only set during a transfer
+    SPI2->CR1 = 0;
+    SPI2->CR1 = SPI_CR1_MSTR;
+    SPI2->CR2 = (7U << SPI_CR2_DS_Pos) | SPI_CR2_FRXTH | SPI_CR2_SSOE | // 8-bit frames
+            SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN;
+    ssd1306_SpiClock();
+
+    ssd1306_SpiTxDma.Instance = DMA1_Channel5;
+    ssd1306_SpiTxDma.Init.Request = DMA_REQUEST_1;
+    ssd1306_SpiTxDma.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    ssd1306_SpiTxDma.Init.PeriphInc = DMA_PINC_DISABLE;
+    ssd1306_SpiTxDma.Init.MemInc = DMA_MINC_ENABLE;
+    ssd1306_SpiTxDma.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    ssd1306_SpiTxDma.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    ssd1306_SpiTxDma.Init.Mode = DMA_NORMAL;
+    ssd1306_SpiTxDma.Init.Priority = DMA_PRIORITY_MEDIUM;
+    // Every byte read back into the one dummy; above TX so RX never overruns
+    ssd1306_SpiRxDma.Instance = DMA1_Channel4;
+    ssd1306_SpiRxDma.Init = ssd1306_SpiTxDma.Init;
+    ssd1306_SpiRxDma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    ssd1306_SpiRxDma.Init.MemInc = DMA_MINC_DISABLE;
+    ssd1306_SpiRxDma.Init.Priority = DMA_PRIORITY_HIGH;
+    if(HAL_DMA_Init(&ssd1306_SpiTxDma) != HAL_OK || HAL_DMA_Init(&ssd1306_SpiRxDma) != HAL_OK) {
+        return;
+    }
+    ssd1306_SpiRxDma.XferCpltCallback = ssd1306_SpiDmaDone;
+    ssd1306_SpiRxDma.XferErrorCallback = ssd1306_SpiDmaError;
+    HAL_NVIC_SetPriority(DMA1_Channel4_IRQn, 3, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Channel4_IRQn);
+}
+
+static void ssd1306_SpiReset(void) {
+    // Not in the middle of a transfer; CS is up while the SPI is off
+    ssd1306_SpiWait();
+
+    // Reset the OLED
+    HAL_GPIO_WritePin(SSD1306_Reset_Port, SSD1306_Reset_Pin, GPIO_PIN_RESET);
+    HAL_Delay(10);
+    HAL_GPIO_WritePin(SSD1306_Reset_Port, SSD1306_Reset_Pin, GPIO_PIN_SET);
+    HAL_Delay(10);
+}
+
+static void ssd1306_SpiWriteCommands(const uint8_t* cmds, size_t len) {
+    ssd1306_SpiTransfer(cmds, len, NULL, 0);
+    ssd1306_SpiWait();
+}
+
+static void ssd1306_SpiWriteData(const uint8_t* data, size_t len) {
+    ssd1306_SpiTransfer(NULL, 0, data, len);
+    ssd1306_SpiWait();
+}
+
+// The panel runs in horizontal addressing mode, so with the window opened
+// up to the whole screen the buffer goes out as one stream. Returns once
+// it has started.
+static void ssd1306_SpiFlush(const uint8_t* buffer) {
+    const uint8_t offset = (SSD1306_X_OFFSET_UPPER << 4) | SSD1306_X_OFFSET_LOWER;
+
+    // The window bytes of the last flush may still be going out
+    ssd1306_SpiWait();
+    ssd1306_SpiWindow[0] = 0x21; // Set column address window
+    ssd1306_SpiWindow[1] = offset;
+    ssd1306_SpiWindow[2] = offset + SSD1306_WIDTH - 1;
+    ssd1306_SpiWindow[3] = 0x22; // Set page address window
+    ssd1306_SpiWindow[4] = 0;
+    ssd1306_SpiWindow[5] = SSD1306_HEIGHT/8 - 1;
+    ssd1306_SpiTransfer(ssd1306_SpiWindow, sizeof(ssd1306_SpiWindow), buffer, SSD1306_BUFFER_SIZE);
+}
+
+void ssd1306_SpiDmaIRQHandler(void) {
+    HAL_DMA_IRQHandler(&ssd1306_SpiRxDma);
+}
+
+const SSD1306_Transport_t ssd1306_SPI = {
+    .Init = ssd1306_SpiInit,
+    .Reset = ssd1306_SpiReset,
+    .WriteCommands = ssd1306_SpiWriteCommands,
+    .WriteData = ssd1306_SpiWriteData,
+    .Flush = ssd1306_SpiFlush,
+    .Busy = ssd1306_SpiPending,
+};
@@ -0,0 +1,186 @@
+/*
+ * tea5767.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "tea5767.h"
+#include "prof.h"
+#include "trace.h"
+#include "i2c_bus.h"
+
+extern I2C_HandleTypeDef TEA5767_I2C_PORT;
+
+static TEA5767_Cache_t cache;
+static TEA5767_Stats_t stats;
+static uint32_t statusIntervalMs = TEA5767_STATUS_INTERVAL_MS;
+static Bus_Job_t statusJob;             // background status read
+static uint8_t statusRegs[TEA5767_REG_COUNT];
+static HAL_StatusTypeDef statusResult = HAL_OK;     // how the last read went
+
+HAL_StatusTypeDef TEA5767_Write(const uint8_t regs[TEA5767_REG_COUNT]) {
+	HAL_StatusTypeDef result;
+	uint16_t len = TEA5767_REG_COUNT;
+
+	if (cache.regsValid && !(regs[0] & TEA5767_SM)) {
+		// Search mode writes always go out since they restart the search
+		while (len > 0 && regs[len - 1] == cache.regs[len - 1]) {
+			len--;
+		}
+		if (len == 0) {
+			stats.writesSkipped++;
+			return HAL_OK;
+		}
+	}
+	// A status read queued before the tune would land in the cache after it
+	Bus_Finish(&statusJob);
+	Trace_Event(TRACE_I2C_START, (TRACE_DEV_RADIO << 16) | len);
+	PROF_BEGIN(PROF_RADIO_I2C);
+	result = Bus_Transmit(BUS_RADIO, TEA5767_I2C_ADDR, regs, len);
+	PROF_END(PROF_RADIO_I2C);
+	Trace_Event(TRACE_I2C_END, (TRACE_DEV_RADIO << 16) | result);
+	stats.writes++;
+	if (result != HAL_OK) {
+		stats.errors++;
+		cache.regsValid = false;
+		return result;
+	}
+	stats.writeBytes += len;
+	memcpy(cache.regs, regs, TEA5767_REG_COUNT);
+	cache.regsValid = true;
+	cache.writeTick = HAL_GetTick();
+	// Tuning changes everything the status registers report
+	cache.statusValid = false;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef TEA5767_Read(uint8_t regs[TEA5767_REG_COUNT]) {
+	HAL_StatusTypeDef result;
+
+	Trace_Event(TRACE_I2C_START, (TRACE_DEV_RADIO << 16) | TEA5767_REG_COUNT);
+	PROF_BEGIN(PROF_RADIO_I2C);
+	result = Bus_Receive(BUS_RADIO, TEA5767_I2C_ADDR | 0x01, regs, TEA5767_REG_COUNT);
+	PROF_END(PROF_RADIO_I2C);
+	Trace_Event(TRACE_I2C_END, (TRACE_DEV_RADIO << 16) | result);
+	stats.reads++;
+	statusResult = result;
+	if (result != HAL_OK) {
+		stats.errors++;
+		return result;
+	}
+	TEA5767_Decode(regs, &cache.status);
+	cache.statusValid = true;
+	cache.statusTick = HAL_GetTick();
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef TEA5767_SetFrequency(uint16_t freq, bool mute, bool searchUp, bool searchMode) {
+	uint8_t txbuf[TEA5767_REG_COUNT];
+
+	TEA5767_Encode(txbuf, freq, mute, searchUp, searchMode);
+	return TEA5767_Write(txbuf);
+}
+
+/*
+ * Flips only the mute bit of the current tuning; a one byte transfer.
+ * While a search runs the shadow holds its start PLL with SM set, and
+ * rewriting those would restart it, so that is HAL_BUSY.
+ */
+HAL_StatusTypeDef TEA5767_SetMute(bool mute) {
+	uint8_t txbuf[TEA5767_REG_COUNT];
+
+	if (!cache.regsValid) {
+		return HAL_ERROR;
+	}
+	if (cache.regs[0] & TEA5767_SM) {
+		return HAL_BUSY;
+	}
+	memcpy(txbuf, cache.regs, TEA5767_REG_COUNT);
+	txbuf[0] &= ~TEA5767_MUTE;
+	if (mute) {
+		txbuf[0] |= TEA5767_MUTE;
+	}
+	return TEA5767_Write(txbuf);
+}
+
+// Always reads the chip
+HAL_StatusTypeDef TEA5767_ReadStatus(TEA5767_Status_t* status) {
+	uint8_t rxbuf[TEA5767_REG_COUNT];
+	HAL_StatusTypeDef result;
+
+	result = TEA5767_Read(rxbuf);
+	if (result != HAL_OK) {
+		return result;
+	}
+	*status = cache.status;
+	return HAL_OK;
+}
+
+// Reads the chip only when the cached status is older than the interval
+HAL_StatusTypeDef TEA5767_PollStatus(TEA5767_Status_t* status) {
+	if (cache.statusValid && (uint32_t)(HAL_GetTick() - cache.statusTick) < statusIntervalMs) {
+		stats.readsCached++;
+		*status = cache.status;
+		return HAL_OK;
+	}
+	return TEA5767_ReadStatus(status);
+}
+
+// Bus_Task runs this once a background read is through
+static void TEA5767StatusDone(Bus_Job_t* job) {
+	Trace_Event(TRACE_I2C_END, (TRACE_DEV_RADIO << 16) | job->status);
+	stats.reads++;
+	statusResult = job->status;
+	if (job->status != HAL_OK) {
+		stats.errors++;
+		return;
+	}
+	TEA5767_Decode(statusRegs, &cache.status);
+	cache.statusValid = true;
+	cache.statusTick = HAL_GetTick();
+}
+
+// Hands back the cached status without touching the bus and, when it is
+// older than the interval, queues a read behind the UI traffic for a later
+// call. Only waits when there is no status at all yet, at start or after a
+// tune. Returns how the last read went.
+HAL_StatusTypeDef TEA5767_PollStatusAsync(TEA5767_Status_t* status) {
+	if (cache.statusValid && (uint32_t)(HAL_GetTick() - cache.statusTick) < statusIntervalMs) {
+		stats.readsCached++;
+	}
+	else if (!Bus_JobPending(&statusJob)) {
+		statusJob.op = BUS_OP_RX;
+		statusJob.addr = TEA5767_I2C_ADDR | 0x01;
+		statusJob.data = statusRegs;
+		statusJob.len = TEA5767_REG_COUNT;
+		statusJob.done = TEA5767StatusDone;
+		Trace_Event(TRACE_I2C_START, (TRACE_DEV_RADIO << 16) | TEA5767_REG_COUNT);
+		Bus_Submit(BUS_RADIO, BUS_PRIO_BACKGROUND, &statusJob);
+	}
+	if (!cache.statusValid) {
+		Bus_Finish(&statusJob);
+		if (!cache.statusValid) {
+			return statusResult;
+		}
+	}
+	*status = cache.status;
+	return statusResult;
+}
+
+void TEA5767_SetStatusInterval(uint32_t intervalMs) {
+	statusIntervalMs = intervalMs;
+}
+
+const TEA5767_Cache_t* TEA5767_GetCache(void) {
+	return &cache;
+}
+
+const TEA5767_Stats_t* TEA5767_GetStats(void) {
+	return &stats;
+}
+
+void TEA5767_ResetStats(void) {
+	memset(&stats, 0, sizeof(stats));
+}
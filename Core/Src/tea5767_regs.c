@@ -0,0 +1,72 @@
+/*
+ * tea5767_regs.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "tea5767_regs.h"
+
+static bool bandJapan = false;
+
+// Selects the 76-91 MHz band limits for every subsequent write
+void TEA5767_SetBandJapan(bool japan) {
+	bandJapan = japan;
+}
+
+bool TEA5767_GetBandJapan(void) {
+	return bandJapan;
+}
+
+// Limits a frequency to the selected band, e.g. a failed read's 0
+uint16_t TEA5767_ClampFreq(uint16_t freq) {
+	uint16_t min = bandJapan ? TEA5767_FREQ_JP_MIN : TEA5767_FREQ_MIN;
+	uint16_t max = bandJapan ? TEA5767_FREQ_JP_MAX : TEA5767_FREQ_MAX;
+
+	if (freq < min) {
+		return min;
+	}
+	return (freq > max) ? max : freq;
+}
+
+// Inverse of TEA5767_PLL, rounded to the nearest 100 kHz channel
+uint16_t TEA5767_PllToFreq(uint16_t pll) {
+	uint32_t hz = (uint32_t)pll * TEA5767_PLL_STEP_HZ;
+	uint32_t ifHz = TEA5767_IF_KHZ * 1000u;
+
+	if (hz <= ifHz) {
+		return 0;
+	}
+	return (uint16_t)(((hz - ifHz + 50000u) / 100000u) * TEA5767_FREQ_STEP);
+}
+
+void TEA5767_Encode(uint8_t regs[TEA5767_REG_COUNT], uint16_t freq, bool mute, bool searchUp, bool searchMode) {
+	uint16_t pll = TEA5767_PLL(freq);
+
+	regs[0] = (pll >> 8) & 0x3F;
+	if (mute) {
+		regs[0] |= TEA5767_MUTE;
+	}
+	if (searchMode) {
+		regs[0] |= TEA5767_SM;
+	}
+	regs[1] = pll & 0xFF;
+	regs[2] = TEA5767_SSL_LOW | TEA5767_HLSI | TEA5767_MS;
+	if (searchUp) {
+		regs[2] |= TEA5767_SUD;
+	}
+	regs[3] = TEA5767_XTAL | TEA5767_HCC;
+	if (bandJapan) {
+		regs[3] |= TEA5767_BL;
+	}
+	regs[4] = TEA5767_DTC;
+}
+
+void TEA5767_Decode(const uint8_t regs[TEA5767_REG_COUNT], TEA5767_Status_t* status) {
+	status->pll = ((regs[0] & 0x3F) << 8) | regs[1];
+	status->freq = TEA5767_PllToFreq(status->pll);
+	status->ready = (regs[0] & TEA5767_RF) != 0;
+	status->bandLimit = (regs[0] & TEA5767_BLF) != 0;
+	status->stereo = (regs[2] & TEA5767_STEREO) != 0;
+	status->level = (regs[3] & 0xF0) >> 4;
+}
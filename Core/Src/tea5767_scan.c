@@ -0,0 +1,193 @@
+/*
+ * tea5767_scan.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "tea5767_scan.h"
+
+static const Seek_Bus_t* scanBus;
+static Scan_Station_t scanStations[SCAN_MAX_STATIONS];
+static uint8_t scanCount = 0;
+// The sweep collects here and only replaces the presets when it completes
+static Scan_Station_t scanFound[SCAN_MAX_STATIONS];
+static uint8_t scanFoundCount;
+
+static bool scanRunning = false;
+static uint16_t scanBandMax;
+static uint16_t scanRestoreFreq;
+static bool scanRestoreMute;
+static uint32_t scanStartMs;
+static uint32_t scanElapsedMs = 0;
+
+void Scan_Init(const Seek_Bus_t* bus) {
+	scanBus = bus;
+	scanCount = 0;
+	scanRunning = false;
+}
+
+static void ScanAdd(const Seek_Event_t* event) {
+	int i = scanFoundCount;
+
+	if (scanFoundCount >= SCAN_MAX_STATIONS) {
+		return;
+	}
+	// Seeks run upwards so this is normally an append
+	while (i > 0 && scanFound[i - 1].freq >= event->freq) {
+		if (scanFound[i - 1].freq == event->freq) {
+			return;
+		}
+		i--;
+	}
+	memmove(&scanFound[i + 1], &scanFound[i], (scanFoundCount - i) * sizeof(Scan_Station_t));
+	scanFound[i].freq = event->freq;
+	scanFound[i].level = event->level;
+	scanFound[i].stereo = event->stereo;
+	scanFoundCount++;
+}
+
+// Returns the receiver to where it was; a complete sweep becomes the presets
+static bool ScanFinish(bool complete, uint32_t nowMs) {
+	uint8_t regs[TEA5767_REG_COUNT];
+
+	scanRunning = false;
+	TEA5767_Encode(regs, scanRestoreFreq, scanRestoreMute, false, false);
+	scanBus->write(regs);
+	if (!complete) {
+		return false;
+	}
+	memcpy(scanStations, scanFound, scanFoundCount * sizeof(Scan_Station_t));
+	scanCount = scanFoundCount;
+	scanElapsedMs = nowMs - scanStartMs;
+	return true;
+}
+
+/*
+ * Starts a muted sweep of the whole band from its lower edge. When it
+ * ends the receiver goes back to restoreFreq; the presets are only
+ * replaced if it reached the top of the band.
+ */
+bool Scan_Start(uint16_t restoreFreq, bool restoreMute, uint32_t nowMs) {
+	uint16_t bandMin = TEA5767_GetBandJapan() ? TEA5767_FREQ_JP_MIN : TEA5767_FREQ_MIN;
+
+	if (scanBus == NULL || scanRunning || Seek_Busy()) {
+		return false;
+	}
+	scanBandMax = TEA5767_GetBandJapan() ? TEA5767_FREQ_JP_MAX : TEA5767_FREQ_MAX;
+	scanRestoreFreq = restoreFreq;
+	scanRestoreMute = restoreMute;
+	scanStartMs = nowMs;
+	scanFoundCount = 0;
+	// Seek_Start begins one step above its argument, so start below the band
+	if (!Seek_Start(bandMin - TEA5767_FREQ_STEP, true, true, nowMs)) {
+		return false;
+	}
+	scanRunning = true;
+	return true;
+}
+
+bool Scan_Busy(void) {
+	return scanRunning;
+}
+
+/*
+ * Feed every event from Seek_Poll here while Scan_Busy(). Returns true
+ * when the sweep has completed and replaced the presets, so they can be
+ * saved; a sweep cut short by a timeout or bus error keeps the old ones.
+ */
+bool Scan_SeekDone(const Seek_Event_t* event, uint32_t nowMs) {
+	if (!scanRunning) {
+		return false;
+	}
+	if (event->type == SEEK_EVT_BAND_LIMIT) {
+		return ScanFinish(true, nowMs);
+	}
+	if (event->type != SEEK_EVT_FOUND) {
+		return ScanFinish(false, nowMs);
+	}
+	ScanAdd(event);
+	if (event->freq >= scanBandMax) {
+		return ScanFinish(true, nowMs);
+	}
+	if (!Seek_Start(event->freq, true, true, nowMs)) {
+		return ScanFinish(false, nowMs);
+	}
+	return false;
+}
+
+// Restores a table saved from an earlier sweep; must already be sorted
+void Scan_Load(const Scan_Station_t* stations, uint8_t count) {
+	if (scanRunning) {
+		return;
+	}
+	if (count > SCAN_MAX_STATIONS) {
+		count = SCAN_MAX_STATIONS;
+	}
+	memcpy(scanStations, stations, count * sizeof(Scan_Station_t));
+	scanCount = count;
+}
+
+// Forgets the presets, e.g. when the band changes under them
+void Scan_Clear(void) {
+	if (!scanRunning) {
+		scanCount = 0;
+	}
+}
+
+uint8_t Scan_Count(void) {
+	return scanCount;
+}
+
+const Scan_Station_t* Scan_Station(uint8_t index) {
+	return (index < scanCount) ? &scanStations[index] : NULL;
+}
+
+// Index of the preset on freq, or -1
+int Scan_Find(uint16_t freq) {
+	int lo = 0;
+	int hi = scanCount - 1;
+
+	while (lo <= hi) {
+		int mid = (lo + hi) / 2;
+		if (scanStations[mid].freq == freq) {
+			return mid;
+		}
+		if (scanStations[mid].freq < freq) {
+			lo = mid + 1;
+		}
+		else {
+			hi = mid - 1;
+		}
+	}
+	return -1;
+}
+
+// Index of the nearest preset strictly above/below freq, wrapping around the band
+int Scan_Next(uint16_t freq, bool up) {
+	int i;
+
+	if (scanCount == 0) {
+		return -1;
+	}
+	if (up) {
+		for (i = 0; i < scanCount; i++) {
+			if (scanStations[i].freq > freq) {
+				return i;
+			}
+		}
+		return 0;
+	}
+	for (i = scanCount - 1; i >= 0; i--) {
+		if (scanStations[i].freq < freq) {
+			return i;
+		}
+	}
+	return scanCount - 1;
+}
+
+// Duration of the last completed sweep
+uint32_t Scan_ElapsedMs(void) {
+	return scanElapsedMs;
+}
@@ -0,0 +1,127 @@
+/*
+ * tea5767_seek.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "tea5767_seek.h"
+
+static const Seek_Bus_t* seekBus;
+static uint16_t seekPollMs = SEEK_POLL_MS;
+static uint32_t seekTimeoutMs = SEEK_TIMEOUT_MS;
+
+static bool seekRunning = false;
+static bool seekMute = false;
+static uint16_t seekFreq = 0;
+static uint32_t seekStartMs = 0;
+static uint32_t seekLastPollMs = 0;
+static Seek_Event_t seekLastEvent;
+
+void Seek_Init(const Seek_Bus_t* bus, uint16_t pollMs, uint32_t timeoutMs) {
+	seekBus = bus;
+	seekPollMs = pollMs;
+	seekTimeoutMs = timeoutMs;
+	seekRunning = false;
+}
+
+/*
+ * Starts a search one step beyond fromFreq, kept inside the band so a
+ * failed status read's 0 does not wrap. False if there is no bus, a seek
+ * is already running (cancel it first) or the write fails.
+ */
+bool Seek_Start(uint16_t fromFreq, bool searchUp, bool mute, uint32_t nowMs) {
+	uint8_t regs[TEA5767_REG_COUNT];
+	int32_t startFreq = searchUp ? fromFreq + TEA5767_FREQ_STEP : fromFreq - TEA5767_FREQ_STEP;
+
+	if (seekBus == NULL || seekRunning) {
+		return false;
+	}
+	startFreq = TEA5767_ClampFreq(startFreq < 0 ? 0 : (uint16_t)startFreq);
+	TEA5767_Encode(regs, (uint16_t)startFreq, mute, searchUp, true);
+	if (seekBus->write(regs) != 0) {
+		return false;
+	}
+	seekRunning = true;
+	seekMute = mute;
+	seekFreq = TEA5767_ClampFreq(fromFreq);
+	seekStartMs = nowMs;
+	seekLastPollMs = nowMs;
+	return true;
+}
+
+// False if the write that parks the chip failed; it may still be searching
+bool Seek_Cancel(void) {
+	uint8_t regs[TEA5767_REG_COUNT];
+
+	if (!seekRunning) {
+		return true;
+	}
+	seekRunning = false;
+	TEA5767_Encode(regs, seekFreq, seekMute, false, false);
+	return seekBus->write(regs) == 0;
+}
+
+bool Seek_Busy(void) {
+	return seekRunning;
+}
+
+// Frequency the search is currently passing, useful for a live readout
+uint16_t Seek_CurrentFreq(void) {
+	return seekFreq;
+}
+
+static void SeekFinish(Seek_EventType_t type, const TEA5767_Status_t* status, uint32_t nowMs, Seek_Event_t* event) {
+	uint8_t regs[TEA5767_REG_COUNT];
+
+	seekRunning = false;
+	seekLastEvent.type = type;
+	seekLastEvent.freq = seekFreq;
+	seekLastEvent.level = status ? status->level : 0;
+	seekLastEvent.stereo = status ? status->stereo : false;
+	seekLastEvent.latencyMs = nowMs - seekStartMs;
+	if (type != SEEK_EVT_ERROR) {
+		// Leave search mode parked on the frequency we ended on; if that
+		// write fails the chip is still searching, so it is an error
+		TEA5767_Encode(regs, seekFreq, seekMute, false, false);
+		if (seekBus->write(regs) != 0) {
+			seekLastEvent.type = SEEK_EVT_ERROR;
+		}
+	}
+	if (event) {
+		*event = seekLastEvent;
+	}
+}
+
+/*
+ * Call every main loop pass. Reads the status registers at most once per
+ * poll period and returns true with *event filled in when the seek ends.
+ */
+bool Seek_Poll(uint32_t nowMs, Seek_Event_t* event) {
+	uint8_t regs[TEA5767_REG_COUNT];
+	TEA5767_Status_t status;
+
+	if (!seekRunning || (uint32_t)(nowMs - seekLastPollMs) < seekPollMs) {
+		return false;
+	}
+	seekLastPollMs = nowMs;
+	if (seekBus->read(regs) != 0) {
+		SeekFinish(SEEK_EVT_ERROR, NULL, nowMs, event);
+		return true;
+	}
+	TEA5767_Decode(regs, &status);
+	seekFreq = status.freq;
+	if (status.ready) {
+		SeekFinish(status.bandLimit ? SEEK_EVT_BAND_LIMIT : SEEK_EVT_FOUND, &status, nowMs, event);
+		return true;
+	}
+	if ((uint32_t)(nowMs - seekStartMs) >= seekTimeoutMs) {
+		SeekFinish(SEEK_EVT_TIMEOUT, &status, nowMs, event);
+		return true;
+	}
+	return false;
+}
+
+const Seek_Event_t* Seek_LastEvent(void) {
+	return &seekLastEvent;
+}
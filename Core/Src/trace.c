@@ -0,0 +1,98 @@
+/*
+ * trace.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include "trace.h"
+
+#if TRACE_ENABLE
+
+#include "stm32l4xx.h"
+
+#define TRACE_PORTS             ((1u << TRACE_PORT_TIME) | (1u << TRACE_PORT_EVENT))
+
+static uint32_t traceCycles;    // cycle count the time stamp was last folded at
+static uint32_t traceUs;
+
+// Folds the cycles run since the last call into the time stamp; interrupts masked
+static uint32_t TraceNowUs(void) {
+	uint32_t perUs = SystemCoreClock / 1000000u;
+	uint32_t us = (DWT->CYCCNT - traceCycles) / perUs;
+
+	traceUs += us;
+	traceCycles += us * perUs;
+	return traceUs;
+}
+
+static void TracePut(uint8_t port, uint32_t value) {
+	// Reads back 0 while the stimulus FIFO is full
+	while (ITM->PORT[port].u32 == 0) {
+	}
+	ITM->PORT[port].u32 = value;
+}
+
+// SWO is NRZ at TRACE_SWO_HZ from the core clock, formatter bypassed
+static void TraceSwoPrescaler(void) {
+	TPI->ACPR = SystemCoreClock / TRACE_SWO_HZ - 1;
+}
+
+void Trace_Init(void) {
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	// PB3 keeps its reset function, TRACESWO, as long as the debug port drives it
+	MODIFY_REG(DBGMCU->CR, DBGMCU_CR_TRACE_MODE, DBGMCU_CR_TRACE_IOEN);
+	TPI->SPPR = 2;
+	TPI->FFCR = TPI_FFCR_TrigIn_Msk;
+	TraceSwoPrescaler();
+	ITM->LAR = 0xC5ACCE55u;
+	ITM->TCR = (1u << ITM_TCR_TraceBusID_Pos) | ITM_TCR_SWOENA_Msk | ITM_TCR_ITMENA_Msk;
+	ITM->TPR = 0;
+	ITM->TER |= TRACE_PORTS;
+	traceCycles = DWT->CYCCNT;
+	traceUs = 0;
+}
+
+void Trace_Event(Trace_Id_t id, uint32_t payload) {
+	uint32_t primask;
+
+	// A debugger can switch the ports off; then the event is not worth the stamp
+	if ((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0 || (ITM->TER & TRACE_PORTS) != TRACE_PORTS) {
+		return;
+	}
+	primask = __get_PRIMASK();
+	__disable_irq();
+	TracePut(TRACE_PORT_TIME, TraceNowUs());
+	TracePut(TRACE_PORT_EVENT, ((uint32_t)id << 24) | (payload & 0x00FFFFFFu));
+	__set_PRIMASK(primask);
+}
+
+// Before a clock switch: charges the cycles so far at the old frequency
+void Trace_Sync(void) {
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	TraceNowUs();
+	__set_PRIMASK(primask);
+}
+
+// After a clock switch. The cycles of the switch itself count at the new
+// frequency, which is off by at most the switch time.
+void Trace_ClockChanged(void) {
+	TraceSwoPrescaler();
+	Trace_Event(TRACE_CLOCK, SystemCoreClock / 1000u);
+}
+
+// After Stop 2, with the time slept from the RTC
+void Trace_Wake(uint32_t stopMs) {
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	TraceNowUs();
+	traceUs += stopMs * 1000u;
+	__set_PRIMASK(primask);
+	Trace_Event(TRACE_WAKE, stopMs);
+}
+
+#endif /* TRACE_ENABLE */
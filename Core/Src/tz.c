@@ -0,0 +1,230 @@
+/*
+ * tz.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <stddef.h>
+#include "tz.h"
+#include "calendar.h"
+
+#define TZ_HOUR                 3600u
+#define TZ_NEVER                0xFFFFFFFFu
+
+static uint32_t tzNext = TZ_NEVER;
+static TZ_Change_t tzNextChange = TZ_NONE;
+
+static bool TzAlpha(char c) {
+	return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+static bool TzDigit(char c) {
+	return c >= '0' && c <= '9';
+}
+
+// Unsigned decimal of at most maxDigits digits
+static const char* TzNumber(const char* p, uint32_t* value, uint8_t maxDigits) {
+	uint8_t n = 0;
+
+	*value = 0;
+	while (TzDigit(*p) && n < maxDigits) {
+		*value = *value * 10 + (uint32_t)(*p++ - '0');
+		n++;
+	}
+	return (n > 0) ? p : NULL;
+}
+
+// Zone abbreviation, either 3+ letters or <...> quoted
+static const char* TzName(const char* p) {
+	const char* begin;
+
+	if (*p == '<') {
+		while (*p && *p != '>') {
+			p++;
+		}
+		return (*p == '>') ? p + 1 : NULL;
+	}
+	begin = p;
+	while (TzAlpha(*p)) {
+		p++;
+	}
+	return (p - begin >= 3) ? p : NULL;
+}
+
+// hh[:mm[:ss]] in seconds
+static const char* TzTime(const char* p, uint32_t* seconds) {
+	uint32_t v;
+
+	p = TzNumber(p, &v, 3);
+	if (p == NULL) {
+		return NULL;
+	}
+	*seconds = v * TZ_HOUR;
+	if (*p == ':') {
+		p = TzNumber(p + 1, &v, 2);
+		if (p == NULL || v > 59) {
+			return NULL;
+		}
+		*seconds += v * 60u;
+		if (*p == ':') {
+			p = TzNumber(p + 1, &v, 2);
+			if (p == NULL || v > 59) {
+				return NULL;
+			}
+			*seconds += v;
+		}
+	}
+	return p;
+}
+
+// [+-]hh[:mm[:ss]], POSIX counts west of UTC as positive
+static const char* TzOffset(const char* p, int32_t* minutesEast) {
+	int32_t sign = -1;
+	uint32_t seconds;
+
+	if (*p == '+' || *p == '-') {
+		sign = (*p == '-') ? 1 : -1;
+		p++;
+	}
+	p = TzTime(p, &seconds);
+	if (p == NULL || seconds > 24 * TZ_HOUR) {
+		return NULL;
+	}
+	*minutesEast = sign * (int32_t)(seconds / 60u);
+	return p;
+}
+
+// ,Mm.w.d[/time]; Julian day forms are not supported
+static const char* TzRule(const char* p, TZ_Rule_t* rule) {
+	uint32_t month, week, day;
+
+	if (p[0] != ',' || p[1] != 'M') {
+		return NULL;
+	}
+	p = TzNumber(p + 2, &month, 2);
+	if (p == NULL || *p != '.' || month < 1 || month > 12) {
+		return NULL;
+	}
+	p = TzNumber(p + 1, &week, 1);
+	if (p == NULL || *p != '.' || week < 1 || week > 5) {
+		return NULL;
+	}
+	p = TzNumber(p + 1, &day, 1);
+	if (p == NULL || day > 6) {
+		return NULL;
+	}
+	rule->month = (uint8_t)month;
+	rule->week = (uint8_t)week;
+	rule->weekday = (day == 0) ? 7 : (uint8_t)day;   // POSIX weekdays start on Sunday
+	rule->time = 2 * TZ_HOUR;
+	if (*p == '/') {
+		p = TzTime(p + 1, &rule->time);
+		if (p == NULL || rule->time >= CAL_SECONDS_PER_DAY) {
+			return NULL;
+		}
+	}
+	return p;
+}
+
+bool TZ_Parse(const char* spec, TZ_Zone_t* zone) {
+	const char* p = TzName(spec);
+	int32_t offset;
+	int32_t dstOffset;
+
+	if (p == NULL || (p = TzOffset(p, &offset)) == NULL) {
+		return false;
+	}
+	zone->offsetMin = (int16_t)offset;
+	zone->hasDst = false;
+	if (*p == '\0') {
+		return true;
+	}
+	p = TzName(p);
+	if (p == NULL) {
+		return false;
+	}
+	if (*p != ',' && *p != '\0') {
+		p = TzOffset(p, &dstOffset);
+		// The RTC can only move the clock by one hour
+		if (p == NULL || dstOffset != offset + 60) {
+			return false;
+		}
+	}
+	p = TzRule(p, &zone->start);
+	if (p == NULL) {
+		return false;
+	}
+	p = TzRule(p, &zone->end);
+	if (p == NULL || *p != '\0') {
+		return false;
+	}
+	zone->hasDst = true;
+	return true;
+}
+
+// Wall time of the change in the given year, in the time in force before it
+uint32_t TZ_Transition(const TZ_Zone_t* zone, uint8_t year, bool start) {
+	const TZ_Rule_t* rule = start ? &zone->start : &zone->end;
+	uint8_t first = Cal_Weekday(year, rule->month, 1);
+	uint8_t date = 1 + (rule->weekday + 7 - first) % 7 + (rule->week - 1) * 7;
+
+	if (date > Cal_DaysInMonth(year, rule->month)) {
+		date -= 7;
+	}
+	return Cal_Days(year, rule->month, date) * CAL_SECONDS_PER_DAY + rule->time;
+}
+
+// Whether wall should be daylight time. The hour repeated after the
+// change back reads as standard or daylight time depending on dstNow.
+bool TZ_IsDst(const TZ_Zone_t* zone, uint32_t wall, bool dstNow) {
+	Cal_DateTime_t dt;
+	uint32_t start, end;
+	bool dst;
+
+	if (zone == NULL || !zone->hasDst) {
+		return false;
+	}
+	Cal_FromSeconds(wall, &dt);
+	start = TZ_Transition(zone, dt.year, true);
+	end = TZ_Transition(zone, dt.year, false);
+	dst = (start < end) ? (wall >= start && wall < end) : (wall >= start || wall < end);
+	if (!dstNow && wall < end && wall + TZ_HOUR >= end) {
+		dst = false;
+	}
+	return dst;
+}
+
+// Caches the next change for TZ_Check. A clock that is on the wrong side
+// of a change, e.g. one that slept through it, is due a change at once.
+void TZ_Sync(const TZ_Zone_t* zone, uint32_t wall, bool dstNow) {
+	Cal_DateTime_t dt;
+	uint32_t next;
+
+	tzNext = TZ_NEVER;
+	tzNextChange = dstNow ? TZ_SUB_HOUR : TZ_ADD_HOUR;
+	if (zone == NULL || !zone->hasDst) {
+		tzNextChange = dstNow ? TZ_SUB_HOUR : TZ_NONE;
+		tzNext = dstNow ? wall : TZ_NEVER;
+		return;
+	}
+	if (TZ_IsDst(zone, wall, dstNow) != dstNow) {
+		tzNext = wall;
+		return;
+	}
+	Cal_FromSeconds(wall, &dt);
+	next = TZ_Transition(zone, dt.year, !dstNow);
+	if (next <= wall) {
+		next = (dt.year < 99) ? TZ_Transition(zone, dt.year + 1, !dstNow) : TZ_NEVER;
+	}
+	tzNext = next;
+}
+
+// Call once a minute with the wall time
+TZ_Change_t TZ_Check(uint32_t wall) {
+	return (wall >= tzNext) ? tzNextChange : TZ_NONE;
+}
+
+uint32_t TZ_Next(void) {
+	return tzNext;
+}
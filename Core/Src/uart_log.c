@@ -0,0 +1,278 @@
+/*
+ * uart_log.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "uart_log.h"
+#include "fmt.h"
+
+#define LOG_RING_MASK           (LOG_RING_SIZE - 1u)
+#define LOG_EVENT_MASK          (LOG_EVENTS - 1u)
+
+typedef struct {
+	uint32_t tick;
+	uint32_t args[3];
+	uint8_t id;
+} Log_Record_t;
+
+extern UART_HandleTypeDef huart2;
+
+static DMA_HandleTypeDef hdmaTx;
+static char ring[LOG_RING_SIZE];
+static volatile uint32_t head;              // written by the producer only
+static volatile uint32_t tail;              // written by the UART interrupt only
+static volatile uint16_t chunk;             // bytes in flight, 0 when idle
+static volatile bool held;
+static Log_Record_t events[LOG_EVENTS];
+static volatile uint32_t eventHead;
+static uint32_t eventTail;
+static const char* const* logFormats;
+static uint8_t logFormatCount;
+static Log_Stats_t stats;
+
+// Starts the next transfer if the line is free; runs in the UART interrupt
+// or from thread context with that interrupt masked
+static void LogKick(void) {
+	uint32_t t = tail;
+	uint32_t len = head - t;
+	uint32_t start = t & LOG_RING_MASK;
+
+	if (chunk != 0 || held || len == 0) {
+		return;
+	}
+	if (len > LOG_RING_SIZE - start) {
+		len = LOG_RING_SIZE - start;
+	}
+	if (len > LOG_DMA_CHUNK) {
+		len = LOG_DMA_CHUNK;
+	}
+	chunk = len;
+	if (HAL_UART_Transmit_DMA(&huart2, (uint8_t*)&ring[start], len) != HAL_OK) {
+		chunk = 0;
+	}
+}
+
+static void LogKickFromThread(void) {
+	HAL_NVIC_DisableIRQ(USART2_IRQn);
+	LogKick();
+	HAL_NVIC_EnableIRQ(USART2_IRQn);
+}
+
+void Log_Init(const char* const* formats, uint8_t count) {
+	logFormats = formats;
+	logFormatCount = count;
+	__HAL_RCC_DMA1_CLK_ENABLE();
+	hdmaTx.Instance = DMA1_Channel7;
+	hdmaTx.Init.Request = DMA_REQUEST_2;
+	hdmaTx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdmaTx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdmaTx.Init.MemInc = DMA_MINC_ENABLE;
+	hdmaTx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+	hdmaTx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+	hdmaTx.Init.Mode = DMA_NORMAL;
+	hdmaTx.Init.Priority = DMA_PRIORITY_LOW;
+	if (HAL_DMA_Init(&hdmaTx) != HAL_OK) {
+		return;
+	}
+	__HAL_LINKDMA(&huart2, hdmatx, hdmaTx);
+	HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 3, 0);
+	HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+	HAL_NVIC_SetPriority(USART2_IRQn, 3, 0);
+	HAL_NVIC_EnableIRQ(USART2_IRQn);
+}
+
+bool Log_Write(const char* text, uint16_t len) {
+	uint32_t h = head;
+	uint32_t used = h - tail;
+	uint32_t start = h & LOG_RING_MASK;
+	uint32_t first;
+
+	if (len > LOG_RING_SIZE - used) {
+		stats.dropped++;
+		return false;
+	}
+	first = (len < LOG_RING_SIZE - start) ? len : LOG_RING_SIZE - start;
+	memcpy(&ring[start], text, first);
+	memcpy(&ring[0], text + first, len - first);
+	// Publish the bytes only once they are in place
+	__DMB();
+	head = h + len;
+	stats.bytes += len;
+	if (used + len > stats.peak) {
+		stats.peak = used + len;
+	}
+	LogKickFromThread();
+	return true;
+}
+
+bool Log_Str(const char* text) {
+	return Log_Write(text, strlen(text));
+}
+
+// Waits for room instead of dropping; not for hot paths
+void Log_WriteWait(const char* text, uint16_t len) {
+	if (len > LOG_RING_SIZE) {
+		len = LOG_RING_SIZE;
+	}
+	while (len > LOG_RING_SIZE - (head - tail)) {
+		// Retries a transfer that failed to start
+		LogKickFromThread();
+	}
+	Log_Write(text, len);
+}
+
+void Log_Drain(void) {
+	while (head != tail) {
+		LogKickFromThread();
+	}
+}
+
+void Log_Event(uint8_t id, uint32_t a, uint32_t b, uint32_t c) {
+	uint32_t h = eventHead;
+	Log_Record_t* r;
+
+	if (h - eventTail >= LOG_EVENTS) {
+		stats.eventsDropped++;
+		return;
+	}
+	r = &events[h & LOG_EVENT_MASK];
+	r->tick = HAL_GetTick();
+	r->args[0] = a;
+	r->args[1] = b;
+	r->args[2] = c;
+	r->id = id;
+	eventHead = h + 1;
+}
+
+static char* LogHex(char* dst, uint32_t value) {
+	int shift = 28;
+
+	while (shift > 0 && (value >> shift) == 0) {
+		shift -= 4;
+	}
+	for (; shift >= 0; shift -= 4) {
+		*dst++ = "0123456789abcdef"[(value >> shift) & 0xF];
+	}
+	*dst = '\0';
+	return dst;
+}
+
+// "[tick] " and the event's format with its arguments, e.g. "[81234] seek 9810 level 7\r\n"
+static uint16_t LogFormat(const Log_Record_t* r, char* line) {
+	const char* f = (r->id < logFormatCount) ? logFormats[r->id] : "event %u";
+	const uint32_t* arg = r->args;
+	uint32_t unknownId = r->id;
+	uint8_t left = 3;
+	char* end = line + LOG_LINE_MAX - 16;
+	char* p;
+
+	p = Fmt_Char(Fmt_UDec(Fmt_Char(line, '['), r->tick), ']');
+	p = Fmt_Char(p, ' ');
+	if (r->id >= logFormatCount) {
+		arg = &unknownId;
+		left = 1;
+	}
+	for (; *f != '\0' && p < end; f++) {
+		if (*f != '%' || f[1] == '\0') {
+			*p++ = *f;
+			continue;
+		}
+		f++;
+		if (*f != '%' && left == 0) {
+			// More conversions than an event carries
+			*p++ = '?';
+			continue;
+		}
+		switch (*f) {
+			case 'u':
+				p = Fmt_UDec(p, *arg++);
+				left--;
+				break;
+			case 'd':
+				p = Fmt_IDec(p, (int32_t)*arg++);
+				left--;
+				break;
+			case 'x':
+				p = LogHex(p, *arg++);
+				left--;
+				break;
+			case 'c':
+				*p++ = (char)*arg++;
+				left--;
+				break;
+			default:
+				*p++ = *f;
+				break;
+		}
+	}
+	p = Fmt_Str(p, "\r\n");
+	return p - line;
+}
+
+// Call from the main loop; formats queued events while the ring has room
+void Log_Task(void) {
+	char line[LOG_LINE_MAX];
+
+	while (eventTail != eventHead) {
+		uint16_t len = LogFormat(&events[eventTail & LOG_EVENT_MASK], line);
+		if (len > LOG_RING_SIZE - (head - tail)) {
+			// Leave it queued until the DMA has made room
+			break;
+		}
+		Log_Write(line, len);
+		eventTail++;
+	}
+}
+
+// Holds off new transfers and waits out the one in flight, for a baud rate change
+void Log_Hold(bool hold) {
+	held = hold;
+	if (hold) {
+		while (chunk != 0) {
+		}
+	}
+	else {
+		LogKickFromThread();
+	}
+}
+
+const Log_Stats_t* Log_GetStats(void) {
+	return &stats;
+}
+
+void Log_DmaIRQHandler(void) {
+	HAL_DMA_IRQHandler(&hdmaTx);
+}
+
+void Log_UartIRQHandler(void) {
+	HAL_UART_IRQHandler(&huart2);
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef* huart) {
+	if (huart == &huart2) {
+		tail += chunk;
+		chunk = 0;
+		LogKick();
+	}
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef* huart) {
+	// A receive error for the console leaves the transmitter busy and running
+	if (huart == &huart2 && chunk != 0 && huart->gState == HAL_UART_STATE_READY) {
+		// Give the chunk up rather than stall the log behind it
+		tail += chunk;
+		chunk = 0;
+		LogKick();
+	}
+}
+
+// printf and friends land here through _write in syscalls.c
+int __io_putchar(int ch) {
+	char c = (char)ch;
+
+	Log_Write(&c, 1);
+	return ch;
+}
@@ -0,0 +1,22 @@
+/*
+ * _ansi.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  The newlib header the SSD1306 library includes for its C++ guards;
+ *  glibc has no such file.
+ */
+
+#ifndef TESTS_STUB_ANSI_H_
+#define TESTS_STUB_ANSI_H_
+
+#ifdef __cplusplus
+#define _BEGIN_STD_C extern "C" {
+#define _END_STD_C }
+#else
+#define _BEGIN_STD_C
+#define _END_STD_C
+#endif
+
+#endif /* TESTS_STUB_ANSI_H_ */
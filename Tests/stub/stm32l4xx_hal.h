@@ -0,0 +1,195 @@
+/*
+ * stm32l4xx_hal.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  The part of the HAL the SSD1306 rasterizer and its test screens use,
+ *  and the I2C, DMA, GPIO and NVIC calls the I2C job queue makes, for
+ *  the host build. The test supplies the functions. DWT is a call, so
+ *  the test can move the cycle counter on each time it is read.
+ */
+
+#ifndef TESTS_STUB_STM32L4XX_HAL_H_
+#define TESTS_STUB_STM32L4XX_HAL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef enum {
+	HAL_OK,
+	HAL_ERROR,
+	HAL_BUSY,
+	HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+typedef enum {
+	I2C1_EV_IRQn = 31,
+	I2C1_ER_IRQn = 32,
+	I2C2_EV_IRQn = 33,
+	I2C2_ER_IRQn = 34,
+	DMA2_Channel7_IRQn = 69
+} IRQn_Type;
+
+extern uint32_t SystemCoreClock;
+
+typedef struct {
+	uint32_t CTRL;
+	uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+	uint32_t DEMCR;
+} CoreDebug_Type;
+
+DWT_Type* HostDwt(void);
+extern CoreDebug_Type hostCoreDebug;
+
+#define DWT                     (HostDwt())
+#define CoreDebug               (&hostCoreDebug)
+#define DWT_CTRL_CYCCNTENA_Msk  (1u << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1u << 24)
+
+// GPIO
+typedef struct {
+	uint32_t ODR;
+	uint32_t IDR;
+} GPIO_TypeDef;
+
+typedef enum {
+	GPIO_PIN_RESET,
+	GPIO_PIN_SET
+} GPIO_PinState;
+
+typedef struct {
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+} GPIO_InitTypeDef;
+
+extern GPIO_TypeDef hostGpioA, hostGpioB;
+
+#define GPIOA                   (&hostGpioA)
+#define GPIOB                   (&hostGpioB)
+#define GPIO_PIN_6              ((uint16_t)0x0040)
+#define GPIO_PIN_7              ((uint16_t)0x0080)
+#define GPIO_PIN_8              ((uint16_t)0x0100)
+#define GPIO_PIN_10             ((uint16_t)0x0400)
+#define GPIO_PIN_11             ((uint16_t)0x0800)
+#define GPIO_PIN_12             ((uint16_t)0x1000)
+#define GPIO_PIN_14             ((uint16_t)0x4000)
+#define GPIO_MODE_OUTPUT_OD     0x11u
+#define GPIO_NOPULL             0x00u
+#define GPIO_SPEED_FREQ_LOW     0x00u
+
+// DMA
+typedef enum {
+	HAL_DMA_STATE_RESET,
+	HAL_DMA_STATE_READY,
+	HAL_DMA_STATE_BUSY
+} HAL_DMA_StateTypeDef;
+
+typedef struct {
+	uint32_t Request;
+	uint32_t Direction;
+	uint32_t PeriphInc;
+	uint32_t MemInc;
+	uint32_t PeriphDataAlignment;
+	uint32_t MemDataAlignment;
+	uint32_t Mode;
+	uint32_t Priority;
+} DMA_InitTypeDef;
+
+typedef struct {
+	void* Instance;
+	DMA_InitTypeDef Init;
+	volatile HAL_DMA_StateTypeDef State;
+	void* Parent;
+} DMA_HandleTypeDef;
+
+#define DMA2_Channel7           ((void*)0x40020480)
+#define DMA_REQUEST_5           5u
+#define DMA_MEMORY_TO_PERIPH    0x10u
+#define DMA_PINC_DISABLE        0x00u
+#define DMA_MINC_ENABLE         0x80u
+#define DMA_PDATAALIGN_BYTE     0x00u
+#define DMA_MDATAALIGN_BYTE     0x00u
+#define DMA_NORMAL              0x00u
+#define DMA_PRIORITY_LOW        0x00u
+
+#define __HAL_RCC_DMA2_CLK_ENABLE() do { } while (0)
+#define __HAL_LINKDMA(handle, field, dma) do { \
+		(handle)->field = &(dma); \
+		(dma).Parent = (handle); \
+	} while (0)
+
+// I2C
+typedef struct {
+	uint32_t CR1;
+	uint32_t TIMINGR;
+} I2C_TypeDef;
+
+typedef struct {
+	uint32_t Timing;
+} I2C_InitTypeDef;
+
+typedef struct {
+	I2C_TypeDef* Instance;
+	I2C_InitTypeDef Init;
+	DMA_HandleTypeDef* hdmatx;
+	volatile uint32_t ErrorCode;
+} I2C_HandleTypeDef;
+
+#define HAL_I2C_ERROR_NONE      0x00u
+#define HAL_I2C_ERROR_BERR      0x01u
+#define HAL_I2C_ERROR_ARLO      0x02u
+#define HAL_I2C_ERROR_AF        0x04u
+#define HAL_I2C_ERROR_OVR       0x08u
+#define HAL_I2C_ERROR_DMA       0x10u
+#define HAL_I2C_ERROR_TIMEOUT   0x20u
+#define I2C_MEMADD_SIZE_8BIT    1u
+#define I2C_FASTMODEPLUS_I2C1   (1u << 20)
+#define I2C_FASTMODEPLUS_I2C2   (1u << 21)
+
+#define __HAL_I2C_ENABLE(h)     ((h)->Instance->CR1 |= 1u)
+#define __HAL_I2C_DISABLE(h)    ((h)->Instance->CR1 &= ~1u)
+
+void HAL_Delay(uint32_t delay);
+uint32_t HAL_GetTick(void);
+uint32_t HAL_RCC_GetPCLK1Freq(void);
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub);
+void HAL_NVIC_EnableIRQ(IRQn_Type irq);
+void HAL_NVIC_DisableIRQ(IRQn_Type irq);
+
+void HAL_GPIO_Init(GPIO_TypeDef* port, GPIO_InitTypeDef* init);
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state);
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin);
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma);
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef* hdma);
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma);
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef* hi2c);
+HAL_StatusTypeDef HAL_I2CEx_EnableFastModePlus(uint32_t fmp);
+HAL_StatusTypeDef HAL_I2CEx_DisableFastModePlus(uint32_t fmp);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef* hi2c, uint16_t addr, uint8_t* data, uint16_t len);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint16_t addr, uint8_t* data, uint16_t len);
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef* hi2c, uint16_t addr, uint8_t* data, uint16_t len);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef* hi2c, uint16_t addr, uint16_t reg, uint16_t regSize,
+		uint8_t* data, uint16_t len);
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef* hi2c, uint16_t addr, uint16_t reg, uint16_t regSize,
+		uint8_t* data, uint16_t len);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef* hi2c, uint16_t addr, uint32_t trials, uint32_t timeout);
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef* hi2c);
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef* hi2c);
+
+#endif /* TESTS_STUB_STM32L4XX_HAL_H_ */
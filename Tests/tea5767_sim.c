@@ -0,0 +1,97 @@
+/*
+ * tea5767_sim.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ */
+
+#include <string.h>
+#include "tea5767_sim.h"
+
+Sim_t sim;
+
+static Sim_Station_t simStations[SIM_STATIONS_MAX];
+static int simCount;
+static uint16_t simFreq;        // tuned, or where the search started
+static bool simSearch;
+static bool simUp;
+static bool simJapan;
+static uint8_t simStopLevel;
+static uint32_t simStartMs;
+
+void Sim_Reset(const Sim_Station_t* stations, int count) {
+	memset(&sim, 0, sizeof(sim));
+	memcpy(simStations, stations, count * sizeof(Sim_Station_t));
+	simCount = count;
+	simFreq = TEA5767_FREQ_MIN;
+	simSearch = false;
+}
+
+static const Sim_Station_t* SimStation(uint16_t freq) {
+	for (int i = 0; i < simCount; i++) {
+		if (simStations[i].freq == freq) {
+			return &simStations[i];
+		}
+	}
+	return NULL;
+}
+
+int Sim_Write(const uint8_t regs[TEA5767_REG_COUNT]) {
+	static const uint8_t stopLevels[4] = {0, 5, 7, 10};
+
+	sim.writes++;
+	if (sim.failWrite) {
+		return -1;
+	}
+	memcpy(sim.last, regs, TEA5767_REG_COUNT);
+	simFreq = TEA5767_PllToFreq(((regs[0] & 0x3F) << 8) | regs[1]);
+	simSearch = (regs[0] & TEA5767_SM) != 0;
+	simUp = (regs[2] & TEA5767_SUD) != 0;
+	simStopLevel = stopLevels[(regs[2] >> 5) & 3];
+	simJapan = (regs[3] & TEA5767_BL) != 0;
+	simStartMs = sim.nowMs;
+	return 0;
+}
+
+int Sim_Read(uint8_t regs[TEA5767_REG_COUNT]) {
+	uint16_t lo = simJapan ? TEA5767_FREQ_JP_MIN : TEA5767_FREQ_MIN;
+	uint16_t hi = simJapan ? TEA5767_FREQ_JP_MAX : TEA5767_FREQ_MAX;
+	uint16_t freq = simFreq;
+	const Sim_Station_t* station = SimStation(freq);
+	bool ready = true;
+	bool limit = false;
+	uint16_t pll;
+
+	sim.reads++;
+	if (sim.failRead) {
+		return -1;
+	}
+	if (simSearch) {
+		uint32_t steps = (sim.nowMs - simStartMs) / SIM_STEP_MS;
+
+		// One channel per step until a strong enough station or the edge
+		ready = false;
+		for (uint32_t i = 0; i <= steps && !sim.stuck; i++) {
+			station = SimStation(freq);
+			if (station != NULL && station->level >= simStopLevel) {
+				ready = true;
+				break;
+			}
+			if (simUp ? freq >= hi : freq <= lo) {
+				ready = limit = true;
+				break;
+			}
+			if (i < steps) {
+				freq = simUp ? freq + TEA5767_FREQ_STEP : freq - TEA5767_FREQ_STEP;
+			}
+		}
+		station = SimStation(freq);
+	}
+	pll = TEA5767_PLL(freq);
+	regs[0] = (ready ? TEA5767_RF : 0) | (limit ? TEA5767_BLF : 0) | ((pll >> 8) & 0x3F);
+	regs[1] = pll & 0xFF;
+	regs[2] = (station != NULL && station->stereo) ? TEA5767_STEREO : 0;
+	regs[3] = (station != NULL ? station->level : 1) << 4;
+	regs[4] = 0;
+	return 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * tea5767_sim.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Register model of a TEA5767 for the host tests. It takes the five
+ *  write bytes the driver sends and answers reads with the five status
+ *  bytes, searching a table of stations in simulated time: in search
+ *  mode it steps one 100 kHz channel every SIM_STEP_MS from the written
+ *  frequency and stops on the first station at or above the search stop
+ *  level, or on the band edge.
+ */
+
+#ifndef TESTS_TEA5767_SIM_H_
+#define TESTS_TEA5767_SIM_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "tea5767_regs.h"
+
+#define SIM_STEP_MS             4       // per channel while searching
+#define SIM_STATIONS_MAX        64
+
+typedef struct {
+	uint16_t freq;          // 10 kHz units
+	uint8_t level;          // ADC level 0-15
+	bool stereo;
+} Sim_Station_t;
+
+typedef struct {
+	uint32_t nowMs;         // advanced by the test
+	bool stuck;             // never raise RF, as a chip that lost its clock
+	bool failRead;          // the bus NAKs reads
+	bool failWrite;         // the bus NAKs writes, which change nothing
+	int reads;
+	int writes;
+	uint8_t last[TEA5767_REG_COUNT];   // bytes of the last write
+} Sim_t;
+
+extern Sim_t sim;
+
+void Sim_Reset(const Sim_Station_t* stations, int count);
+int Sim_Write(const uint8_t regs[TEA5767_REG_COUNT]);
+int Sim_Read(uint8_t regs[TEA5767_REG_COUNT]);
+
+#endif /* TESTS_TEA5767_SIM_H_ */
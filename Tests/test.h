@@ -0,0 +1,37 @@
+/*
+ * test.h
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Checks for the host tests. A failed CHECK prints where it was and
+ *  the test carries on; TEST_EXIT turns the failure count into the exit
+ *  status that ctest reads.
+ */
+
+#ifndef TESTS_TEST_H_
+#define TESTS_TEST_H_
+
+#include <stdio.h>
+
+static int testFailures;
+
+#define CHECK(cond) do { \
+		if (!(cond)) { \
+			testFailures++; \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+		} \
+	} while (0)
+
+#define CHECK_EQ(actual, expected) do { \
+		long long a_ = (long long)(actual), e_ = (long long)(expected); \
+		if (a_ != e_) { \
+			testFailures++; \
+			printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, a_, e_); \
+		} \
+	} while (0)
+
+#define TEST_EXIT() (printf("%s: %d failure%s\n", __FILE__, testFailures, testFailures == 1 ? "" : "s"), \
+		testFailures != 0)
+
+#endif /* TESTS_TEST_H_ */
@@ -0,0 +1,78 @@
+/*
+ * test_calendar.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Every day of 2000-2099 against libc's timegm/gmtime: day numbers,
+ *  weekdays and month lengths, and the round trip through day numbers
+ *  and seconds.
+ */
+
+#define _DEFAULT_SOURCE
+#include <time.h>
+#include "test.h"
+#include "calendar.h"
+
+static const time_t epoch2000 = 946684800;     // 2000-01-01 00:00 UTC
+
+int main(void) {
+	uint32_t days = 0;
+
+	for (uint8_t year = 0; year <= 99; year++) {
+		for (uint8_t month = 1; month <= 12; month++) {
+			struct tm next = {.tm_year = 100 + year, .tm_mon = month, .tm_mday = 0};
+
+			// Day 0 of the next month is the last of this one
+			timegm(&next);
+			CHECK_EQ(Cal_DaysInMonth(year, month), next.tm_mday);
+
+			for (uint8_t date = 1; date <= Cal_DaysInMonth(year, month); date++) {
+				struct tm tm = {.tm_year = 100 + year, .tm_mon = month - 1, .tm_mday = date};
+				time_t t = timegm(&tm);
+				Cal_DateTime_t dt;
+
+				CHECK_EQ(Cal_Days(year, month, date), days);
+				CHECK_EQ(t - epoch2000, (time_t)days * CAL_SECONDS_PER_DAY);
+				// tm_wday counts from Sunday, the RTC from Monday
+				CHECK_EQ(Cal_Weekday(year, month, date), (tm.tm_wday + 6) % 7 + 1);
+
+				Cal_FromDays(days, &dt);
+				CHECK(dt.year == year && dt.month == month && dt.date == date);
+				CHECK_EQ(dt.weekday, Cal_Weekday(year, month, date));
+				days++;
+			}
+			CHECK(Cal_ClampDate(year, month, 31) == Cal_DaysInMonth(year, month));
+			CHECK(Cal_ClampDate(year, month, 0) == 1);
+		}
+	}
+	CHECK_EQ(days, CAL_DAYS_MAX);
+
+	// Seconds, a few times of day on every day
+	for (uint32_t day = 0; day < CAL_DAYS_MAX; day++) {
+		static const uint32_t tods[] = {0, 1, 3599, 43200, 86399};
+		for (unsigned i = 0; i < sizeof(tods) / sizeof(tods[0]); i++) {
+			uint32_t s = day * CAL_SECONDS_PER_DAY + tods[i];
+			time_t t = epoch2000 + s;
+			struct tm* tm = gmtime(&t);
+			Cal_DateTime_t dt;
+
+			Cal_FromSeconds(s, &dt);
+			CHECK(dt.year == tm->tm_year - 100 && dt.month == tm->tm_mon + 1 && dt.date == tm->tm_mday);
+			CHECK(dt.hours == tm->tm_hour && dt.minutes == tm->tm_min && dt.seconds == tm->tm_sec);
+			CHECK(Cal_Valid(&dt));
+			CHECK_EQ(Cal_ToSeconds(&dt), s);
+			CHECK_EQ(Cal_WeekdayOf(s), dt.weekday);
+		}
+	}
+
+	{
+		Cal_DateTime_t bad = {.year = 1, .month = 2, .date = 29};
+		CHECK(!Cal_Valid(&bad));
+		bad.year = 4;
+		CHECK(Cal_Valid(&bad));
+		bad.month = 13;
+		CHECK(!Cal_Valid(&bad));
+	}
+	return TEST_EXIT();
+}
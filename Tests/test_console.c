@@ -0,0 +1,159 @@
+/*
+ * test_console.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Feeds the console byte streams as a terminal would send them and
+ *  checks what the commands were run with and what went back out:
+ *  word splitting, line endings, editing, refused lines, the replies for
+ *  each result, and the argument parsers.
+ */
+
+#include <string.h>
+#include "test.h"
+#include "console.h"
+
+static char out[4096];
+static size_t outLen;
+static int runs;
+static uint8_t lastArgc;
+static char lastArgs[CONSOLE_ARGS_MAX][CONSOLE_LINE_MAX];
+static Console_Result_t nextResult;
+
+static void Write(const char* text, uint16_t len) {
+	CHECK(outLen + len < sizeof(out));
+	if (outLen + len < sizeof(out)) {
+		memcpy(out + outLen, text, len);
+		outLen += len;
+		out[outLen] = '\0';
+	}
+}
+
+static Console_Result_t Record(uint8_t argc, char* argv[]) {
+	runs++;
+	lastArgc = argc;
+	for (uint8_t i = 0; i < argc; i++) {
+		strcpy(lastArgs[i], argv[i]);
+	}
+	return nextResult;
+}
+
+static const Console_Command_t commands[] = {
+	{"tune", "[mhz]", Record},
+	{"time", "[hh:mm[:ss]]", Record},
+	{"stats", "", Record}
+};
+
+// Sends bytes and returns the output they caused
+static const char* Feed(const char* bytes) {
+	outLen = 0;
+	out[0] = '\0';
+	runs = 0;
+	lastArgc = 0;
+	while (*bytes != '\0') {
+		Console_Feed(*bytes++);
+	}
+	return out;
+}
+
+static bool Ends(const char* text, const char* tail) {
+	size_t n = strlen(text), m = strlen(tail);
+	return n >= m && strcmp(text + n - m, tail) == 0;
+}
+
+int main(void) {
+	char longLine[CONSOLE_LINE_MAX + 8];
+	uint32_t v;
+	uint32_t fields[3];
+
+	outLen = 0;
+	Console_Init(commands, sizeof(commands) / sizeof(commands[0]), Write);
+	CHECK(strcmp(out, "> ") == 0);
+
+	// Echo, then the reply and a new prompt
+	CHECK(strcmp(Feed("tune 98.1\r"), "tune 98.1\r\nok\r\n> ") == 0);
+	CHECK(runs == 1 && lastArgc == 2);
+	CHECK(strcmp(lastArgs[0], "tune") == 0 && strcmp(lastArgs[1], "98.1") == 0);
+
+	// Runs of spaces separate words and are not words themselves
+	Feed("  time   12:00:05  \r");
+	CHECK(runs == 1 && lastArgc == 2 && strcmp(lastArgs[1], "12:00:05") == 0);
+
+	// CRLF is one line end, LF alone is another, an empty line runs nothing
+	Feed("stats\r\n");
+	CHECK_EQ(runs, 1);
+	CHECK(Ends(out, "ok\r\n> ") && strstr(out, "> ") == out + strlen(out) - 2);
+	Feed("stats\n\n");
+	CHECK_EQ(runs, 1);
+	CHECK(strcmp(Feed("\r"), "\r\n> ") == 0);
+
+	// Backspace and DEL edit, within a word and across a word boundary
+	Feed("tunx\b\x7f" "ne 9\b88\r");
+	CHECK(runs == 1 && lastArgc == 2 && strcmp(lastArgs[0], "tune") == 0 && strcmp(lastArgs[1], "88") == 0);
+	Feed("ab \bc\r");
+	CHECK(runs == 0 && strstr(out, "err unknown command") != NULL);
+	Feed("tune 1\b\b\b\b\b\bstats\r");
+	CHECK(runs == 1 && lastArgc == 1 && strcmp(lastArgs[0], "stats") == 0);
+	Feed("\b\b\r");
+	CHECK_EQ(runs, 0);
+
+	// Ctrl-C drops the line; control characters are ignored
+	Feed("tune 1\x03");
+	CHECK_EQ(runs, 0);
+	CHECK(Ends(out, "^C\r\n> "));
+	Feed("st\x01" "ats\r");
+	CHECK(runs == 1 && strcmp(lastArgs[0], "stats") == 0);
+
+	// Over-long lines and too many words are refused whole, then it carries on
+	memset(longLine, 'x', sizeof(longLine) - 2);
+	memcpy(longLine, "tune ", 5);
+	longLine[sizeof(longLine) - 2] = '\r';
+	longLine[sizeof(longLine) - 1] = '\0';
+	Feed(longLine);
+	CHECK(runs == 0 && strstr(out, "err line too long") != NULL);
+	Feed("tune 1 2 3 4 5 6 7 8\r");
+	CHECK(runs == 0 && strstr(out, "err too many words") != NULL);
+	Feed("tune 1 2 3 4 5 6 7\r");
+	CHECK(runs == 1 && lastArgc == CONSOLE_ARGS_MAX && strcmp(lastArgs[7], "7") == 0);
+
+	// Either one edited back within the limits runs, as the echo shows it
+	longLine[sizeof(longLine) - 2] = '\0';
+	Feed(longLine);
+	CHECK(strlen(out) == CONSOLE_LINE_MAX - 1);
+	Feed("\b\b\b\r");
+	CHECK(runs == 1 && lastArgc == 2 && strlen(lastArgs[1]) == CONSOLE_LINE_MAX - 9);
+	Feed("tune 1 2 3 4 5 6 7 88\b\b\b9\r");
+	CHECK(runs == 1 && lastArgc == CONSOLE_ARGS_MAX && strcmp(lastArgs[7], "79") == 0);
+	Feed("tune 1 2 3 4 5 6 7 8\b\b 9\r");
+	CHECK(runs == 0 && strstr(out, "err too many words") != NULL);
+
+	// Each result has its reply
+	nextResult = CONSOLE_ERR_USAGE;
+	CHECK(Ends(Feed("time x\r"), "err usage: time [hh:mm[:ss]]\r\n> "));
+	nextResult = CONSOLE_ERR_ARG;
+	CHECK(Ends(Feed("time x\r"), "err bad argument\r\n> "));
+	nextResult = CONSOLE_ERR_BUSY;
+	CHECK(Ends(Feed("time x\r"), "err busy\r\n> "));
+	nextResult = CONSOLE_ERR;
+	CHECK(Ends(Feed("time x\r"), "err failed\r\n> "));
+	nextResult = CONSOLE_OK;
+	CHECK(Ends(Feed("help\r"), "help\r\ntune [mhz]\r\ntime [hh:mm[:ss]]\r\nstats\r\nok\r\n> "));
+	CHECK_EQ(runs, 0);
+
+	// Parsers
+	CHECK(Console_ParseU("4294967295", &v) && v == 4294967295u);
+	CHECK(!Console_ParseU("4294967296", &v));
+	CHECK(!Console_ParseU("", &v) && !Console_ParseU("12a", &v) && !Console_ParseU("-1", &v));
+	CHECK(Console_ParseFixed("98.1", 2, &v) && v == 9810);
+	CHECK(Console_ParseFixed("108", 2, &v) && v == 10800);
+	CHECK(!Console_ParseFixed("98.105", 2, &v) && !Console_ParseFixed(".5", 2, &v));
+	CHECK(!Console_ParseFixed("98.1.2", 2, &v) && !Console_ParseFixed("12345678901", 2, &v));
+	CHECK_EQ(Console_ParseFields("21:24:05", ':', fields, 3), 3);
+	CHECK(fields[0] == 21 && fields[1] == 24 && fields[2] == 5);
+	CHECK_EQ(Console_ParseFields("2025-04-05", '-', fields, 3), 3);
+	CHECK_EQ(Console_ParseFields("21:24", ':', fields, 3), 2);
+	CHECK_EQ(Console_ParseFields("21::05", ':', fields, 3), 0);
+	CHECK_EQ(Console_ParseFields("1:2:3:4", ':', fields, 3), 0);
+	return TEST_EXIT();
+}
@@ -0,0 +1,137 @@
+/*
+ * test_fmt.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  The formatting helpers against snprintf: every value that changes
+ *  the digit count, the signed and unsigned limits and a spread of
+ *  random values, for each helper. Each call must return its end of
+ *  string and leave the byte after it alone.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "fmt.h"
+
+static char got[64];
+static char want[64];
+
+// Checks what a helper wrote, and that it stopped where it said
+static void Expect(const char* end, const char* what) {
+	if (strcmp(got, want) != 0) {
+		printf("%s: \"%s\", expected \"%s\"\n", what, got, want);
+		testFailures++;
+	}
+	CHECK(end == got + strlen(got));
+	CHECK(got[strlen(got) + 1] == '#');
+}
+
+static void Clear(void) {
+	memset(got, '#', sizeof(got));
+}
+
+static void Unsigned(uint32_t v) {
+	Clear();
+	snprintf(want, sizeof(want), "%u", v);
+	Expect(Fmt_UDec(got, v), "Fmt_UDec");
+	for (uint8_t width = 0; width <= 12; width += 3) {
+		Clear();
+		snprintf(want, sizeof(want), "%0*u", width, v);
+		Expect(Fmt_UPad(got, v, width), "Fmt_UPad");
+	}
+}
+
+static void Signed(int32_t v) {
+	Clear();
+	snprintf(want, sizeof(want), "%d", v);
+	Expect(Fmt_IDec(got, v), "Fmt_IDec");
+	for (uint8_t decimals = 0; decimals <= 9; decimals++) {
+		uint32_t scale = 1;
+		uint32_t mag = v < 0 ? 0u - (uint32_t)v : (uint32_t)v;
+
+		for (uint8_t i = 0; i < decimals; i++) {
+			scale *= 10;
+		}
+		Clear();
+		if (decimals == 0) {
+			snprintf(want, sizeof(want), "%d", v);
+		}
+		else {
+			snprintf(want, sizeof(want), "%s%u.%0*u", v < 0 ? "-" : "", mag / scale, decimals, mag % scale);
+		}
+		Expect(Fmt_Fixed(got, v, decimals), "Fmt_Fixed");
+	}
+}
+
+int main(void) {
+	// Both sides of every power of ten
+	for (uint64_t p = 1; p <= 10000000000ull; p *= 10) {
+		for (int d = -1; d <= 1; d++) {
+			if (p + d <= UINT32_MAX) {
+				Unsigned((uint32_t)(p + d));
+				if (p + d <= INT32_MAX) {
+					Signed((int32_t)(p + d));
+					Signed(-(int32_t)(p + d));
+				}
+			}
+		}
+	}
+	Unsigned(UINT32_MAX);
+	Signed(INT32_MAX);
+	Signed(INT32_MIN);
+	srand(3);
+	for (int i = 0; i < 20000; i++) {
+		uint32_t v = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+		Unsigned(v >> (i % 32));
+		Signed((int32_t)v >> (i % 32));
+	}
+
+	// Two-digit fields wrap to the last two digits
+	for (int v = 0; v <= 255; v++) {
+		Clear();
+		snprintf(want, sizeof(want), "%02d", v % 100);
+		Expect(Fmt_U2(got, v), "Fmt_U2");
+	}
+
+	// Clock fields
+	for (int h = 0; h < 24; h++) {
+		for (int m = 0; m < 60; m++) {
+			Clear();
+			snprintf(want, sizeof(want), "%02d:%02d:%02d", h, m, 59 - m);
+			Expect(Fmt_Time(got, h, m, 59 - m), "Fmt_Time");
+			Clear();
+			snprintf(want, sizeof(want), "%02d:%02d", h, m);
+			Expect(Fmt_HourMin(got, h, m), "Fmt_HourMin");
+		}
+	}
+	for (int year = 2000; year <= 2099; year += 7) {
+		Clear();
+		snprintf(want, sizeof(want), "%02d/%02d/%d", year % 12 + 1, year % 31 + 1, year);
+		Expect(Fmt_Date(got, year % 12 + 1, year % 31 + 1, year), "Fmt_Date");
+	}
+	// The clock face once printed "205" for 2005
+	Clear();
+	strcpy(want, "01/05/2005");
+	Expect(Fmt_Date(got, 1, 5, 2005), "Fmt_Date");
+
+	for (int n = 0; n <= 255; n++) {
+		const char* suffix = "th";
+
+		if (n % 100 < 11 || n % 100 > 13) {
+			suffix = (n % 10 == 1) ? "st" : (n % 10 == 2) ? "nd" : (n % 10 == 3) ? "rd" : "th";
+		}
+		Clear();
+		snprintf(want, sizeof(want), "%d%s", n, suffix);
+		Expect(Fmt_Ordinal(got, n), "Fmt_Ordinal");
+	}
+
+	Clear();
+	strcpy(want, "Time: 07:05");
+	Expect(Fmt_HourMin(Fmt_Str(got, "Time: "), 7, 5), "chained");
+	Clear();
+	strcpy(want, "x");
+	Expect(Fmt_Char(got, 'x'), "Fmt_Char");
+	return TEST_EXIT();
+}
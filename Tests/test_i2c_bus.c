@@ -0,0 +1,551 @@
+/*
+ * test_i2c_bus.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  The I2C job queues against a model of the two buses. The HAL transfer
+ *  calls put a transfer on the wire, where it takes as long as its bits at
+ *  the bus's SCL rate and then ends the way the device is set to answer:
+ *  an ACK, a NACK, a bus error or nothing at all. Step moves the tick on,
+ *  runs the completion and error callbacks the interrupts would and then
+ *  Bus_Task, the way the main loop does.
+ */
+
+#include <stdbool.h>
+#include <string.h>
+#include "test.h"
+#include "i2c_bus.h"
+#include "i2c_speed.h"
+
+#define STARTS_MAX              64
+#define DONE_MAX                16
+
+typedef enum {
+	REPLY_ACK,
+	REPLY_NACK,
+	REPLY_BUS_ERROR,
+	REPLY_NONE                      // a slave holding the bus; only a recovery ends it
+} Reply_t;
+
+typedef struct {
+	Reply_t reply;                  // to the next `misbehave` attempts, an ACK after
+	int misbehave;                  // -1 for every attempt
+	uint32_t answersHz;             // IsDeviceReady answers up to this rate
+	// The transfer on the wire
+	bool busy;
+	Bus_Op_t op;
+	Reply_t outcome;
+	uint32_t endTick;
+	int start;                      // in starts[]
+	int dmaStarts;
+} Wire_t;
+
+typedef struct {
+	Bus_Id_t bus;
+	uint16_t addr;
+	uint32_t tick;
+	uint32_t endTick;
+} Start_t;
+
+uint32_t SystemCoreClock = 80000000;
+CoreDebug_Type hostCoreDebug;
+GPIO_TypeDef hostGpioA, hostGpioB;
+static I2C_TypeDef i2c1Regs, i2c2Regs;
+I2C_HandleTypeDef hi2c1 = {.Instance = &i2c1Regs};
+I2C_HandleTypeDef hi2c2 = {.Instance = &i2c2Regs};
+
+static DWT_Type dwt;
+static uint32_t tick;
+static uint32_t pclk1;
+static uint32_t fmp;
+static int irqMasked[DMA2_Channel7_IRQn + 1];
+static Wire_t wires[BUS_COUNT];
+static Start_t starts[STARTS_MAX];
+static int startCount;
+static Bus_Job_t* done[DONE_MAX];
+static int doneCount;
+static uint8_t frame[1024];
+
+// Each read of the cycle counter is a microsecond
+DWT_Type* HostDwt(void) {
+	dwt.CYCCNT += SystemCoreClock / 1000000;
+	return &dwt;
+}
+
+void HAL_Delay(uint32_t delay) {
+	tick += delay;
+}
+
+uint32_t HAL_GetTick(void) {
+	return tick;
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void) {
+	return pclk1;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type irq, uint32_t preempt, uint32_t sub) {
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irq) {
+	irqMasked[irq] = 0;
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type irq) {
+	irqMasked[irq] = 1;
+}
+
+// The pins always come back high; a stuck SDA is beyond this model
+void HAL_GPIO_Init(GPIO_TypeDef* port, GPIO_InitTypeDef* init) {
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef* port, uint16_t pin, GPIO_PinState state) {
+}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef* port, uint16_t pin) {
+	return GPIO_PIN_SET;
+}
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef* hdma) {
+	hdma->State = HAL_DMA_STATE_READY;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_DMA_Abort(DMA_HandleTypeDef* hdma) {
+	hdma->State = HAL_DMA_STATE_READY;
+	return HAL_OK;
+}
+
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef* hdma) {
+}
+
+static Bus_Id_t WireBus(I2C_HandleTypeDef* hi2c) {
+	return (hi2c == &hi2c1) ? BUS_OLED : BUS_RADIO;
+}
+
+// A recovery aborts whatever is on the wire
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef* hi2c) {
+	wires[WireBus(hi2c)].busy = false;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef* hi2c) {
+	hi2c->Instance->TIMINGR = hi2c->Init.Timing;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2CEx_EnableFastModePlus(uint32_t bits) {
+	fmp |= bits;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2CEx_DisableFastModePlus(uint32_t bits) {
+	fmp &= ~bits;
+	return HAL_OK;
+}
+
+// The address byte and the data at the bus's rate; a NACK ends after the address
+static uint32_t WireMs(Bus_Id_t bus, uint16_t bytes) {
+	uint32_t hz = Bus_GetSpeed(bus);
+	uint32_t ms = (uint32_t)(((uint64_t)(bytes + 1) * 9 * 1000 + hz - 1) / hz);
+
+	return (ms != 0) ? ms : 1;
+}
+
+static HAL_StatusTypeDef WireStart(I2C_HandleTypeDef* hi2c, Bus_Op_t op, uint16_t addr, uint16_t bytes, bool dma) {
+	Bus_Id_t bus = WireBus(hi2c);
+	Wire_t* w = &wires[bus];
+
+	// The queue runs one job at a time per bus
+	CHECK(!w->busy);
+	if (w->busy || startCount == STARTS_MAX) {
+		return HAL_BUSY;
+	}
+	w->busy = true;
+	w->op = op;
+	w->outcome = REPLY_ACK;
+	if (w->misbehave != 0) {
+		w->outcome = w->reply;
+		if (w->misbehave > 0) {
+			w->misbehave--;
+		}
+	}
+	w->endTick = tick + ((w->outcome == REPLY_NACK) ? WireMs(bus, 0) : WireMs(bus, bytes));
+	w->start = startCount;
+	if (dma) {
+		w->dmaStarts++;
+		hi2c->hdmatx->State = HAL_DMA_STATE_BUSY;
+	}
+	starts[startCount++] = (Start_t){bus, addr, tick, 0};
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_IT(I2C_HandleTypeDef* hi2c, uint16_t addr, uint8_t* data, uint16_t len) {
+	return WireStart(hi2c, BUS_OP_TX, addr, len, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit_DMA(I2C_HandleTypeDef* hi2c, uint16_t addr, uint8_t* data, uint16_t len) {
+	return WireStart(hi2c, BUS_OP_TX, addr, len, true);
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive_IT(I2C_HandleTypeDef* hi2c, uint16_t addr, uint8_t* data, uint16_t len) {
+	return WireStart(hi2c, BUS_OP_RX, addr, len, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_IT(I2C_HandleTypeDef* hi2c, uint16_t addr, uint16_t reg, uint16_t regSize,
+		uint8_t* data, uint16_t len) {
+	return WireStart(hi2c, BUS_OP_MEM, addr, len + regSize, false);
+}
+
+HAL_StatusTypeDef HAL_I2C_Mem_Write_DMA(I2C_HandleTypeDef* hi2c, uint16_t addr, uint16_t reg, uint16_t regSize,
+		uint8_t* data, uint16_t len) {
+	return WireStart(hi2c, BUS_OP_MEM, addr, len + regSize, true);
+}
+
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef* hi2c, uint16_t addr, uint32_t trials, uint32_t timeout) {
+	Bus_Id_t bus = WireBus(hi2c);
+
+	return (Bus_GetSpeed(bus) <= wires[bus].answersHz) ? HAL_OK : HAL_ERROR;
+}
+
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef* hi2c) {
+	return hi2c->ErrorCode;
+}
+
+void HAL_I2C_EV_IRQHandler(I2C_HandleTypeDef* hi2c) {
+}
+
+void HAL_I2C_ER_IRQHandler(I2C_HandleTypeDef* hi2c) {
+}
+
+// Ends the transfers that are due, as their interrupts would
+static void WireRun(void) {
+	for (uint8_t bus = 0; bus < BUS_COUNT; bus++) {
+		Wire_t* w = &wires[bus];
+		I2C_HandleTypeDef* hi2c = (bus == BUS_OLED) ? &hi2c1 : &hi2c2;
+
+		if (!w->busy || w->outcome == REPLY_NONE || (int32_t)(tick - w->endTick) < 0) {
+			continue;
+		}
+		w->busy = false;
+		starts[w->start].endTick = tick;
+		if (hi2c->hdmatx != NULL) {
+			hi2c->hdmatx->State = HAL_DMA_STATE_READY;
+		}
+		if (w->outcome == REPLY_ACK) {
+			hi2c->ErrorCode = HAL_I2C_ERROR_NONE;
+			if (w->op == BUS_OP_TX) {
+				HAL_I2C_MasterTxCpltCallback(hi2c);
+			}
+			else if (w->op == BUS_OP_RX) {
+				HAL_I2C_MasterRxCpltCallback(hi2c);
+			}
+			else {
+				HAL_I2C_MemTxCpltCallback(hi2c);
+			}
+		}
+		else {
+			hi2c->ErrorCode = (w->outcome == REPLY_NACK) ? HAL_I2C_ERROR_AF : HAL_I2C_ERROR_BERR;
+			HAL_I2C_ErrorCallback(hi2c);
+		}
+	}
+}
+
+static void Step(void) {
+	tick++;
+	WireRun();
+	Bus_Task();
+}
+
+// Steps until the job is done; false if it takes longer than limitMs
+static bool StepUntilDone(const Bus_Job_t* job, uint32_t limitMs) {
+	for (uint32_t i = 0; i < limitMs && Bus_JobPending(job); i++) {
+		Step();
+	}
+	return !Bus_JobPending(job);
+}
+
+static void Done(Bus_Job_t* job) {
+	if (doneCount < DONE_MAX) {
+		done[doneCount++] = job;
+	}
+}
+
+static Bus_Job_t* Job(Bus_Job_t* job, Bus_Op_t op, uint16_t addr, uint16_t len) {
+	memset(job, 0, sizeof(*job));
+	job->op = op;
+	job->addr = addr;
+	job->data = frame;
+	job->len = len;
+	job->done = Done;
+	return job;
+}
+
+static void Reset(void) {
+	tick = 1000;
+	pclk1 = 80000000;
+	memset(wires, 0, sizeof(wires));
+	startCount = 0;
+	doneCount = 0;
+	Bus_Init();
+}
+
+static bool Unmasked(void) {
+	return !irqMasked[I2C1_EV_IRQn] && !irqMasked[I2C1_ER_IRQn] && !irqMasked[I2C2_EV_IRQn] &&
+			!irqMasked[I2C2_ER_IRQn] && !irqMasked[DMA2_Channel7_IRQn];
+}
+
+// UI jobs go ahead of background ones that were queued first, first in
+// first out within a priority; the job already on the bus finishes
+static void TestPriority(void) {
+	Bus_Job_t jobs[4];
+
+	Reset();
+	CHECK(Bus_Submit(BUS_OLED, BUS_PRIO_BACKGROUND, Job(&jobs[0], BUS_OP_TX, 0x10, 64)));
+	CHECK(Bus_Submit(BUS_OLED, BUS_PRIO_BACKGROUND, Job(&jobs[1], BUS_OP_TX, 0x11, 64)));
+	CHECK(Bus_Submit(BUS_OLED, BUS_PRIO_UI, Job(&jobs[2], BUS_OP_MEM, 0x12, 16)));
+	CHECK(Bus_Submit(BUS_OLED, BUS_PRIO_UI, Job(&jobs[3], BUS_OP_TX, 0x13, 16)));
+	// Still queued
+	CHECK(!Bus_Submit(BUS_OLED, BUS_PRIO_UI, &jobs[3]));
+	CHECK_EQ(startCount, 1);
+	CHECK_EQ(Bus_GetStats(BUS_OLED)->depthMax, 3);
+	CHECK(StepUntilDone(&jobs[1], 100));
+	CHECK(Bus_Idle(BUS_OLED));
+
+	CHECK_EQ(startCount, 4);
+	CHECK_EQ(doneCount, 4);
+	CHECK_EQ(starts[0].addr, 0x10);
+	CHECK_EQ(starts[1].addr, 0x12);
+	CHECK_EQ(starts[2].addr, 0x13);
+	CHECK_EQ(starts[3].addr, 0x11);
+	CHECK(done[0] == &jobs[0] && done[1] == &jobs[2] && done[2] == &jobs[3] && done[3] == &jobs[1]);
+	for (int i = 0; i < 4; i++) {
+		CHECK_EQ(jobs[i].status, HAL_OK);
+		CHECK_EQ(jobs[i].state, BUS_JOB_DONE);
+	}
+	// Each next job starts in the interrupt that ends the one before
+	for (int i = 1; i < 4; i++) {
+		CHECK_EQ(starts[i].tick, starts[i - 1].endTick);
+	}
+	CHECK_EQ(Bus_GetStats(BUS_OLED)->transfers, 4);
+	CHECK_EQ(Bus_GetStats(BUS_OLED)->bytes, 64 + 64 + 16 + 16);
+	CHECK(Unmasked());
+}
+
+// A radio read runs while an OLED frame is still going out by DMA
+static void TestOverlap(void) {
+	Bus_Job_t flush, status;
+	uint32_t t0;
+	uint32_t flushMs;
+
+	Reset();
+	CHECK(hi2c1.hdmatx != NULL && hi2c2.hdmatx == NULL);
+	t0 = tick;
+	flushMs = WireMs(BUS_OLED, sizeof(frame));
+	CHECK(Bus_Submit(BUS_OLED, BUS_PRIO_BACKGROUND, Job(&flush, BUS_OP_TX, 0x78, sizeof(frame))));
+	CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_UI, Job(&status, BUS_OP_RX, 0xC1, 5)));
+	CHECK_EQ(startCount, 2);
+	CHECK(wires[BUS_OLED].busy && wires[BUS_RADIO].busy);
+	CHECK_EQ(wires[BUS_OLED].dmaStarts, 1);
+	CHECK_EQ(wires[BUS_RADIO].dmaStarts, 0);
+
+	CHECK(StepUntilDone(&status, 10));
+	CHECK_EQ(status.status, HAL_OK);
+	CHECK(Bus_JobPending(&flush));
+	CHECK(StepUntilDone(&flush, 100));
+	CHECK_EQ(flush.status, HAL_OK);
+	// Together they take no longer than the frame alone
+	CHECK_EQ(tick - t0, flushMs);
+	CHECK_EQ(Bus_GetStats(BUS_RADIO)->transfers, 1);
+	CHECK_EQ(Bus_GetStats(BUS_OLED)->transfers, 1);
+	CHECK(Bus_GetStats(BUS_OLED)->lastUs > 0);
+	CHECK(Unmasked());
+}
+
+// A slave that never finishes: each attempt hits its deadline and recovers
+// the bus, and the job gives up within Bus_WorstCaseMs
+static void TestTimeout(void) {
+	Bus_Job_t job;
+	const Bus_Stats_t* s = Bus_GetStats(BUS_RADIO);
+	uint32_t t0;
+
+	Reset();
+	wires[BUS_RADIO].reply = REPLY_NONE;
+	wires[BUS_RADIO].misbehave = -1;
+	t0 = tick;
+	CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_UI, Job(&job, BUS_OP_MEM, 0xC0, 4)));
+	CHECK(StepUntilDone(&job, 1000));
+	CHECK_EQ(job.status, HAL_TIMEOUT);
+	CHECK(tick - t0 <= Bus_WorstCaseMs(4));
+
+	CHECK_EQ(startCount, BUS_RETRIES + 1);
+	for (int i = 1; i < startCount; i++) {
+		CHECK(starts[i].tick - starts[i - 1].tick > Bus_DeadlineMs(4));
+	}
+	CHECK_EQ(s->timeouts, BUS_RETRIES + 1);
+	CHECK_EQ(s->recoveries, BUS_RETRIES + 1);
+	CHECK_EQ(s->retries, BUS_RETRIES);
+	CHECK_EQ(s->failures, 1);
+	CHECK_EQ(s->stuck, 0);
+	CHECK(!wires[BUS_RADIO].busy);
+	// The first timeout dropped the bus to standard mode
+	CHECK(Bus_GetSpeed(BUS_RADIO) <= SPEED_STANDARD_HZ);
+	CHECK(!Bus_Down(BUS_RADIO));
+	CHECK(Unmasked());
+}
+
+// NACKs are retried after a backoff that doubles, with no recovery and
+// no change of speed
+static void TestRetry(void) {
+	Bus_Job_t job;
+	const Bus_Stats_t* s = Bus_GetStats(BUS_RADIO);
+	uint32_t hz;
+
+	Reset();
+	hz = Bus_GetSpeed(BUS_RADIO);
+	wires[BUS_RADIO].reply = REPLY_NACK;
+	wires[BUS_RADIO].misbehave = BUS_RETRIES;
+	CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_UI, Job(&job, BUS_OP_TX, 0xC0, 5)));
+	CHECK(StepUntilDone(&job, 100));
+	CHECK_EQ(job.status, HAL_OK);
+	CHECK_EQ(job.attempts, BUS_RETRIES);
+
+	CHECK_EQ(startCount, BUS_RETRIES + 1);
+	for (int i = 1; i < startCount; i++) {
+		uint32_t backoff = BUS_BACKOFF_MS << (i - 1);
+
+		CHECK(starts[i].tick - starts[i - 1].endTick >= backoff);
+		CHECK(starts[i].tick - starts[i - 1].endTick <= backoff + 1);
+	}
+	CHECK_EQ(s->nacks, BUS_RETRIES);
+	CHECK_EQ(s->retries, BUS_RETRIES);
+	CHECK_EQ(s->recoveries, 0);
+	CHECK_EQ(s->fallbacks, 0);
+	CHECK_EQ(s->failures, 0);
+	CHECK_EQ(Bus_GetSpeed(BUS_RADIO), hz);
+
+	// One NACK too many fails the job
+	wires[BUS_RADIO].misbehave = BUS_RETRIES + 1;
+	CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_UI, Job(&job, BUS_OP_TX, 0xC0, 5)));
+	CHECK(StepUntilDone(&job, 100));
+	CHECK_EQ(job.status, HAL_ERROR);
+	CHECK_EQ(s->failures, 1);
+	CHECK(Unmasked());
+}
+
+// A bus error steps the rate down before the retry; Bus_SetSpeed steps
+// down until the device answers and a clock change re-times the buses
+static void TestFallback(void) {
+	Bus_Job_t job;
+	const Bus_Stats_t* s = Bus_GetStats(BUS_OLED);
+	uint32_t timing, actualHz;
+
+	Reset();
+	CHECK(Bus_GetSpeed(BUS_OLED) > SPEED_STANDARD_HZ && Bus_GetSpeed(BUS_OLED) <= SPEED_FAST_HZ);
+	CHECK_EQ(hi2c1.Instance->TIMINGR, 0x00F0387A);
+	wires[BUS_OLED].reply = REPLY_BUS_ERROR;
+	wires[BUS_OLED].misbehave = 1;
+	CHECK(Bus_Submit(BUS_OLED, BUS_PRIO_UI, Job(&job, BUS_OP_MEM, 0x78, 32)));
+	CHECK(StepUntilDone(&job, 100));
+	CHECK_EQ(job.status, HAL_OK);
+	CHECK_EQ(s->busErrors, 1);
+	CHECK_EQ(s->recoveries, 1);
+	CHECK_EQ(s->fallbacks, 1);
+	CHECK_EQ(s->retries, 1);
+	CHECK(Speed_Timing(80000000, SPEED_STANDARD_HZ, &timing, &actualHz));
+	CHECK_EQ(Bus_GetSpeed(BUS_OLED), actualHz);
+	CHECK_EQ(hi2c1.Instance->TIMINGR, timing);
+	CHECK_EQ(hi2c1.Init.Timing, timing);
+	// The other bus keeps its rate
+	CHECK(Bus_GetSpeed(BUS_RADIO) > SPEED_STANDARD_HZ);
+
+	// A device that only keeps up with fast mode
+	wires[BUS_OLED].answersHz = SPEED_FAST_HZ;
+	CHECK(Bus_SetSpeed(BUS_OLED, SPEED_FAST_PLUS_HZ, 0x78) <= SPEED_FAST_HZ);
+	CHECK(Bus_GetSpeed(BUS_OLED) > SPEED_STANDARD_HZ);
+	CHECK_EQ(s->fallbacks, 2);
+	CHECK_EQ(fmp & I2C_FASTMODEPLUS_I2C1, 0);
+	wires[BUS_OLED].answersHz = SPEED_FAST_PLUS_HZ;
+	CHECK(Bus_SetSpeed(BUS_OLED, SPEED_FAST_PLUS_HZ, 0x78) > SPEED_FAST_HZ);
+	CHECK_EQ(hi2c1.Instance->TIMINGR, 0x00B01427);
+	CHECK(fmp & I2C_FASTMODEPLUS_I2C1);
+	CHECK_EQ(fmp & I2C_FASTMODEPLUS_I2C2, 0);
+	// Missing altogether: the bus stays at the rate asked for
+	wires[BUS_OLED].answersHz = 0;
+	CHECK(Bus_SetSpeed(BUS_OLED, SPEED_FAST_HZ, 0x78) > SPEED_STANDARD_HZ);
+
+	// PCLK1 down to the 4 MHz MSI: fast mode no longer fits
+	pclk1 = 4000000;
+	Bus_ClockChanged();
+	CHECK(Bus_GetSpeed(BUS_OLED) <= SPEED_STANDARD_HZ && Bus_GetSpeed(BUS_OLED) != 0);
+	CHECK(Bus_GetSpeed(BUS_RADIO) <= SPEED_STANDARD_HZ && Bus_GetSpeed(BUS_RADIO) != 0);
+	pclk1 = 80000000;
+	Bus_ClockChanged();
+	CHECK(Bus_GetSpeed(BUS_OLED) > SPEED_STANDARD_HZ);
+	CHECK(Unmasked());
+}
+
+// BUS_FAIL_LIMIT failed jobs in a row take the bus down: jobs then fail
+// unsent until BUS_HOLDOFF_MS has passed, and a good job brings it back
+static void TestHoldoff(void) {
+	Bus_Job_t job;
+	const Bus_Stats_t* s = Bus_GetStats(BUS_RADIO);
+	uint32_t downTick;
+
+	Reset();
+	wires[BUS_RADIO].reply = REPLY_NACK;
+	wires[BUS_RADIO].misbehave = -1;
+	for (int i = 0; i < BUS_FAIL_LIMIT; i++) {
+		CHECK(!Bus_Down(BUS_RADIO));
+		CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_BACKGROUND, Job(&job, BUS_OP_RX, 0xC1, 5)));
+		CHECK(StepUntilDone(&job, 100));
+		CHECK_EQ(job.status, HAL_ERROR);
+	}
+	CHECK(Bus_Down(BUS_RADIO));
+	CHECK_EQ(s->failures, BUS_FAIL_LIMIT);
+	CHECK_EQ(startCount, BUS_FAIL_LIMIT * (BUS_RETRIES + 1));
+	downTick = tick;
+
+	// Failed at once, nothing on the wire
+	CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_UI, Job(&job, BUS_OP_RX, 0xC1, 5)));
+	CHECK_EQ(job.state, BUS_JOB_FINISHED);
+	Bus_Task();
+	CHECK_EQ(job.state, BUS_JOB_DONE);
+	CHECK_EQ(job.status, HAL_ERROR);
+	CHECK_EQ(s->skipped, 1);
+	CHECK_EQ(startCount, BUS_FAIL_LIMIT * (BUS_RETRIES + 1));
+	// The other bus is not held off
+	CHECK(!Bus_Down(BUS_OLED));
+	CHECK(Bus_Submit(BUS_OLED, BUS_PRIO_UI, Job(&job, BUS_OP_TX, 0x78, 8)));
+	CHECK(StepUntilDone(&job, 100));
+	CHECK_EQ(job.status, HAL_OK);
+
+	tick = downTick + BUS_HOLDOFF_MS - 1;
+	CHECK(Bus_Down(BUS_RADIO));
+	tick++;
+	CHECK(!Bus_Down(BUS_RADIO));
+	wires[BUS_RADIO].misbehave = 0;
+	CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_UI, Job(&job, BUS_OP_RX, 0xC1, 5)));
+	CHECK(StepUntilDone(&job, 100));
+	CHECK_EQ(job.status, HAL_OK);
+	CHECK_EQ(s->skipped, 1);
+
+	// The good job cleared the run: one failure does not take it down again
+	wires[BUS_RADIO].misbehave = BUS_RETRIES + 1;
+	CHECK(Bus_Submit(BUS_RADIO, BUS_PRIO_UI, Job(&job, BUS_OP_RX, 0xC1, 5)));
+	CHECK(StepUntilDone(&job, 100));
+	CHECK_EQ(job.status, HAL_ERROR);
+	CHECK(!Bus_Down(BUS_RADIO));
+	CHECK(Unmasked());
+}
+
+int main(void) {
+	TestPriority();
+	TestOverlap();
+	TestTimeout();
+	TestRetry();
+	TestFallback();
+	TestHoldoff();
+	return TEST_EXIT();
+}
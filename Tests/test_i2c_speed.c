@@ -0,0 +1,103 @@
+/*
+ * test_i2c_speed.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  TIMINGR values from Speed_Timing for every rate at kernel clocks from
+ *  the 4 MHz MSI low point to the 80 MHz PLL. Each value is decoded back into
+ *  times and held against the I2C-bus specification minimums and the
+ *  board rise and fall times; the 80 MHz values are also checked against
+ *  the ones measured on the board.
+ */
+
+#include <math.h>
+#include "test.h"
+#include "i2c_speed.h"
+
+typedef struct {
+	uint32_t hz;
+	uint32_t lowNs;
+	uint32_t highNs;
+	uint32_t suDatNs;
+	uint32_t vdDatNs;
+} Mode_t;
+
+// UM10204 table 10, as in i2c_speed.c
+static const Mode_t modes[] = {
+	{SPEED_STANDARD_HZ, 4700, 4000, 250, 3450},
+	{SPEED_FAST_HZ, 1300, 600, 100, 900},
+	{SPEED_FAST_PLUS_HZ, 500, 260, 50, 450}
+};
+
+static const uint32_t clocks[] = {4000000, 16000000, 24000000, 48000000, 80000000};
+
+// The fields of timing in picoseconds, against the mode's limits
+static void Check(uint32_t clkHz, const Mode_t* m, uint32_t timing, uint32_t actualHz) {
+	double clkPs = 1e12 / clkHz;
+	double prescPs = ((timing >> 28) + 1) * clkPs;
+	double scldelPs = (((timing >> 20) & 0xF) + 1) * prescPs;
+	double sdadelPs = ((timing >> 16) & 0xF) * prescPs;
+	double highPs = (((timing >> 8) & 0xFF) + 1) * prescPs;
+	double lowPs = ((timing & 0xFF) + 1) * prescPs;
+	double syncPs = (SPEED_RISE_NS + SPEED_FALL_NS) * 1e3 + 2 * (SPEED_AF_MIN_NS * 1e3 + 2 * clkPs);
+	int failures = testFailures;
+
+	CHECK((timing & 0x0F000000) == 0);
+	CHECK(lowPs >= m->lowNs * 1e3);
+	CHECK(highPs >= m->highNs * 1e3);
+	// Data is set up once the rise is over
+	CHECK(scldelPs >= (SPEED_RISE_NS + m->suDatNs) * 1e3);
+	// Held past the fall, and valid before tVD;DAT even with a slow rise
+	CHECK(sdadelPs + SPEED_AF_MIN_NS * 1e3 + 3 * clkPs >= SPEED_FALL_NS * 1e3);
+	CHECK(sdadelPs + SPEED_AF_MAX_NS * 1e3 + 4 * clkPs + SPEED_RISE_NS * 1e3 <= m->vdDatNs * 1e3);
+	// Never faster than asked, and not much slower
+	CHECK(actualHz <= m->hz && actualHz > m->hz * 9 / 10);
+	CHECK(fabs(actualHz - 1e12 / (syncPs + lowPs + highPs)) < actualHz / 1000.0);
+	if (testFailures != failures) {
+		printf("%u Hz at %u Hz: %08X\n", m->hz, clkHz, timing);
+	}
+}
+
+int main(void) {
+	uint32_t timing;
+	uint32_t actualHz;
+
+	for (unsigned c = 0; c < sizeof(clocks) / sizeof(clocks[0]); c++) {
+		for (unsigned i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+			if (Speed_Timing(clocks[c], modes[i].hz, &timing, &actualHz)) {
+				Check(clocks[c], &modes[i], timing, actualHz);
+			}
+			// Standard mode fits any of these clocks, fast mode from 16 MHz; the
+			// 450 ns data valid time of Fast-mode Plus needs 48 MHz
+			else if (modes[i].hz == SPEED_STANDARD_HZ || (modes[i].hz == SPEED_FAST_HZ && clocks[c] >= 16000000) ||
+					clocks[c] >= 48000000) {
+				printf("%u Hz at %u Hz: no timing\n", modes[i].hz, clocks[c]);
+				testFailures++;
+			}
+		}
+	}
+
+	// PCLK1 at 80 MHz, as measured on the board: 398 kHz and 978 kHz
+	CHECK(Speed_Timing(80000000, SPEED_FAST_HZ, &timing, &actualHz));
+	CHECK_EQ(timing, 0x00F0387A);
+	CHECK(actualHz >= 397000 && actualHz <= 399000);
+	CHECK(Speed_Timing(80000000, SPEED_FAST_PLUS_HZ, &timing, &actualHz));
+	CHECK_EQ(timing, 0x00B01427);
+	CHECK(actualHz >= 977000 && actualHz <= 979000);
+
+	// 4 MHz MSI cannot meet fast mode's data valid time, so the bus falls
+	// back to standard mode
+	CHECK(!Speed_Timing(4000000, SPEED_FAST_HZ, &timing, &actualHz));
+	CHECK(!Speed_Timing(4000000, SPEED_FAST_PLUS_HZ, &timing, &actualHz));
+	CHECK(Speed_Timing(4000000, Speed_Below(SPEED_FAST_HZ), &timing, &actualHz));
+	CHECK(actualHz <= SPEED_STANDARD_HZ);
+
+	// Only the three rates, from a running clock
+	CHECK(!Speed_Timing(80000000, 200000, &timing, &actualHz));
+	CHECK(!Speed_Timing(0, SPEED_FAST_HZ, &timing, &actualHz));
+	CHECK_EQ(Speed_Below(SPEED_FAST_PLUS_HZ), SPEED_FAST_HZ);
+	CHECK_EQ(Speed_Below(SPEED_FAST_HZ), SPEED_STANDARD_HZ);
+	CHECK_EQ(Speed_Below(SPEED_STANDARD_HZ), 0);
+	return TEST_EXIT();
+}
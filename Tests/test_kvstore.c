@@ -0,0 +1,228 @@
+/*
+ * test_kvstore.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Runs the key/value store over two simulated flash pages and cuts the
+ *  power at every flash operation of a workload that compacts several
+ *  times. After each cut the store is booted again and every key must
+ *  hold the value it had before the interrupted KV_Set, or the new one
+ *  for the key that was being written.
+ */
+
+#include <setjmp.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "test.h"
+#include "kvstore.h"
+
+#define PAGE_SIZE               256
+#define KEYS                    6
+#define STEPS                   60
+#define ERASE_STEPS             4       // polls of eraseBusy per page erase
+
+static uint8_t flash[2][PAGE_SIZE];
+static int erasePage = -1;
+static uint32_t eraseDone;
+static long opBudget = -1;              // operations before the power goes, -1 for never
+static int tearBytes;                   // bytes of the double word a cut program leaves, 0-7
+static jmp_buf powerCut;
+
+// Spends one operation; at the end of the budget the power goes
+static bool SimCut(void) {
+	if (opBudget == 0) {
+		return true;
+	}
+	if (opBudget > 0) {
+		opBudget--;
+	}
+	return false;
+}
+
+// Like the L4: a double word at a time, only over erased flash, not while erasing
+static int SimProgram(uint8_t page, uint32_t offset, uint64_t data) {
+	uint8_t bytes[8];
+
+	if (page > 1 || offset % 8 != 0 || offset + 8 > PAGE_SIZE || erasePage >= 0) {
+		return 1;
+	}
+	for (int i = 0; i < 8; i++) {
+		if (flash[page][offset + i] != 0xFF) {
+			return 1;
+		}
+	}
+	memcpy(bytes, &data, sizeof(bytes));
+	if (SimCut()) {
+		memcpy(&flash[page][offset], bytes, tearBytes);
+		longjmp(powerCut, 1);
+	}
+	memcpy(&flash[page][offset], bytes, sizeof(bytes));
+	return 0;
+}
+
+static int SimEraseStart(uint8_t page) {
+	if (page > 1 || erasePage >= 0) {
+		return 1;
+	}
+	erasePage = page;
+	eraseDone = 0;
+	return 0;
+}
+
+// Each poll erases a slice, so a cut can leave a page half erased
+static bool SimEraseBusy(void) {
+	if (erasePage < 0) {
+		return false;
+	}
+	if (SimCut()) {
+		longjmp(powerCut, 1);
+	}
+	memset(&flash[erasePage][eraseDone], 0xFF, PAGE_SIZE / ERASE_STEPS);
+	eraseDone += PAGE_SIZE / ERASE_STEPS;
+	if (eraseDone == PAGE_SIZE) {
+		erasePage = -1;
+	}
+	return erasePage >= 0;
+}
+
+static const KV_Flash_t simFlash = {
+	{flash[0], flash[1]},
+	PAGE_SIZE,
+	SimProgram,
+	SimEraseStart,
+	SimEraseBusy
+};
+
+typedef struct {
+	uint8_t len;                        // 0: not stored
+	uint8_t data[KV_MAX_VALUE];
+} Value_t;
+
+static Value_t model[KEYS];
+
+// Step i of the workload: which key, and what goes in it (len 0 deletes)
+static uint8_t StepKey(int i) {
+	return (i * 5 + i / 7) % KEYS;
+}
+
+static Value_t StepValue(int i) {
+	Value_t v;
+
+	v.len = (i % 9 == 8) ? 0 : 1 + (i * 7) % 24;
+	for (int k = 0; k < v.len; k++) {
+		v.data[k] = (uint8_t)(i * 31 + k);
+	}
+	return v;
+}
+
+static bool Holds(uint8_t key, const Value_t* v) {
+	uint8_t buf[KV_MAX_VALUE];
+	int len = KV_Get(key, buf, sizeof(buf));
+
+	if (v->len == 0) {
+		return len == KV_ERR_NOT_FOUND;
+	}
+	return len == v->len && memcmp(buf, v->data, v->len) == 0;
+}
+
+static KV_Error_t Set(uint8_t key, const Value_t* v) {
+	KV_Error_t err;
+
+	// A full store waits for the background erase, as SettingsTask does
+	while ((err = (v->len != 0) ? KV_Set(key, v->data, v->len) : KV_Delete(key)) == KV_ERR_BUSY) {
+		KV_Task();
+	}
+	KV_Task();
+	return err;
+}
+
+static void PowerOn(void) {
+	erasePage = -1;
+	opBudget = -1;
+}
+
+// Where the workload was when the power went
+static int step;
+static int pendingKey;
+static Value_t pending;
+
+// From blank flash: format, then STEPS writes and deletes
+static void Workload(void) {
+	pendingKey = -1;
+	step = -1;
+	CHECK_EQ(KV_Init(&simFlash), KV_OK);
+	for (step = 0; step < STEPS; step++) {
+		pendingKey = StepKey(step);
+		pending = StepValue(step);
+		CHECK_EQ(Set(pendingKey, &pending), KV_OK);
+		model[pendingKey] = pending;
+		pendingKey = -1;
+	}
+}
+
+static void CheckRecovered(long cut) {
+	int bad = 0;
+
+	PowerOn();
+	if (KV_Init(&simFlash) != KV_OK) {
+		printf("cut %ld, tear %d: KV_Init failed\n", cut, tearBytes);
+		testFailures++;
+		return;
+	}
+	for (uint8_t key = 0; key < KEYS; key++) {
+		bool ok = Holds(key, &model[key]) || (key == pendingKey && Holds(key, &pending));
+		if (!ok) {
+			printf("cut %ld at step %d, tear %d: key %u lost\n", cut, step, tearBytes, key);
+			bad++;
+		}
+	}
+	testFailures += bad;
+
+	// Whatever state it came back in, the store carries on
+	for (uint8_t key = 0; key < KEYS; key++) {
+		Value_t v = StepValue(100 + key);
+		CHECK_EQ(Set(key, &v), KV_OK);
+		CHECK(Holds(key, &v));
+		model[key] = v;
+	}
+	KV_Init(&simFlash);
+	for (uint8_t key = 0; key < KEYS; key++) {
+		CHECK(Holds(key, &model[key]));
+	}
+}
+
+int main(void) {
+	uint32_t written = 0;
+	long cuts = 0;
+	bool finished = false;
+
+	for (int i = 0; i < STEPS; i++) {
+		written += 8 + ((StepValue(i).len + 7) & ~7);
+	}
+	// Several compactions, or the interesting cuts are not reached
+	CHECK(written > 4 * PAGE_SIZE);
+
+	for (long cut = 0; !finished; cut++) {
+		for (tearBytes = 0; tearBytes < 8; tearBytes++) {
+			memset(flash, 0xFF, sizeof(flash));
+			memset(model, 0, sizeof(model));
+			PowerOn();
+			if (setjmp(powerCut) == 0) {
+				opBudget = cut;
+				Workload();
+				opBudget = -1;
+				finished = true;
+				for (uint8_t key = 0; key < KEYS; key++) {
+					CHECK(Holds(key, &model[key]));
+				}
+				break;
+			}
+			cuts++;
+			CheckRecovered(cut);
+		}
+	}
+	printf("%ld power cuts over %u bytes written\n", cuts, written);
+	return TEST_EXIT();
+}
@@ -0,0 +1,139 @@
+/*
+ * test_rtc_drift.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Synthetic clock-set histories for the drift estimator. An RTC with a
+ *  known crystal error runs under the calibration the estimator asks
+ *  for, and a user sets it from a reference every few days with some
+ *  reaction-time noise, now and then moving it by hours instead. After
+ *  two months the residual drift has to be within a CALM step or two.
+ */
+
+#include <stdlib.h>
+#include "test.h"
+#include "rtc_drift.h"
+
+#define CALM_PPB                953.67  // one pulse in 2^20
+#define DAY                     86400.0
+
+// Net rate change the calibration register gives for a ppb request
+static double AppliedPpb(int32_t ppb) {
+	bool plus;
+	uint16_t minus;
+
+	Drift_Calr(ppb, &plus, &minus);
+	return ((plus ? 512 : 0) - minus) * CALM_PPB;
+}
+
+// Uniform in [-1, 1), from a fixed seed so a failure repeats
+static double Noise(void) {
+	return rand() / (RAND_MAX / 2.0 + 1) - 1.0;
+}
+
+// Runs one history; returns the residual drift in ppb at the end
+static double History(double crystalPpm, double noiseMs, bool travel) {
+	Drift_State_t state;
+	double trueTime = 400000000.0;      // seconds since 2000, anywhere in range
+	double rtc = trueTime;
+	double applied = 0;
+
+	Drift_Reset(&state);
+	for (int set = 0; set < 40; set++) {
+		double days = 1 + (rand() % 30) / 10.0;
+		double rate = 1 + crystalPpm * 1e-6 + applied * 1e-9;
+		double wanted;
+		int32_t correctionMs;
+
+		trueTime += days * DAY;
+		rtc += days * DAY * rate;
+		// The user sets the clock to the reference, give or take a reaction
+		wanted = trueTime + Noise() * noiseMs / 1000;
+		if (travel && set % 9 == 4) {
+			wanted += 3600;             // a time zone move, not drift
+		}
+		correctionMs = (int32_t)((wanted - rtc) * 1000);
+		if (Drift_Record(&state, (uint32_t)rtc, correctionMs)) {
+			applied = AppliedPpb(state.ppb);
+		}
+		rtc = wanted;
+		if (travel && set % 9 == 4) {
+			trueTime += 3600;
+		}
+	}
+	return crystalPpm * 1000 + applied;
+}
+
+int main(void) {
+	srand(1);
+
+	// A perfect crystal never gets a calibration
+	CHECK(History(0, 0, false) == 0);
+
+	for (int ppm = -40; ppm <= 150; ppm += 5) {
+		double quiet = History(ppm, 0, false);
+		double noisy = History(ppm, 400, true);
+
+		if (quiet > CALM_PPB || quiet < -CALM_PPB) {
+			printf("%+d ppm, exact sets: %.0f ppb left\n", ppm, quiet);
+			testFailures++;
+		}
+		// 400 ms of reaction noise over a few days is a couple of ppm
+		if (noisy > 3 * CALM_PPB || noisy < -3 * CALM_PPB) {
+			printf("%+d ppm, noisy sets: %.0f ppb left\n", ppm, noisy);
+			testFailures++;
+		}
+	}
+
+	// Sets that are not drift only move the anchor
+	{
+		Drift_State_t state;
+
+		Drift_Reset(&state);
+		CHECK(!Drift_Record(&state, 1000000, 5000));            // the first set
+		CHECK(!Drift_Record(&state, 999000, 1000));             // time went backwards
+		CHECK(!Drift_Record(&state, 1500000, 3600000));         // an hour is not drift
+		CHECK(!Drift_Record(&state, 1600000, 60000));           // 600 ppm of the span
+		CHECK_EQ(state.elapsed, 0);
+		CHECK_EQ(state.error, 0);
+		// Four days and 5 s: about 14.5 ppm slow, so the clock speeds up
+		CHECK(Drift_Record(&state, 1600060 + 4 * 86400, 5000));
+		CHECK(state.ppb > 14400 && state.ppb < 14500);
+	}
+
+	// A new date months away moves the anchor exactly, past what int32
+	// milliseconds hold, and the next estimate spans from there
+	{
+		Drift_State_t state;
+
+		Drift_Reset(&state);
+		CHECK(!Drift_Record(&state, 1000000, 0));
+		CHECK(!Drift_Record(&state, 1086400, 90 * 86400000LL));
+		CHECK_EQ(state.anchor, 1086400 + 90 * 86400);
+		CHECK(Drift_Record(&state, 1086400 + 94 * 86400, 5000));
+		CHECK(state.ppb > 14400 && state.ppb < 14500);
+
+		// One that would put the time before 2000 is dropped
+		CHECK(!Drift_Record(&state, 2000000, -3000000000LL));
+		CHECK_EQ(state.anchor, 1086400 + 94 * 86400 + 5);
+		CHECK(!Drift_Record(&state, 4000000000u, 400000000000LL));
+		CHECK_EQ(state.anchor, 1086400 + 94 * 86400 + 5);
+	}
+
+	// Every request lands within half a step, and the register fields fit
+	for (int32_t ppb = DRIFT_PPB_MIN - 5000; ppb <= DRIFT_PPB_MAX + 5000; ppb += 7) {
+		bool plus;
+		uint16_t minus;
+		int32_t clamped = ppb > DRIFT_PPB_MAX ? DRIFT_PPB_MAX : ppb < DRIFT_PPB_MIN ? DRIFT_PPB_MIN : ppb;
+		double error = AppliedPpb(ppb) - clamped;
+
+		Drift_Calr(ppb, &plus, &minus);
+		CHECK(minus <= 511);
+		if (error > CALM_PPB / 2 + 1 || error < -CALM_PPB / 2 - 1) {
+			printf("%d ppb comes out %.0f ppb off\n", ppb, error);
+			testFailures++;
+		}
+	}
+	return TEST_EXIT();
+}
@@ -0,0 +1,133 @@
+/*
+ * test_shot.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Screenshot frames through Shot_Send and back through Shot_Decode:
+ *  full and delta frames of blank, full, noisy and clock-face-like
+ *  images round trip exactly and code to the sizes the format promises,
+ *  and damaged frames are refused without touching the image.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "shot.h"
+
+#define W                       128
+#define H                       64
+#define SIZE                    (W * H / 8)
+#define FRAME_MAX               (SHOT_HEADER_SIZE + SIZE + SIZE / SHOT_LITERAL_MAX + 8 + 2)
+
+static uint8_t frame[FRAME_MAX + 64];
+static uint32_t frameLen;
+
+static void Collect(const uint8_t* data, uint16_t len) {
+	CHECK(frameLen + len <= sizeof(frame));
+	// One packet at most per call, so the sender needs no frame buffer
+	CHECK(len <= 1 + SHOT_LITERAL_MAX);
+	if (frameLen + len <= sizeof(frame)) {
+		memcpy(frame + frameLen, data, len);
+		frameLen += len;
+	}
+}
+
+static uint32_t Send(const uint8_t* image, uint8_t* previous, uint8_t seq, bool delta) {
+	uint32_t n;
+
+	frameLen = 0;
+	n = Shot_Send(image, previous, W, H, seq, delta, Collect);
+	CHECK_EQ(n, frameLen);
+	return n;
+}
+
+static void Clock(uint8_t* image, int minute) {
+	memset(image, 0, SIZE);
+	// A few digit-sized blocks that change with the minute
+	for (int d = 0; d < 4; d++) {
+		int glyph = (d == 3) ? minute % 10 : (minute / 10 + d) % 10;
+		for (int x = 0; x < 16; x++) {
+			for (int page = 2; page < 5; page++) {
+				image[page * W + 20 + d * 24 + x] = (uint8_t)(0x11 * (glyph + 1) + x * page);
+			}
+		}
+	}
+}
+
+int main(void) {
+	static uint8_t image[SIZE], previous[SIZE], decoded[SIZE], copy[SIZE];
+	uint32_t n;
+
+	// Blank and full screens are all runs
+	memset(image, 0, SIZE);
+	n = Send(image, previous, 1, false);
+	CHECK(n < 40);
+	CHECK_EQ(Shot_Decode(frame, n, decoded, SIZE), (int)n);
+	CHECK(memcmp(decoded, image, SIZE) == 0);
+	memset(image, 0xFF, SIZE);
+	n = Send(image, NULL, 2, false);
+	CHECK_EQ(Shot_Decode(frame, n, decoded, SIZE), (int)n);
+	CHECK(memcmp(decoded, image, SIZE) == 0);
+
+	// Noise is all literals: the worst case is one control byte per 128
+	srand(7);
+	for (int i = 0; i < SIZE; i++) {
+		image[i] = (uint8_t)rand();
+	}
+	n = Send(image, previous, 3, false);
+	CHECK(n <= SHOT_HEADER_SIZE + SIZE + SIZE / SHOT_LITERAL_MAX + 2);
+	CHECK_EQ(Shot_Decode(frame, n, decoded, SIZE), (int)n);
+	CHECK(memcmp(decoded, image, SIZE) == 0);
+	CHECK(memcmp(previous, image, SIZE) == 0);
+
+	// A minute of clock faces: deltas are small and rebuild every frame
+	Clock(image, 0);
+	n = Send(image, previous, 10, false);
+	CHECK_EQ(Shot_Decode(frame, n, decoded, SIZE), (int)n);
+	for (int minute = 1; minute <= 60; minute++) {
+		uint32_t full;
+
+		Clock(image, minute);
+		n = Send(image, previous, 10 + minute, true);
+		CHECK(frame[4] & SHOT_DELTA);
+		CHECK_EQ(Shot_Decode(frame, n, decoded, SIZE), (int)n);
+		CHECK(memcmp(decoded, image, SIZE) == 0);
+		full = Send(image, NULL, 0, false);
+		CHECK(n < full);
+	}
+	// An unchanged screen codes to a handful of zero runs
+	n = Send(image, previous, 80, true);
+	CHECK(n < 40);
+
+	// Every run and literal length around the packet limits
+	for (int run = 1; run <= 2 * SHOT_RUN_MAX + 3; run++) {
+		for (int i = 0; i < SIZE; i++) {
+			image[i] = (i % (run + 1) == run) ? (uint8_t)i : 0xAA;
+		}
+		n = Send(image, NULL, 0, false);
+		memset(decoded, 0, SIZE);
+		CHECK_EQ(Shot_Decode(frame, n, decoded, SIZE), (int)n);
+		CHECK(memcmp(decoded, image, SIZE) == 0);
+	}
+
+	// Damage anywhere is refused and leaves the image alone
+	Clock(image, 42);
+	n = Send(image, NULL, 0, false);
+	memcpy(copy, decoded, SIZE);
+	for (uint32_t i = 0; i < n; i++) {
+		frame[i] ^= 0x20;
+		if (Shot_Decode(frame, n, decoded, SIZE) != -1) {
+			printf("flipping byte %u of %u went unnoticed\n", i, n);
+			testFailures++;
+		}
+		frame[i] ^= 0x20;
+	}
+	CHECK(memcmp(copy, decoded, SIZE) == 0);
+	for (uint32_t cut = 0; cut < n; cut++) {
+		CHECK_EQ(Shot_Decode(frame, cut, decoded, SIZE), -1);
+	}
+	CHECK_EQ(Shot_Decode(frame, n, decoded, SIZE / 2), -1);
+	CHECK(memcmp(copy, decoded, SIZE) == 0);
+	return TEST_EXIT();
+}
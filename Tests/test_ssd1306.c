@@ -0,0 +1,293 @@
+/*
+ * test_ssd1306.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  The SSD1306 rasterizer and the library's test screens, built for the
+ *  host and drawn through a transport that models the panel: it parses
+ *  the command stream the way the controller does (addressing modes,
+ *  column and page windows) and writes the data into a 128x64 display
+ *  RAM. Each screen the "oledtest" console command offers is compared
+ *  with its golden PBM in golden/, the same files tools/shot_decode.py
+ *  --golden holds board screenshots against.
+ *
+ *  After an intended change to the rasterizer, look at the new images
+ *  and run "test_ssd1306 --update" from Tests/ to rewrite them.
+ */
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "test.h"
+#include "ssd1306.h"
+#include "ssd1306_tests.h"
+
+#define PAGES                   (SSD1306_HEIGHT / 8)
+#define PBM_ROW                 (SSD1306_WIDTH / 8)
+
+static uint32_t tick;
+
+void HAL_Delay(uint32_t delay) {
+	tick += delay;
+}
+
+uint32_t HAL_GetTick(void) {
+	return tick++;
+}
+
+// Display RAM and the controller state that decides where data lands
+static uint8_t ram[PAGES][SSD1306_WIDTH];
+static uint8_t mode;                    // 0 horizontal, 1 vertical, 2 page
+static uint8_t col, colStart, colEnd;
+static uint8_t page, pageStart, pageEnd;
+static bool displayOn, inverse;
+static uint8_t cmd[3], cmdLen, cmdNeed;
+static int unknownCmds;
+static long dataBytes;
+
+// Argument bytes that follow each command with any
+static uint8_t PanelArgs(uint8_t c) {
+	switch (c) {
+		case 0x21: case 0x22:
+			return 2;
+		case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+		case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+			return 1;
+		default:
+			return 0;
+	}
+}
+
+static void PanelCommand(void) {
+	uint8_t c = cmd[0];
+
+	if (c == 0x20) {
+		mode = cmd[1] & 3;
+	}
+	else if (c == 0x21) {
+		colStart = col = cmd[1] & 0x7F;
+		colEnd = cmd[2] & 0x7F;
+	}
+	else if (c == 0x22) {
+		pageStart = page = cmd[1] & 7;
+		pageEnd = cmd[2] & 7;
+	}
+	else if (c <= 0x0F) {
+		if (mode == 2) {
+			col = (col & 0xF0) | c;
+		}
+	}
+	else if (c <= 0x1F) {
+		if (mode == 2) {
+			col = (col & 0x0F) | ((c & 0x07) << 4);
+		}
+	}
+	else if (c >= 0xB0 && c <= 0xB7) {
+		if (mode == 2) {
+			page = c & 7;
+		}
+	}
+	else if (c == 0xAE || c == 0xAF) {
+		displayOn = c == 0xAF;
+	}
+	else if (c == 0xA6 || c == 0xA7) {
+		inverse = c == 0xA7;
+	}
+	else if (!(c >= 0x40 && c <= 0x7F) && c != 0xA0 && c != 0xA1 && c != 0xA4 && c != 0xA5 &&
+			c != 0xC0 && c != 0xC8 && PanelArgs(c) == 0) {
+		unknownCmds++;
+	}
+}
+
+// Power-on state; the RAM holds whatever it likes
+static void PanelReset(void) {
+	for (int p = 0; p < PAGES; p++) {
+		for (int x = 0; x < SSD1306_WIDTH; x++) {
+			ram[p][x] = (uint8_t)rand();
+		}
+	}
+	mode = 2;
+	col = page = colStart = pageStart = 0;
+	colEnd = SSD1306_WIDTH - 1;
+	pageEnd = PAGES - 1;
+	displayOn = inverse = false;
+	cmdLen = cmdNeed = 0;
+}
+
+static void PanelWriteCommands(const uint8_t* cmds, size_t len) {
+	for (size_t i = 0; i < len; i++) {
+		if (cmdLen == 0) {
+			cmdNeed = PanelArgs(cmds[i]);
+		}
+		cmd[cmdLen++] = cmds[i];
+		if (cmdLen > cmdNeed) {
+			PanelCommand();
+			cmdLen = 0;
+		}
+	}
+}
+
+static void PanelWriteData(const uint8_t* data, size_t len) {
+	CHECK(cmdLen == 0);
+	dataBytes += len;
+	for (size_t i = 0; i < len; i++) {
+		ram[page][col] = data[i];
+		if (mode == 2) {
+			col = (col + 1) % SSD1306_WIDTH;
+		}
+		else if (mode == 0) {
+			if (col++ == colEnd) {
+				col = colStart;
+				page = (page == pageEnd) ? pageStart : page + 1;
+			}
+		}
+		else if (page++ == pageEnd) {
+			page = pageStart;
+			col = (col == colEnd) ? colStart : col + 1;
+		}
+	}
+}
+
+// As the I2C transport sends a frame: page by page
+static void PanelFlush(const uint8_t* buffer) {
+	for (uint8_t i = 0; i < PAGES; i++) {
+		const uint8_t cmds[3] = {0xB0 + i, 0x00, 0x10};
+
+		PanelWriteCommands(cmds, sizeof(cmds));
+		PanelWriteData(&buffer[SSD1306_WIDTH * i], SSD1306_WIDTH);
+	}
+}
+
+// The default transport, so ssd1306.c draws on the model without being told
+const SSD1306_Transport_t ssd1306_I2C = {
+	.Init = NULL,
+	.Reset = PanelReset,
+	.WriteCommands = PanelWriteCommands,
+	.WriteData = PanelWriteData,
+	.Flush = PanelFlush,
+};
+
+// The panel as a PBM image: rows MSB first, a set bit where it is dark
+static void PanelPbm(uint8_t image[SSD1306_HEIGHT][PBM_ROW]) {
+	memset(image, 0, SSD1306_HEIGHT * PBM_ROW);
+	for (int y = 0; y < SSD1306_HEIGHT; y++) {
+		for (int x = 0; x < SSD1306_WIDTH; x++) {
+			if (!((ram[y / 8][x] >> (y % 8)) & 1)) {
+				image[y][x / 8] |= 0x80 >> (x % 8);
+			}
+		}
+	}
+}
+
+static bool PanelShows(const uint8_t* buffer) {
+	return memcmp(ram, buffer, SSD1306_BUFFER_SIZE) == 0;
+}
+
+static const struct {
+	const char* name;
+	void (*draw)(void);
+} screens[] = {
+	{"fonts1", ssd1306_TestFonts1},
+	{"fonts2", ssd1306_TestFonts2},
+	{"line", ssd1306_TestLine},
+	{"rect", ssd1306_TestRectangle},
+	{"fill", ssd1306_TestRectangleFill},
+	{"invert", ssd1306_TestRectangleInvert},
+	{"circle", ssd1306_TestCircle},
+	{"arc", ssd1306_TestArc},
+	{"polyline", ssd1306_TestPolyline}
+};
+
+// Compares the panel with golden/oledtest-<name>.pbm, or rewrites it
+static void Golden(const char* name, bool update) {
+	static const char header[] = "P4\n128 64\n";
+	uint8_t image[SSD1306_HEIGHT][PBM_ROW];
+	uint8_t golden[SSD1306_HEIGHT][PBM_ROW];
+	char path[64];
+	char head[sizeof(header) - 1];
+	FILE* f;
+	int differ = 0;
+
+	PanelPbm(image);
+	snprintf(path, sizeof(path), "golden/oledtest-%s.pbm", name);
+	if (update) {
+		f = fopen(path, "wb");
+		CHECK(f != NULL);
+		if (f != NULL) {
+			fwrite(header, 1, sizeof(header) - 1, f);
+			fwrite(image, 1, sizeof(image), f);
+			fclose(f);
+		}
+		return;
+	}
+	f = fopen(path, "rb");
+	if (f == NULL) {
+		printf("%s: missing\n", path);
+		testFailures++;
+		return;
+	}
+	if (fread(head, 1, sizeof(head), f) != sizeof(head) || memcmp(head, header, sizeof(head)) != 0 ||
+			fread(golden, 1, sizeof(golden), f) != sizeof(golden)) {
+		printf("%s: not a 128x64 binary PBM\n", path);
+		testFailures++;
+		fclose(f);
+		return;
+	}
+	fclose(f);
+	for (int y = 0; y < SSD1306_HEIGHT; y++) {
+		for (int b = 0; b < PBM_ROW; b++) {
+			differ += __builtin_popcount(image[y][b] ^ golden[y][b]);
+		}
+	}
+	if (differ != 0) {
+		printf("%s: %d pixels differ\n", path, differ);
+		testFailures++;
+	}
+}
+
+int main(int argc, char* argv[]) {
+	bool update = argc > 1 && strcmp(argv[1], "--update") == 0;
+	uint8_t before[SSD1306_BUFFER_SIZE];
+
+	// Init turns the panel on in horizontal mode and clears the random RAM
+	srand(1);
+	ssd1306_Init();
+	CHECK(displayOn && !inverse && mode == 0);
+	CHECK_EQ(unknownCmds, 0);
+	memset(before, 0, sizeof(before));
+	CHECK(PanelShows(before));
+
+	for (unsigned i = 0; i < sizeof(screens) / sizeof(screens[0]); i++) {
+		ssd1306_Fill(Black);
+		screens[i].draw();
+		CHECK(PanelShows(ssd1306_GetBuffer()));
+		Golden(screens[i].name, update);
+	}
+
+	// A partial update only reaches the pages and columns it covers, and
+	// leaves the window open for the next full flush
+	ssd1306_Fill(Black);
+	ssd1306_UpdateScreen();
+	memcpy(before, ram, sizeof(before));
+	ssd1306_FillRectangle(10, 10, 100, 50, White);
+	dataBytes = 0;
+	ssd1306_UpdateArea(20, 12, 30, 20);
+	CHECK_EQ(dataBytes, 30 * 3);
+	for (int p = 0; p < PAGES; p++) {
+		for (int x = 0; x < SSD1306_WIDTH; x++) {
+			bool inside = p >= 1 && p <= 3 && x >= 20 && x < 50;
+			uint8_t want = inside ? ssd1306_GetBuffer()[p * SSD1306_WIDTH + x] : before[p * SSD1306_WIDTH + x];
+
+			if (ram[p][x] != want) {
+				printf("UpdateArea: page %d column %d is %02x, expected %02x\n", p, x, ram[p][x], want);
+				testFailures++;
+			}
+		}
+	}
+	ssd1306_UpdateArea(120, 60, 50, 50);
+	CHECK_EQ(unknownCmds, 0);
+	ssd1306_UpdateScreen();
+	CHECK(PanelShows(ssd1306_GetBuffer()));
+	return TEST_EXIT();
+}
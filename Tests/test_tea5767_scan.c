@@ -0,0 +1,149 @@
+/*
+ * test_tea5767_scan.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  Full-band sweeps over the TEA5767 register model, in both bands,
+ *  driven as the main loop drives them: Seek_Poll every millisecond and
+ *  each event handed to Scan_SeekDone. Checks the preset table, the
+ *  retune at the end and the time a sweep takes against the time the
+ *  chip spends searching, and prints that time for each band. A sweep
+ *  cut short leaves the table it would have replaced alone.
+ */
+
+#include "test.h"
+#include "tea5767_scan.h"
+#include "tea5767_sim.h"
+
+static const Seek_Bus_t bus = {Sim_Write, Sim_Read};
+
+static const Sim_Station_t stations[] = {
+	{7610, 9, false},       // Japanese band only
+	{8000, 11, true},
+	{8750, 7, false},       // on the lower edge
+	{8810, 9, true},
+	{8950, 3, false},       // below the stop level
+	{9000, 6, true},        // in both bands
+	{9100, 8, false},       // on the Japanese upper edge
+	{9470, 12, true},
+	{10230, 6, false},
+	{10800, 8, true}        // on the upper edge
+};
+
+// Runs a sweep to the end; returns its length as Scan_ElapsedMs has it
+static uint32_t Sweep(uint16_t restore, bool mute) {
+	Seek_Event_t event;
+	uint32_t start = sim.nowMs;
+	int replaced = 0;
+
+	CHECK(Scan_Start(restore, mute, sim.nowMs));
+	CHECK(!Scan_Start(restore, mute, sim.nowMs));
+	while (Scan_Busy() && sim.nowMs - start < 60000) {
+		sim.nowMs++;
+		if (Seek_Poll(sim.nowMs, &event) && Scan_SeekDone(&event, sim.nowMs)) {
+			replaced++;
+		}
+	}
+	CHECK(!Scan_Busy() && !Seek_Busy());
+	CHECK_EQ(replaced, 1);
+	CHECK_EQ(Scan_ElapsedMs(), sim.nowMs - start);
+	// Back on the station it was on, out of search mode
+	CHECK((sim.last[0] & TEA5767_SM) == 0);
+	CHECK_EQ(TEA5767_PllToFreq(((sim.last[0] & 0x3F) << 8) | sim.last[1]), restore);
+	CHECK(((sim.last[0] & TEA5767_MUTE) != 0) == mute);
+	return Scan_ElapsedMs();
+}
+
+// The presets must be exactly the strong stations in min-max, in order
+static int Expect(uint16_t min, uint16_t max) {
+	int n = 0;
+
+	for (unsigned i = 0; i < sizeof(stations) / sizeof(stations[0]); i++) {
+		if (stations[i].freq >= min && stations[i].freq <= max && stations[i].level >= 5) {
+			const Scan_Station_t* preset = Scan_Station(n);
+
+			CHECK(preset != NULL && preset->freq == stations[i].freq);
+			CHECK(preset != NULL && preset->level == stations[i].level && preset->stereo == stations[i].stereo);
+			n++;
+		}
+	}
+	CHECK_EQ(Scan_Count(), n);
+	return n;
+}
+
+// A sweep costs the chip's search time plus at most a poll per stop
+static void Timing(const char* band, uint16_t min, uint16_t max, uint32_t ms, int found) {
+	uint32_t search = ((max - min) / TEA5767_FREQ_STEP) * SIM_STEP_MS;
+
+	printf("%s: %d presets, sweep %u ms, chip searching %u ms\n", band, found, ms, search);
+	CHECK(ms >= search);
+	CHECK(ms <= search + (found + 1) * (SEEK_POLL_MS + SIM_STEP_MS));
+}
+
+int main(void) {
+	uint32_t ms;
+	int found;
+
+	Sim_Reset(stations, sizeof(stations) / sizeof(stations[0]));
+	Seek_Init(&bus, SEEK_POLL_MS, SEEK_TIMEOUT_MS);
+	CHECK(!Scan_Start(9470, false, 0));         // no bus yet
+	Scan_Init(&bus);
+
+	ms = Sweep(9470, false);
+	found = Expect(TEA5767_FREQ_MIN, TEA5767_FREQ_MAX);
+	Timing("87.5-108 MHz", TEA5767_FREQ_MIN, TEA5767_FREQ_MAX, ms, found);
+
+	// Presets step and wrap around the band
+	CHECK_EQ(Scan_Find(9470), 4);
+	CHECK_EQ(Scan_Find(8950), -1);
+	CHECK_EQ(Scan_Station(Scan_Next(9470, true))->freq, 10230);
+	CHECK_EQ(Scan_Station(Scan_Next(10800, true))->freq, 8750);
+	CHECK_EQ(Scan_Station(Scan_Next(8750, false))->freq, 10800);
+	CHECK_EQ(Scan_Station(Scan_Next(8960, false))->freq, 8810);
+
+	TEA5767_SetBandJapan(true);
+	Scan_Clear();
+	CHECK_EQ(Scan_Count(), 0);
+	ms = Sweep(8000, true);
+	found = Expect(TEA5767_FREQ_JP_MIN, TEA5767_FREQ_JP_MAX);
+	Timing("76-91 MHz", TEA5767_FREQ_JP_MIN, TEA5767_FREQ_JP_MAX, ms, found);
+	CHECK(sim.last[3] & TEA5767_BL);
+	TEA5767_SetBandJapan(false);
+
+	// A sweep cut short by a bus error or a chip that never finds RF keeps
+	// the presets and the time of the last complete sweep
+	for (int stuck = 0; stuck <= 1; stuck++) {
+		CHECK(Scan_Start(9470, false, sim.nowMs));
+		for (int i = 0; i < 2 * SEEK_TIMEOUT_MS && Scan_Busy(); i++) {
+			Seek_Event_t event;
+
+			sim.nowMs++;
+			sim.failRead = !stuck && i == 299;  // up to 91.00 in 300 ms
+			sim.stuck = stuck && i >= 299;
+			if (Seek_Poll(sim.nowMs, &event)) {
+				CHECK(!Scan_SeekDone(&event, sim.nowMs));
+			}
+		}
+		sim.failRead = sim.stuck = false;
+		CHECK(!Scan_Busy());
+		CHECK_EQ(Scan_ElapsedMs(), ms);
+		CHECK_EQ(Expect(TEA5767_FREQ_JP_MIN, TEA5767_FREQ_JP_MAX), found);
+	}
+
+	// So does one whose next seek cannot start
+	CHECK(Scan_Start(9470, false, sim.nowMs));
+	sim.failWrite = true;
+	for (int i = 0; i < 100 && Scan_Busy(); i++) {
+		Seek_Event_t event;
+
+		sim.nowMs++;
+		if (Seek_Poll(sim.nowMs, &event)) {
+			CHECK(!Scan_SeekDone(&event, sim.nowMs));
+		}
+	}
+	sim.failWrite = false;
+	CHECK(!Scan_Busy() && !Seek_Busy());
+	CHECK_EQ(Scan_Count(), found);
+	return TEST_EXIT();
+}
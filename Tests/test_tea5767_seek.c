@@ -0,0 +1,160 @@
+/*
+ * test_tea5767_seek.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  The seek engine against the TEA5767 register model, polled the way
+ *  the main loop polls it: once a millisecond with HAL_GetTick. Checks
+ *  where seeks stop, how often the bus is read, the latency reported,
+ *  that every end leaves the chip out of search mode, and that a failed
+ *  write to leave it is reported.
+ */
+
+#include "test.h"
+#include "tea5767_seek.h"
+#include "tea5767_sim.h"
+
+static const Seek_Bus_t bus = {Sim_Write, Sim_Read};
+
+static const Sim_Station_t stations[] = {
+	{8810, 9, true},
+	{8950, 3, false},       // below the stop level
+	{9470, 12, true},
+	{10230, 6, false},
+	{10790, 8, true}
+};
+
+// Polls every millisecond until the seek ends or limitMs passes
+static bool Run(Seek_Event_t* event, uint32_t limitMs) {
+	for (uint32_t ms = 0; ms < limitMs; ms++) {
+		sim.nowMs++;
+		if (Seek_Poll(sim.nowMs, event)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+// The chip was parked on freq with search mode off
+static bool Parked(uint16_t freq) {
+	return (sim.last[0] & TEA5767_SM) == 0 &&
+			TEA5767_PllToFreq(((sim.last[0] & 0x3F) << 8) | sim.last[1]) == freq;
+}
+
+static void Seek(uint16_t from, bool up, Seek_EventType_t type, uint16_t freq) {
+	Seek_Event_t event = {0};
+	int steps = ((up ? freq - from : from - freq) / TEA5767_FREQ_STEP) - 1;
+
+	sim.reads = 0;
+	CHECK(Seek_Start(from, up, false, sim.nowMs));
+	CHECK(Seek_Busy());
+	CHECK(Run(&event, SEEK_TIMEOUT_MS));
+	CHECK(!Seek_Busy());
+	CHECK_EQ(event.type, type);
+	CHECK_EQ(event.freq, freq);
+	CHECK(Parked(freq));
+	// RF comes up steps channels in; the next poll at most SEEK_POLL_MS later sees it
+	CHECK(event.latencyMs >= (uint32_t)steps * SIM_STEP_MS);
+	CHECK(event.latencyMs < (uint32_t)steps * SIM_STEP_MS + SEEK_POLL_MS + 1);
+	CHECK_EQ(sim.reads, event.latencyMs / SEEK_POLL_MS);
+	CHECK(Seek_LastEvent()->freq == freq);
+}
+
+int main(void) {
+	Seek_Event_t event;
+
+	Sim_Reset(stations, sizeof(stations) / sizeof(stations[0]));
+	CHECK(!Seek_Start(9000, true, false, 0));   // no bus yet
+	Seek_Init(&bus, SEEK_POLL_MS, SEEK_TIMEOUT_MS);
+	CHECK(!Seek_Poll(0, &event));
+
+	// Up and down, over the weak station, and from just beside a station
+	Seek(8750, true, SEEK_EVT_FOUND, 8810);
+	CHECK(Seek_LastEvent()->level == 9 && Seek_LastEvent()->stereo);
+	Seek(8810, true, SEEK_EVT_FOUND, 9470);
+	Seek(9470, false, SEEK_EVT_FOUND, 8810);
+	Seek(10220, true, SEEK_EVT_FOUND, 10230);
+	Seek(10790, true, SEEK_EVT_BAND_LIMIT, TEA5767_FREQ_MAX);
+	Seek(8810, false, SEEK_EVT_BAND_LIMIT, TEA5767_FREQ_MIN);
+	CHECK_EQ(Seek_LastEvent()->level, 1);
+
+	// The Japanese band limits come from the band bit in the writes
+	TEA5767_SetBandJapan(true);
+	Seek(8810, true, SEEK_EVT_BAND_LIMIT, TEA5767_FREQ_JP_MAX);
+	Seek(TEA5767_FREQ_JP_MAX, false, SEEK_EVT_FOUND, 8810);
+	CHECK_EQ(TEA5767_ClampFreq(9500), TEA5767_FREQ_JP_MAX);
+	TEA5767_SetBandJapan(false);
+	CHECK_EQ(TEA5767_ClampFreq(0), TEA5767_FREQ_MIN);
+	CHECK_EQ(TEA5767_ClampFreq(9500), 9500);
+	CHECK_EQ(TEA5767_ClampFreq(10810), TEA5767_FREQ_MAX);
+
+	// The live readout follows the search while it runs
+	CHECK(Seek_Start(8810, true, false, sim.nowMs));
+	CHECK(!Run(&event, 10 * SIM_STEP_MS));
+	CHECK(Seek_CurrentFreq() > 8850 && Seek_CurrentFreq() < 9470);
+
+	// Cancel parks the chip where the search had got to, muted as asked
+	Seek_Cancel();
+	CHECK(!Seek_Busy() && Parked(Seek_CurrentFreq()));
+	CHECK(!Run(&event, 100));
+	CHECK(Seek_Start(9470, true, true, sim.nowMs));
+	Seek_Cancel();
+	CHECK(sim.last[0] & TEA5767_MUTE);
+
+	// A chip that never raises RF times out, and is parked anyway
+	sim.stuck = true;
+	CHECK(Seek_Start(9000, true, false, sim.nowMs));
+	CHECK(Run(&event, SEEK_TIMEOUT_MS + SEEK_POLL_MS));
+	CHECK_EQ(event.type, SEEK_EVT_TIMEOUT);
+	CHECK(event.latencyMs >= SEEK_TIMEOUT_MS && event.latencyMs < SEEK_TIMEOUT_MS + SEEK_POLL_MS);
+	CHECK((sim.last[0] & TEA5767_SM) == 0);
+	sim.stuck = false;
+
+	// A read that fails ends the seek without another write
+	sim.failRead = true;
+	CHECK(Seek_Start(9000, true, false, sim.nowMs));
+	sim.writes = 0;
+	CHECK(Run(&event, SEEK_POLL_MS));
+	CHECK_EQ(event.type, SEEK_EVT_ERROR);
+	CHECK_EQ(sim.writes, 0);
+	CHECK(!Seek_Busy());
+	sim.failRead = false;
+
+	// A second start is refused and leaves the running seek alone
+	CHECK(Seek_Start(8810, true, false, sim.nowMs));
+	sim.writes = 0;
+	CHECK(!Seek_Start(10790, false, false, sim.nowMs));
+	CHECK_EQ(sim.writes, 0);
+	CHECK(Run(&event, SEEK_TIMEOUT_MS));
+	CHECK(event.type == SEEK_EVT_FOUND && event.freq == 9470);
+
+	// A failed status read's 0 starts a down seek at the bottom of the band
+	CHECK(Seek_Start(0, false, false, sim.nowMs));
+	CHECK(TEA5767_PllToFreq(((sim.last[0] & 0x3F) << 8) | sim.last[1]) == TEA5767_FREQ_MIN);
+	CHECK(Run(&event, SEEK_TIMEOUT_MS));
+	CHECK(event.type == SEEK_EVT_BAND_LIMIT && event.freq == TEA5767_FREQ_MIN);
+	CHECK(Seek_Start(TEA5767_FREQ_MAX, true, false, sim.nowMs));
+	CHECK(TEA5767_PllToFreq(((sim.last[0] & 0x3F) << 8) | sim.last[1]) == TEA5767_FREQ_MAX);
+	CHECK(Run(&event, SEEK_TIMEOUT_MS));
+
+	// When the write that leaves search mode fails, the end is an error and
+	// so is a cancel
+	CHECK(Seek_Start(8750, true, false, sim.nowMs));
+	sim.failWrite = true;
+	CHECK(Run(&event, SEEK_TIMEOUT_MS));
+	CHECK_EQ(event.type, SEEK_EVT_ERROR);
+	CHECK(!Seek_Busy());
+	sim.failWrite = false;
+	CHECK(Seek_Start(8810, true, false, sim.nowMs));
+	sim.failWrite = true;
+	CHECK(!Seek_Cancel());
+	CHECK(!Seek_Busy());
+	CHECK(Seek_Cancel());
+	sim.failWrite = false;
+
+	// The tick wraps during a seek
+	sim.nowMs = 0xFFFFFFFFu - 20;
+	Seek(8750, true, SEEK_EVT_FOUND, 8810);
+	return TEST_EXIT();
+}
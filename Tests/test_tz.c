@@ -0,0 +1,143 @@
+/*
+ * test_tz.c
+ *
+ *  Created on: Oct 19, 2026
+ *      Author: agent
+ *
+ *  DST transition matrix: for every rule set the time menu offers and
+ *  every year 2000-2099, both changes are checked against glibc's reading
+ *  of the same TZ string, and the clock is run a minute at a time across
+ *  each change as App_MinuteTick runs it, against glibc's local time.
+ */
+
+#define _DEFAULT_SOURCE
+#include <stdlib.h>
+#include <time.h>
+#include "test.h"
+#include "tz.h"
+#include "calendar.h"
+
+// As zoneSpecs in oledClockApp.c
+static const char* const specs[] = {
+	"UTC0",
+	"EST5EDT,M3.2.0,M11.1.0",
+	"GMT0BST,M3.5.0/1,M10.5.0",
+	"CET-1CEST,M3.5.0,M10.5.0/3",
+	"EET-2EEST,M3.5.0/3,M10.5.0/4",
+	"AEST-10AEDT,M10.1.0,M4.1.0/3",
+	"NZST-12NZDT,M9.5.0,M4.1.0/3"
+};
+
+static const time_t epoch2000 = 946684800;
+
+// Local wall time and DST flag for a UTC time, in the zone set in TZ
+static uint32_t Wall(int64_t utc, int* isDst) {
+	time_t t = epoch2000 + utc;
+	struct tm tm;
+
+	localtime_r(&t, &tm);
+	*isDst = tm.tm_isdst;
+	return (uint32_t)(timegm(&tm) - epoch2000);
+}
+
+static int IsDstAt(int64_t utc) {
+	int dst;
+	Wall(utc, &dst);
+	return dst;
+}
+
+// The clock runs from wall, in the given state, for minutes; every top of
+// the minute goes through TZ_Check as the Alarm B interrupt does
+static void Run(const TZ_Zone_t* zone, uint32_t wall, bool dst, int minutes, const char* spec) {
+	int64_t utc = (int64_t)wall - zone->offsetMin * 60 - (dst ? 3600 : 0);
+	int changes = 0;
+
+	TZ_Sync(zone, wall, dst);
+	for (int m = 0; m < minutes; m++) {
+		int expectDst;
+		uint32_t expect;
+
+		wall += 60;
+		utc += 60;
+		switch (TZ_Check(wall)) {
+			case TZ_ADD_HOUR:
+				wall += 3600;
+				dst = true;
+				TZ_Sync(zone, wall, true);
+				changes++;
+				break;
+			case TZ_SUB_HOUR:
+				wall -= 3600;
+				dst = false;
+				TZ_Sync(zone, wall, false);
+				changes++;
+				break;
+			default:
+				break;
+		}
+		expect = Wall(utc, &expectDst);
+		if (wall != expect || dst != (expectDst > 0)) {
+			Cal_DateTime_t dt;
+			Cal_FromSeconds(expect, &dt);
+			printf("%s: 20%02u-%02u-%02u %02u:%02u, clock off by %d s\n", spec,
+					dt.year, dt.month, dt.date, dt.hours, dt.minutes, (int)(wall - expect));
+			testFailures++;
+			return;
+		}
+	}
+	CHECK_EQ(changes, 1);
+}
+
+int main(void) {
+	TZ_Zone_t zone;
+	int transitions = 0;
+
+	for (unsigned z = 0; z < sizeof(specs) / sizeof(specs[0]); z++) {
+		CHECK(TZ_Parse(specs[z], &zone));
+		setenv("TZ", specs[z], 1);
+		tzset();
+		if (!zone.hasDst) {
+			int dst;
+			TZ_Sync(&zone, 0, false);
+			CHECK_EQ(TZ_Check(3000000000u), TZ_NONE);
+			CHECK_EQ(Wall(0, &dst), zone.offsetMin * 60);
+			continue;
+		}
+		for (uint8_t year = 0; year <= 99; year++) {
+			for (int start = 1; start >= 0; start--) {
+				// The change, in the wall time in force before it
+				uint32_t wall = TZ_Transition(&zone, year, start);
+				int64_t utc = (int64_t)wall - zone.offsetMin * 60 - (start ? 0 : 3600);
+
+				if (IsDstAt(utc - 1) == start || IsDstAt(utc) != start) {
+					printf("%s: change %d of 20%02u is not where glibc has it\n", specs[z], start, year);
+					testFailures++;
+					continue;
+				}
+				CHECK(TZ_IsDst(&zone, wall - 60, !start) == !start);
+				CHECK(TZ_IsDst(&zone, wall + (start ? 3600 : -3600), start) == start);
+				// Half an hour before to an hour and a half after
+				if (wall >= 1800 && wall < 99 * 365u * CAL_SECONDS_PER_DAY) {
+					Run(&zone, wall - 1800, !start, 120, specs[z]);
+				}
+				transitions++;
+			}
+			// A clock that slept through the start of DST changes on its next minute
+			{
+				uint32_t wall = TZ_Transition(&zone, year, true) + 7200;
+				TZ_Sync(&zone, wall, false);
+				CHECK_EQ(TZ_Check(wall + 60), TZ_ADD_HOUR);
+			}
+		}
+	}
+	printf("%d transitions\n", transitions);
+
+	// The RTC moves by an hour and only knows M rules
+	CHECK(!TZ_Parse("LHST-10:30LHDT-11,M10.1.0,M4.1.0", &zone));
+	CHECK(!TZ_Parse("EST5EDT,J60,J300", &zone));
+	CHECK(!TZ_Parse("EST5EDT,M3.2.0", &zone));
+	CHECK(!TZ_Parse("E5", &zone));
+	CHECK(TZ_Parse("<+0330>-3:30", &zone) && zone.offsetMin == 210 && !zone.hasDst);
+	CHECK(TZ_Parse("EST5EDT4,M3.2.0/2:30,M11.1.0", &zone) && zone.start.time == 9000);
+	return TEST_EXIT();
+}
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Decode a raw SWO capture of the firmware's ITM event trace.
+
+The firmware (Core/Src/trace.c) writes each event as two 32-bit stimulus
+words: a microsecond time stamp on port 1, then id << 24 | payload on
+port 2. SWO runs NRZ at 2 MHz with the TPIU formatter bypassed, so the
+capture is the bare ITM packet stream, e.g. from OpenOCD:
+
+    tpiu config internal swo.bin uart off 80000000 2000000
+    itm ports off
+    itm port 1 on
+    itm port 2 on
+
+Then:
+
+    tools/itm_decode.py swo.bin            latency summary
+    tools/itm_decode.py -t swo.bin         timeline as well
+"""
+
+import argparse
+import sys
+
+PORT_TIME = 1
+PORT_EVENT = 2
+
+# Keep in step with Trace_Id_t in Core/Inc/trace.h
+EVENTS = {
+    1: "encoder",
+    2: "button",
+    3: "menu",
+    4: "i2c start",
+    5: "i2c end",
+    6: "flush",
+    7: "alarm",
+    8: "sleep",
+    9: "wake",
+    10: "clock",
+}
+DEVICES = {0: "oled", 1: "radio"}
+PRESSES = {1: "menu", 2: "edit", 3: "wake"}
+SLEEPS = {0: "wfi", 1: "stop2"}
+
+
+def itm_packets(data):
+    """Yields (port, value) for each software stimulus packet in the stream.
+
+    Sync, overflow, timestamp, extension and hardware source packets are
+    skipped; overflows are counted in the returned dict.
+    """
+    counts = {"overflow": 0, "other": 0}
+    i = 0
+    n = len(data)
+    while i < n:
+        b = data[i]
+        if b & 0x03 == 0:
+            i += 1
+            if b == 0x00 or b == 0x80:
+                continue            # sync is a run of zeros ended by 0x80
+            if b == 0x70:
+                counts["overflow"] += 1
+                continue
+            counts["other"] += 1
+            if b & 0x80:
+                # Local timestamp format 1, extension or global timestamp
+                while i < n and data[i] & 0x80:
+                    i += 1
+                i += 1
+            continue
+        size = {1: 1, 2: 2, 3: 4}[b & 0x03]
+        if i + 1 + size > n:
+            break
+        value = int.from_bytes(data[i + 1:i + 1 + size], "little")
+        if b & 0x04:
+            counts["other"] += 1    # DWT hardware source
+        else:
+            yield b >> 3, size, value
+        i += 1 + size
+    itm_packets.counts = counts
+
+
+def events(data):
+    """Yields (us, id, payload), pairing each event word with the stamp before it.
+
+    The 32-bit microsecond stamp wraps after about 71 minutes; it is
+    unwrapped here so times keep increasing.
+    """
+    stamp = None
+    base = 0
+    last = None
+    unpaired = 0
+    for port, size, value in itm_packets(data):
+        if size != 4:
+            continue
+        if port == PORT_TIME:
+            if last is not None and value < last and last - value > 0x80000000:
+                base += 1 << 32
+            last = value
+            stamp = base + value
+        elif port == PORT_EVENT:
+            if stamp is None:
+                unpaired += 1
+                continue
+            yield stamp, value >> 24, value & 0xFFFFFF
+            stamp = None
+    events.unpaired = unpaired
+
+
+def signed24(v):
+    return v - (1 << 24) if v & 0x800000 else v
+
+
+def describe(eid, payload):
+    if eid == 1:
+        return "delta %+d" % signed24(payload)
+    if eid == 2:
+        return PRESSES.get(payload, str(payload))
+    if eid == 3:
+        old = payload >> 8
+        return "%s -> %d" % ("-" if old == 0xFF else old, payload & 0xFF)
+    if eid == 4:
+        return "%s %d bytes" % (DEVICES.get(payload >> 16, "?"), payload & 0xFFFF)
+    if eid == 5:
+        status = payload & 0xFFFF
+        return "%s %s" % (DEVICES.get(payload >> 16, "?"), "ok" if status == 0 else "status %d" % status)
+    if eid == 6:
+        return "%d bytes" % payload
+    if eid == 7:
+        return "none" if payload == 0xFFFFFF else "id %d" % payload
+    if eid == 8:
+        return SLEEPS.get(payload, str(payload))
+    if eid == 9:
+        return "%d ms stopped" % payload
+    if eid == 10:
+        return "%d kHz" % payload
+    return "%06x" % payload
+
+
+class Series:
+    def __init__(self, name):
+        self.name = name
+        self.values = []
+
+    def add(self, us):
+        self.values.append(us)
+
+    def line(self):
+        v = sorted(self.values)
+        if not v:
+            return "%-22s n=0" % self.name
+        pick = lambda q: v[min(len(v) - 1, int(q * len(v)))]
+        return "%-22s n=%-5d min=%-8d p50=%-8d p95=%-8d max=%-8d us" % (
+            self.name, len(v), v[0], pick(0.5), pick(0.95), v[-1])
+
+
+def analyse(stream, timeline, out):
+    series = {key: Series(key) for key in (
+        "encoder to flush", "button to flush", "menu to flush",
+        "oled i2c", "radio i2c", "wfi sleep", "stop2 sleep")}
+    pending = {}        # input kind -> time of the first input not yet shown
+    i2c = {}
+    sleep = None
+    counts = {}
+    first = None
+
+    for us, eid, payload in stream:
+        name = EVENTS.get(eid, "id %d" % eid)
+        counts[name] = counts.get(name, 0) + 1
+        if first is None:
+            first = us
+        if timeline:
+            out.write("%12.3f ms  %-9s %s\n" % ((us - first) / 1000.0, name, describe(eid, payload)))
+        if eid == 1:
+            pending.setdefault("encoder to flush", us)
+        elif eid == 2 and payload != 3:
+            pending.setdefault("button to flush", us)
+        elif eid == 3:
+            pending.setdefault("menu to flush", us)
+        elif eid == 4:
+            i2c[payload >> 16] = us
+        elif eid == 5:
+            dev = payload >> 16
+            if dev in i2c:
+                series["%s i2c" % DEVICES.get(dev, "?")].add(us - i2c.pop(dev))
+        elif eid == 6:
+            # The first flush after an input is when the user saw it
+            for key, start in pending.items():
+                series[key].add(us - start)
+            pending.clear()
+        elif eid == 8:
+            sleep = (payload, us)
+        elif eid == 9 and sleep is not None:
+            series["%s sleep" % SLEEPS.get(sleep[0], "?")].add(us - sleep[1])
+            sleep = None
+
+    if timeline:
+        out.write("\n")
+    out.write("events: %s\n" % ", ".join("%s %d" % kv for kv in sorted(counts.items())))
+    out.write("overflows %d, unpaired %d\n" % (itm_packets.counts["overflow"], events.unpaired))
+    for s in series.values():
+        out.write(s.line() + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw SWO byte stream")
+    parser.add_argument("-t", "--timeline", action="store_true", help="print every event")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+    analyse(events(data), args.timeline, sys.stdout)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
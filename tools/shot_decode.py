@@ -0,0 +1,251 @@
+#!/usr/bin/env python3
+"""Decode framebuffer screenshots sent by the console "shot" command.
+
+Frames are described in Core/Inc/shot.h. They are found anywhere in a
+raw capture of USART2, between log lines and console echo, and written
+out as PBM or PNG images:
+
+    tools/shot_decode.py capture.bin                  shot-000.pbm, ...
+    tools/shot_decode.py --png -o face capture.bin    face-000.png, ...
+
+With pyserial installed it can also ask for the shots itself:
+
+    tools/shot_decode.py --port /dev/ttyACM0 --count 5 --png
+
+A delta frame is applied to the frame before it; if that one was missed
+or failed its CRC, the delta is skipped until the next full frame.
+
+The "oledtest" command draws the SSD1306 library's test screens. Taken
+by name and held against known-good PBM images, they catch rasterizer
+changes that move pixels:
+
+    tools/shot_decode.py --port /dev/ttyACM0 --oledtest line --oledtest arc \
+        -o oledtest --golden Tests/golden/     oledtest-line.pbm, oledtest-arc.pbm
+
+Each image is compared with the file of the same name in the golden
+directory; the exit status is 1 if any differs or is missing. The images
+in Tests/golden are the ones the host test_ssd1306 draws, so the board
+is held against the same pixels.
+"""
+
+import os
+
+import argparse
+import struct
+import sys
+import time
+import zlib
+
+MAGIC = b"SHOT"
+HEADER = 8
+DELTA = 0x01
+RUN_MIN = 3
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as ShotCrc."""
+    crc = 0xFFFF
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def parse(data, start):
+    """Decodes the frame at start; returns (flags, width, height, seq, bytes, end) or None."""
+    if data[start:start + 4] != MAGIC or start + HEADER > len(data):
+        return None
+    flags, width, height, seq = data[start + 4:start + HEADER]
+    size = width * height // 8
+    out = bytearray()
+    p = start + HEADER
+    while len(out) < size:
+        if p >= len(data):
+            return None
+        c = data[p]
+        p += 1
+        if c < 0x80:
+            chunk = data[p:p + c + 1]
+            if len(chunk) != c + 1:
+                return None
+            out += chunk
+            p += c + 1
+        else:
+            if p >= len(data):
+                return None
+            out += bytes([data[p]]) * ((c & 0x7F) + RUN_MIN)
+            p += 1
+    if len(out) != size or p + 2 > len(data):
+        return None
+    if struct.unpack_from("<H", data, p)[0] != crc16(data[start:p]):
+        return None
+    return flags, width, height, seq, bytes(out), p + 2
+
+
+def frames(data):
+    """Yields (seq, width, height, image) for each frame that can be rebuilt."""
+    image = None
+    last = None
+    i = data.find(MAGIC)
+    while i >= 0:
+        frame = parse(data, i)
+        if frame is None:
+            i = data.find(MAGIC, i + 1)
+            continue
+        flags, width, height, seq, coded, end = frame
+        if flags & DELTA:
+            if image is None or last is None or seq != (last + 1) & 0xFF or len(image) != len(coded):
+                sys.stderr.write("shot %d: delta without its base frame, skipped\n" % seq)
+                image = None
+                i = data.find(MAGIC, end)
+                continue
+            image = bytes(a ^ b for a, b in zip(image, coded))
+        else:
+            image = coded
+        last = seq
+        yield seq, width, height, image
+        i = data.find(MAGIC, end)
+
+
+def lit(image, width, x, y):
+    """SSD1306 layout: byte per 8-pixel column of a page, LSB at the top."""
+    return (image[(y // 8) * width + x] >> (y % 8)) & 1
+
+
+def rows(image, width, height, on):
+    """Packs each row MSB first, a 1 bit where the pixel's lit state equals on."""
+    for y in range(height):
+        row = bytearray((width + 7) // 8)
+        for x in range(width):
+            if lit(image, width, x, y) == on:
+                row[x // 8] |= 0x80 >> (x % 8)
+        yield bytes(row)
+
+
+def pbm(image, width, height):
+    # In PBM a set bit is black, and the panel is black where it is dark
+    return b"P4\n%d %d\n" % (width, height) + b"".join(rows(image, width, height, 0))
+
+
+def png(image, width, height):
+    def chunk(kind, body):
+        return struct.pack(">I", len(body)) + kind + body + struct.pack(">I", zlib.crc32(kind + body))
+    raw = b"".join(b"\x00" + row for row in rows(image, width, height, 1))
+    return (b"\x89PNG\r\n\x1a\n" +
+            chunk(b"IHDR", struct.pack(">IIBBBBB", width, height, 1, 0, 0, 0, 0)) +
+            chunk(b"IDAT", zlib.compress(raw)) +
+            chunk(b"IEND", b""))
+
+
+def read_pbm(path):
+    """Returns (width, height, rows) of a binary PBM file."""
+    with open(path, "rb") as f:
+        data = f.read()
+    fields = []
+    p = 0
+    while len(fields) < 3:
+        while data[p:p + 1].isspace():
+            p += 1
+        if data[p:p + 1] == b"#":
+            p = data.index(b"\n", p)
+            continue
+        end = p
+        while not data[end:end + 1].isspace():
+            end += 1
+        fields.append(data[p:end])
+        p = end
+    if fields[0] != b"P4":
+        raise ValueError("%s: not a binary PBM" % path)
+    width, height = int(fields[1]), int(fields[2])
+    stride = (width + 7) // 8
+    p += 1
+    return width, height, [data[p + y * stride:p + (y + 1) * stride] for y in range(height)]
+
+
+def differing(image, width, height, path):
+    """Pixels of image that differ from the PBM at path, or None if the sizes differ."""
+    gw, gh, golden = read_pbm(path)
+    if (gw, gh) != (width, height):
+        return None
+    count = 0
+    for row, want in zip(rows(image, width, height, 0), golden):
+        for a, b in zip(row, want):
+            count += bin(a ^ b).count("1")
+    return count
+
+
+def capture(port, commands, interval):
+    import serial
+    data = bytearray()
+    with serial.Serial(port, 115200, timeout=0.5) as s:
+        for command in commands:
+            s.write(command + b"\r")
+            deadline = time.time() + 3
+            got = len(data)
+            while time.time() < deadline:
+                data += s.read(4096)
+                if data.find(b"\r\nok\r\n", got) >= 0 or data.find(b"\r\nerr", got) >= 0:
+                    break
+            time.sleep(interval)
+    return bytes(data)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", nargs="?", help="raw USART2 capture")
+    parser.add_argument("--port", help="serial port to take shots from instead")
+    parser.add_argument("--count", type=int, default=1, help="shots to take with --port")
+    parser.add_argument("--interval", type=float, default=1.0, help="seconds between shots")
+    parser.add_argument("--oledtest", action="append", metavar="NAME",
+                        help="with --port, take this test screen instead of shots (repeatable)")
+    parser.add_argument("--golden", metavar="DIR", help="compare each image with the PBM of the same name in DIR")
+    parser.add_argument("--png", action="store_true", help="write PNG instead of PBM")
+    parser.add_argument("-o", "--prefix", default="shot", help="output file prefix")
+    args = parser.parse_args()
+
+    if args.oledtest and not args.port:
+        parser.error("--oledtest needs --port")
+    if args.oledtest:
+        commands = [b"oledtest " + name.encode() for name in args.oledtest]
+    else:
+        commands = [b"shot full"] + [b"shot"] * (args.count - 1)
+
+    if args.port:
+        data = capture(args.port, commands, args.interval)
+    elif args.capture:
+        with open(args.capture, "rb") as f:
+            data = f.read()
+    else:
+        parser.error("give a capture file or --port")
+
+    written = 0
+    failed = False
+    for seq, width, height, image in frames(data):
+        label = args.oledtest[written] if args.oledtest and written < len(args.oledtest) else "%03d" % written
+        name = "%s-%s.%s" % (args.prefix, label, "png" if args.png else "pbm")
+        with open(name, "wb") as f:
+            f.write((png if args.png else pbm)(image, width, height))
+        status = ""
+        if args.golden:
+            golden = os.path.join(args.golden, os.path.splitext(os.path.basename(name))[0] + ".pbm")
+            if not os.path.exists(golden):
+                status, failed = ", no golden image", True
+            else:
+                diff = differing(image, width, height, golden)
+                if diff != 0:
+                    status, failed = (", size differs from golden" if diff is None
+                                      else ", %d pixels differ from golden" % diff), True
+                else:
+                    status = ", matches golden"
+        print("%s: shot %d, %dx%d%s" % (name, seq, width, height, status))
+        written += 1
+    if args.oledtest and written != len(args.oledtest):
+        sys.stderr.write("%d of %d test screens received\n" % (written, len(args.oledtest)))
+        failed = True
+    return 0 if written and not failed else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())